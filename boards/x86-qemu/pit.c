@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <core/time.h>
 #include <core/sched.h>
+#include <core/profiler.h>
 #include <ioports.h>
 
 #include "pic.h"
@@ -45,9 +46,11 @@ static time_t base_calendar_time = 1480330081; // On 28.11.2016
 
 void ja_bsp_process_timer(interrupt_frame* frame)
 {
-   (void) frame;
    pok_pic_eoi (PIT_IRQ);
 
+   // Lower bits of CS are privilege level of the interrupted code.
+   jet_profiler_tick(frame->eip, (frame->cs & 3) == 0);
+
    uint32_t system_time_low_new = system_time_low + (1000000000 / POK_TIMER_FREQUENCY);
    if(system_time_low_new < (1000000000 / POK_TIMER_FREQUENCY)) {
       // Overflow of low part.
@@ -96,3 +99,14 @@ time_t ja_calendar_time(void)
 {
    return base_calendar_time + (time_t)(ja_system_time() / 1000000000);
 }
+
+void ja_time_fill_page(struct jet_kernel_time* __kuser kt)
+{
+   // System time is changed on ticks only, so the value is published.
+   kt->source = JET_KERNEL_TIME_SOURCE_VALUE;
+   kt->tb_offset = 0;
+   kt->tb_divider = 1;
+   kt->tb_multiplier = 0;
+   kt->value = ja_system_time();
+   kt->calendar_base = base_calendar_time;
+}
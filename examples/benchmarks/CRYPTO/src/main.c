@@ -0,0 +1,187 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Throughput of AES modes from libpok protocols.
+ *
+ * Every benchmark processes the whole message in one call, for the
+ * message sizes of a small command (64 bytes) and of a full UDP payload
+ * (1024 bytes). 'aes128_block' is a single block for comparison with
+ * the per-block API.
+ *
+ * Besides ticks, throughput is printed as
+ *
+ *     [CRYPTO] <name> <MB/s>
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <arinc653/partition.h>
+#include <arinc653/process.h>
+#include <protocols/aes.h>
+
+#include "../../common/bench.h"
+
+#define MAX_MESSAGE_SIZE 1024
+
+static const uint8_t key_bytes[32] = {
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+    0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+    0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+    0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+};
+
+static struct aes_key enc128, dec128, enc256;
+
+static uint8_t message[MAX_MESSAGE_SIZE];
+
+static uint64_t ticks_per_ms;
+
+enum mode {
+    MODE_CTR,
+    MODE_CBC_ENCRYPT,
+    MODE_CBC_DECRYPT,
+};
+
+static void print_throughput(const char *name, size_t size,
+    const struct bench_result *res)
+{
+    uint64_t avg = res->sum / res->n;
+    // Bytes per millisecond is KB/s; keep two fractional digits of MB/s.
+    uint64_t centi_mbs = avg ? size * ticks_per_ms / avg / 10 : 0;
+
+    printf("[CRYPTO] %s %lu.%02lu\n", name,
+        (unsigned long)(centi_mbs / 100), (unsigned long)(centi_mbs % 100));
+}
+
+static void run_mode(const char *prefix, const struct aes_key *key,
+    enum mode mode, size_t size)
+{
+    struct bench_result res;
+    uint8_t iv[AES_BLOCK_SIZE];
+    char name[32];
+    uint64_t start;
+    int i;
+
+    memset(iv, 0, sizeof(iv));
+
+    bench_result_init(&res);
+    for (i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        switch (mode) {
+        case MODE_CTR:
+            aes_ctr_crypt(key, iv, message, message, size);
+            break;
+        case MODE_CBC_ENCRYPT:
+            aes_cbc_encrypt(key, iv, message, message, size);
+            break;
+        case MODE_CBC_DECRYPT:
+            aes_cbc_decrypt(key, iv, message, message, size);
+            break;
+        }
+        bench_result_add(&res, bench_now() - start);
+    }
+
+    snprintf(name, sizeof(name), "%s_%d", prefix, (int)size);
+    bench_result_print(name, &res);
+    print_throughput(name, size, &res);
+}
+
+static void run_block(void)
+{
+    struct bench_result res;
+    uint64_t start;
+    int i;
+
+    bench_result_init(&res);
+    for (i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        aes_encrypt_block(&enc128, message, message);
+        bench_result_add(&res, bench_now() - start);
+    }
+
+    bench_result_print("aes128_block", &res);
+    print_throughput("aes128_block", AES_BLOCK_SIZE, &res);
+}
+
+static void bench_process(void)
+{
+    static const size_t sizes[] = {64, MAX_MESSAGE_SIZE};
+    unsigned s;
+
+    ticks_per_ms = bench_ticks_per_ms();
+
+    run_block();
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        run_mode("aes128_ctr", &enc128, MODE_CTR, sizes[s]);
+        run_mode("aes256_ctr", &enc256, MODE_CTR, sizes[s]);
+        run_mode("aes128_cbc_encrypt", &enc128, MODE_CBC_ENCRYPT, sizes[s]);
+        run_mode("aes128_cbc_decrypt", &dec128, MODE_CBC_DECRYPT, sizes[s]);
+    }
+
+    bench_end("CRYPTO");
+
+    STOP_SELF();
+}
+
+static int real_main(void)
+{
+    RETURN_CODE_TYPE ret;
+    PROCESS_ID_TYPE pid;
+    PROCESS_ATTRIBUTE_TYPE process_attrs = {
+        .PERIOD = INFINITE_TIME_VALUE,
+        .TIME_CAPACITY = INFINITE_TIME_VALUE,
+        .STACK_SIZE = 8096, // the only accepted stack size!
+        .BASE_PRIORITY = MIN_PRIORITY_VALUE,
+        .DEADLINE = SOFT,
+    };
+
+    memset(message, 0x5a, sizeof(message));
+
+    aes_set_encrypt_key(&enc128, key_bytes, 128);
+    aes_set_decrypt_key(&dec128, key_bytes, 128);
+    aes_set_encrypt_key(&enc256, key_bytes, 256);
+
+    process_attrs.ENTRY_POINT = bench_process;
+    strncpy(process_attrs.NAME, "bench", sizeof(PROCESS_NAME_TYPE));
+
+    CREATE_PROCESS(&process_attrs, &pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create process: %d\n", (int) ret);
+        return 1;
+    }
+
+    START(pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't start process: %d\n", (int) ret);
+        return 1;
+    }
+
+    // transition to NORMAL operating mode
+    // N.B. if everything is OK, this never returns
+    SET_PARTITION_MODE(NORMAL, &ret);
+
+    if (ret != NO_ERROR) {
+        printf("couldn't transit to normal operating mode: %d\n", (int) ret);
+    }
+
+    return 0;
+}
+
+void main(void) {
+    real_main();
+    STOP_SELF();
+}
@@ -0,0 +1,169 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Throughput of batch functions from libm against loops over
+ * the scalar ones.
+ *
+ * Every sample processes the whole array of NB_SAMPLES elements.
+ * Arguments are spread over the ranges typical for signal processing:
+ * angles within several periods, exponents which don't overflow,
+ * non-negative arguments of roots.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <libm.h>
+#include <arinc653/partition.h>
+#include <arinc653/process.h>
+
+#include "../../common/bench.h"
+
+#define NB_SAMPLES 256
+
+static float in_x[NB_SAMPLES];
+static float in_y[NB_SAMPLES];
+static float in_positive[NB_SAMPLES];
+static float out[NB_SAMPLES];
+
+typedef void (*unary_batch_t)(float* y, const float* x, size_t n);
+typedef float (*unary_scalar_t)(float x);
+
+static void print_result(const char* what, const struct bench_result* res)
+{
+    char name[32];
+
+    snprintf(name, sizeof(name), "%s_%d", what, NB_SAMPLES);
+    bench_result_print(name, res);
+}
+
+static void run_unary(const char* scalar_name, unary_scalar_t scalar,
+    const char* batch_name, unary_batch_t batch, const float* x)
+{
+    struct bench_result res;
+    uint64_t start;
+    int i, j;
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        for(j = 0; j < NB_SAMPLES; j++)
+            out[j] = scalar(x[j]);
+        bench_result_add(&res, bench_now() - start);
+    }
+    print_result(scalar_name, &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        batch(out, x, NB_SAMPLES);
+        bench_result_add(&res, bench_now() - start);
+    }
+    print_result(batch_name, &res);
+}
+
+static void run_atan2(void)
+{
+    struct bench_result res;
+    uint64_t start;
+    int i, j;
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        for(j = 0; j < NB_SAMPLES; j++)
+            out[j] = atan2f(in_y[j], in_x[j]);
+        bench_result_add(&res, bench_now() - start);
+    }
+    print_result("atan2f", &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        vatan2f(out, in_y, in_x, NB_SAMPLES);
+        bench_result_add(&res, bench_now() - start);
+    }
+    print_result("vatan2f", &res);
+}
+
+static void fill_inputs(void)
+{
+    int j;
+
+    for(j = 0; j < NB_SAMPLES; j++) {
+        // [-8*pi, 8*pi), [-16, 16) and [0, 1000).
+        in_x[j] = (j - NB_SAMPLES / 2) * (16 * 3.14159265f / NB_SAMPLES);
+        in_y[j] = (NB_SAMPLES / 2 - j * 7 % NB_SAMPLES) * (32.0f / NB_SAMPLES);
+        in_positive[j] = j * (1000.0f / NB_SAMPLES);
+    }
+}
+
+static void bench_process(void)
+{
+    run_unary("sinf", sinf, "vsinf", vsinf, in_x);
+    run_unary("cosf", cosf, "vcosf", vcosf, in_x);
+    run_unary("expf", expf, "vexpf", vexpf, in_y);
+    run_unary("sqrtf", sqrtf, "vsqrtf", vsqrtf, in_positive);
+    run_atan2();
+
+    bench_end("MATH");
+
+    STOP_SELF();
+}
+
+static int real_main(void)
+{
+    RETURN_CODE_TYPE ret;
+    PROCESS_ID_TYPE pid;
+    PROCESS_ATTRIBUTE_TYPE process_attrs = {
+        .PERIOD = INFINITE_TIME_VALUE,
+        .TIME_CAPACITY = INFINITE_TIME_VALUE,
+        .STACK_SIZE = 8096, // the only accepted stack size!
+        .BASE_PRIORITY = MIN_PRIORITY_VALUE,
+        .DEADLINE = SOFT,
+    };
+
+    fill_inputs();
+
+    process_attrs.ENTRY_POINT = bench_process;
+    strncpy(process_attrs.NAME, "bench", sizeof(PROCESS_NAME_TYPE));
+
+    CREATE_PROCESS(&process_attrs, &pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create process: %d\n", (int) ret);
+        return 1;
+    }
+
+    START(pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't start process: %d\n", (int) ret);
+        return 1;
+    }
+
+    // transition to NORMAL operating mode
+    // N.B. if everything is OK, this never returns
+    SET_PARTITION_MODE(NORMAL, &ret);
+
+    if (ret != NO_ERROR) {
+        printf("couldn't transit to normal operating mode: %d\n", (int) ret);
+    }
+
+    return 0;
+}
+
+void main(void) {
+    real_main();
+    STOP_SELF();
+}
@@ -0,0 +1,324 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Benchmarks of queuing and sampling ports.
+ *
+ * Every source port is connected to the destination port of this
+ * partition, so the whole path through the kernel's channel (including
+ * notification of the receiver) is measured without partition switches.
+ *
+ * For every message size:
+ *
+ *  - "Q<size>_REQ" channel carries requests from the client to the echo
+ *    process, "Q<size>_REP" carries replies back;
+ *  - "S<size>" sampling channel is used for write/read.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <arinc653/partition.h>
+#include <arinc653/process.h>
+#include <arinc653/queueing.h>
+#include <arinc653/sampling.h>
+
+#include "../../common/bench.h"
+
+/* Should be equal to MaxNbMessage of the queuing ports. */
+#define QUEUE_DEPTH 16
+
+#define MAX_MESSAGE_SIZE 1024
+
+struct port_set
+{
+    MESSAGE_SIZE_TYPE size;
+    QUEUING_PORT_ID_TYPE req_out;
+    QUEUING_PORT_ID_TYPE req_in;
+    QUEUING_PORT_ID_TYPE rep_out;
+    QUEUING_PORT_ID_TYPE rep_in;
+    SAMPLING_PORT_ID_TYPE s_out;
+    SAMPLING_PORT_ID_TYPE s_in;
+};
+
+static struct port_set port_sets[] = {
+    {.size = 8},
+    {.size = 64},
+    {.size = MAX_MESSAGE_SIZE},
+};
+
+#define NB_PORT_SETS (sizeof(port_sets) / sizeof(port_sets[0]))
+
+static char client_buf[MAX_MESSAGE_SIZE];
+static char echo_buf[MAX_MESSAGE_SIZE];
+
+static void echo_process(void)
+{
+    RETURN_CODE_TYPE ret;
+    MESSAGE_SIZE_TYPE len;
+    unsigned s;
+    int i;
+
+    for(s = 0; s < NB_PORT_SETS; s++) {
+        struct port_set* ps = &port_sets[s];
+
+        for(i = 0; i < BENCH_ITERATIONS; i++) {
+            RECEIVE_QUEUING_MESSAGE(ps->req_in, INFINITE_TIME_VALUE,
+                (MESSAGE_ADDR_TYPE)echo_buf, &len, &ret);
+            SEND_QUEUING_MESSAGE(ps->rep_out, (MESSAGE_ADDR_TYPE)echo_buf,
+                len, 0, &ret);
+        }
+    }
+
+    STOP_SELF();
+}
+
+static void print_result(const char* what, MESSAGE_SIZE_TYPE size,
+    const struct bench_result* res)
+{
+    char name[32];
+
+    snprintf(name, sizeof(name), "%s_%d", what, (int)size);
+    bench_result_print(name, res);
+}
+
+/*
+ * Measure operations which don't wake up anybody.
+ *
+ * Reply channel is used: echo process never waits on it.
+ */
+static void run_uncontended(struct port_set* ps)
+{
+    RETURN_CODE_TYPE ret;
+    MESSAGE_SIZE_TYPE len;
+    struct bench_result res;
+    uint64_t start;
+    int i, j;
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        SEND_QUEUING_MESSAGE(ps->rep_out, (MESSAGE_ADDR_TYPE)client_buf,
+            ps->size, 0, &ret);
+        bench_result_add(&res, bench_now() - start);
+
+        RECEIVE_QUEUING_MESSAGE(ps->rep_in, 0,
+            (MESSAGE_ADDR_TYPE)client_buf, &len, &ret);
+    }
+    print_result("queuing_send", ps->size, &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        SEND_QUEUING_MESSAGE(ps->rep_out, (MESSAGE_ADDR_TYPE)client_buf,
+            ps->size, 0, &ret);
+
+        start = bench_now();
+        RECEIVE_QUEUING_MESSAGE(ps->rep_in, 0,
+            (MESSAGE_ADDR_TYPE)client_buf, &len, &ret);
+        bench_result_add(&res, bench_now() - start);
+    }
+    print_result("queuing_receive", ps->size, &res);
+
+    // Per-message cost when the queue is filled and drained at once.
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS / QUEUE_DEPTH; i++) {
+        start = bench_now();
+        for(j = 0; j < QUEUE_DEPTH; j++) {
+            SEND_QUEUING_MESSAGE(ps->rep_out, (MESSAGE_ADDR_TYPE)client_buf,
+                ps->size, 0, &ret);
+        }
+        for(j = 0; j < QUEUE_DEPTH; j++) {
+            RECEIVE_QUEUING_MESSAGE(ps->rep_in, 0,
+                (MESSAGE_ADDR_TYPE)client_buf, &len, &ret);
+        }
+        bench_result_add(&res, (bench_now() - start) / QUEUE_DEPTH);
+    }
+    print_result("queuing_burst", ps->size, &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        WRITE_SAMPLING_MESSAGE(ps->s_out, (MESSAGE_ADDR_TYPE)client_buf,
+            ps->size, &ret);
+        bench_result_add(&res, bench_now() - start);
+    }
+    print_result("sampling_write", ps->size, &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        VALIDITY_TYPE validity;
+
+        start = bench_now();
+        READ_SAMPLING_MESSAGE(ps->s_in, (MESSAGE_ADDR_TYPE)client_buf,
+            &len, &validity, &ret);
+        bench_result_add(&res, bench_now() - start);
+    }
+    print_result("sampling_read", ps->size, &res);
+}
+
+/*
+ * Request-reply through two channels.
+ *
+ * Includes two sends, two receives and two context switches.
+ */
+static void run_roundtrip(struct port_set* ps)
+{
+    RETURN_CODE_TYPE ret;
+    MESSAGE_SIZE_TYPE len;
+    struct bench_result res;
+    uint64_t start;
+    int i;
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        SEND_QUEUING_MESSAGE(ps->req_out, (MESSAGE_ADDR_TYPE)client_buf,
+            ps->size, 0, &ret);
+        RECEIVE_QUEUING_MESSAGE(ps->rep_in, INFINITE_TIME_VALUE,
+            (MESSAGE_ADDR_TYPE)client_buf, &len, &ret);
+        bench_result_add(&res, bench_now() - start);
+    }
+    print_result("queuing_roundtrip", ps->size, &res);
+}
+
+static void client_process(void)
+{
+    unsigned s;
+
+    for(s = 0; s < NB_PORT_SETS; s++)
+        run_uncontended(&port_sets[s]);
+
+    for(s = 0; s < NB_PORT_SETS; s++)
+        run_roundtrip(&port_sets[s]);
+
+    bench_end("PORTS");
+
+    STOP_SELF();
+}
+
+static int create_and_start(void (*entry)(void), const char* name,
+    PRIORITY_TYPE priority)
+{
+    RETURN_CODE_TYPE ret;
+    PROCESS_ID_TYPE pid;
+    PROCESS_ATTRIBUTE_TYPE process_attrs = {
+        .PERIOD = INFINITE_TIME_VALUE,
+        .TIME_CAPACITY = INFINITE_TIME_VALUE,
+        .STACK_SIZE = 8096, // the only accepted stack size!
+        .DEADLINE = SOFT,
+    };
+
+    process_attrs.ENTRY_POINT = entry;
+    process_attrs.BASE_PRIORITY = priority;
+    strncpy(process_attrs.NAME, name, sizeof(PROCESS_NAME_TYPE));
+
+    CREATE_PROCESS(&process_attrs, &pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create process %s: %d\n", name, (int) ret);
+        return 1;
+    }
+
+    START(pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't start process %s: %d\n", name, (int) ret);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int create_queuing_port(const char* format, MESSAGE_SIZE_TYPE size,
+    PORT_DIRECTION_TYPE direction, QUEUING_PORT_ID_TYPE* id)
+{
+    RETURN_CODE_TYPE ret;
+    char name[MAX_NAME_LENGTH];
+
+    snprintf(name, sizeof(name), format, (int)size);
+    CREATE_QUEUING_PORT(name, size, QUEUE_DEPTH, direction, FIFO, id, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create port %s: %d\n", name, (int) ret);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int create_sampling_port(const char* format, MESSAGE_SIZE_TYPE size,
+    PORT_DIRECTION_TYPE direction, SAMPLING_PORT_ID_TYPE* id)
+{
+    RETURN_CODE_TYPE ret;
+    char name[MAX_NAME_LENGTH];
+
+    snprintf(name, sizeof(name), format, (int)size);
+    CREATE_SAMPLING_PORT(name, size, direction, 1000000000LL, id, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create port %s: %d\n", name, (int) ret);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int create_ports(void)
+{
+    unsigned s;
+
+    for(s = 0; s < NB_PORT_SETS; s++) {
+        struct port_set* ps = &port_sets[s];
+
+        if(create_queuing_port("Q%d_REQ_OUT", ps->size, SOURCE, &ps->req_out))
+            return 1;
+        if(create_queuing_port("Q%d_REQ_IN", ps->size, DESTINATION, &ps->req_in))
+            return 1;
+        if(create_queuing_port("Q%d_REP_OUT", ps->size, SOURCE, &ps->rep_out))
+            return 1;
+        if(create_queuing_port("Q%d_REP_IN", ps->size, DESTINATION, &ps->rep_in))
+            return 1;
+        if(create_sampling_port("S%d_OUT", ps->size, SOURCE, &ps->s_out))
+            return 1;
+        if(create_sampling_port("S%d_IN", ps->size, DESTINATION, &ps->s_in))
+            return 1;
+    }
+
+    return 0;
+}
+
+static int real_main(void)
+{
+    RETURN_CODE_TYPE ret;
+
+    memset(client_buf, 0x5a, sizeof(client_buf));
+
+    if(create_ports()) return 1;
+
+    if(create_and_start(client_process, "client", MIN_PRIORITY_VALUE))
+        return 1;
+    if(create_and_start(echo_process, "echo", MIN_PRIORITY_VALUE + 1))
+        return 1;
+
+    // transition to NORMAL operating mode
+    // N.B. if everything is OK, this never returns
+    SET_PARTITION_MODE(NORMAL, &ret);
+
+    if (ret != NO_ERROR) {
+        printf("couldn't transit to normal operating mode: %d\n", (int) ret);
+    }
+
+    return 0;
+}
+
+void main(void) {
+    real_main();
+    STOP_SELF();
+}
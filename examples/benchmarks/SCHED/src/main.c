@@ -0,0 +1,419 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Benchmarks of the syscall path, intra-partition context switch
+ * and intra-partition communication objects.
+ *
+ * Processes run in the following order (by priorities):
+ *
+ *  1. Two yielders with equal priorities pass the CPU to each other
+ *     with TIMED_WAIT(0). This measures context switch.
+ *  2. Waiter blocks on an object.
+ *  3. Signaler measures uncontended operations on separate objects,
+ *     then wakes the waiter through every object in turn.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <arinc653/partition.h>
+#include <arinc653/process.h>
+#include <arinc653/time.h>
+#include <arinc653/semaphore.h>
+#include <arinc653/event.h>
+#include <arinc653/buffer.h>
+#include <arinc653/blackboard.h>
+#include <core/syscall.h>
+
+#include "../../common/bench.h"
+
+#define MESSAGE_SIZE 64
+
+static char message[MESSAGE_SIZE];
+
+/* Objects used by the signaler alone. */
+static SEMAPHORE_ID_TYPE sem_free;
+static EVENT_ID_TYPE event_free;
+static BUFFER_ID_TYPE buffer_free;
+static BLACKBOARD_ID_TYPE blackboard_free;
+
+/* Objects on which the waiter blocks. */
+static SEMAPHORE_ID_TYPE sem_contended;
+static EVENT_ID_TYPE event_contended;
+static BUFFER_ID_TYPE buffer_contended;
+static BLACKBOARD_ID_TYPE blackboard_contended;
+
+/*
+ * Context switch.
+ *
+ * Yielder stores timebase and identifier just before yielding;
+ * other yielder computes the difference right after its own yield
+ * returns.
+ */
+static volatile uint64_t yield_time;
+static volatile int yield_owner = -1;
+static struct bench_result context_switch;
+
+static void yielder(int id)
+{
+    RETURN_CODE_TYPE ret;
+    int i;
+
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        uint64_t now = bench_now();
+        if(yield_owner != -1 && yield_owner != id)
+            bench_result_add(&context_switch, now - yield_time);
+
+        yield_owner = id;
+        yield_time = bench_now();
+        TIMED_WAIT(0, &ret);
+    }
+
+    yield_owner = -1;
+    STOP_SELF();
+}
+
+static void yielder_1(void)
+{
+    yielder(1);
+}
+
+static void yielder_2(void)
+{
+    yielder(2);
+}
+
+/*
+ * Wakeup of the process, blocked on the object.
+ *
+ * "wakeup" is the time from the start of the signal operation till the
+ * waiter returns from the wait operation. "roundtrip" is the time till
+ * the signal operation returns, that is, after the waiter has cleaned
+ * up and blocked again.
+ */
+struct wakeup_bench
+{
+    const char* name_wakeup;
+    const char* name_roundtrip;
+    void (*wait)(void);
+    void (*cleanup)(void);
+    void (*signal)(void);
+    struct bench_result wakeup;
+    struct bench_result roundtrip;
+};
+
+static void semaphore_wait(void)
+{
+    RETURN_CODE_TYPE ret;
+    WAIT_SEMAPHORE(sem_contended, INFINITE_TIME_VALUE, &ret);
+}
+
+static void semaphore_signal(void)
+{
+    RETURN_CODE_TYPE ret;
+    SIGNAL_SEMAPHORE(sem_contended, &ret);
+}
+
+static void event_wait(void)
+{
+    RETURN_CODE_TYPE ret;
+    WAIT_EVENT(event_contended, INFINITE_TIME_VALUE, &ret);
+}
+
+static void event_cleanup(void)
+{
+    RETURN_CODE_TYPE ret;
+    RESET_EVENT(event_contended, &ret);
+}
+
+static void event_signal(void)
+{
+    RETURN_CODE_TYPE ret;
+    SET_EVENT(event_contended, &ret);
+}
+
+static void buffer_wait(void)
+{
+    RETURN_CODE_TYPE ret;
+    MESSAGE_SIZE_TYPE len;
+    char buf[MESSAGE_SIZE];
+    RECEIVE_BUFFER(buffer_contended, INFINITE_TIME_VALUE,
+        (MESSAGE_ADDR_TYPE)buf, &len, &ret);
+}
+
+static void buffer_signal(void)
+{
+    RETURN_CODE_TYPE ret;
+    SEND_BUFFER(buffer_contended, (MESSAGE_ADDR_TYPE)message, MESSAGE_SIZE,
+        0, &ret);
+}
+
+static void blackboard_wait(void)
+{
+    RETURN_CODE_TYPE ret;
+    MESSAGE_SIZE_TYPE len;
+    char buf[MESSAGE_SIZE];
+    READ_BLACKBOARD(blackboard_contended, INFINITE_TIME_VALUE,
+        (MESSAGE_ADDR_TYPE)buf, &len, &ret);
+}
+
+static void blackboard_cleanup(void)
+{
+    RETURN_CODE_TYPE ret;
+    CLEAR_BLACKBOARD(blackboard_contended, &ret);
+}
+
+static void blackboard_signal(void)
+{
+    RETURN_CODE_TYPE ret;
+    DISPLAY_BLACKBOARD(blackboard_contended, (MESSAGE_ADDR_TYPE)message,
+        MESSAGE_SIZE, &ret);
+}
+
+static struct wakeup_bench wakeup_benches[] = {
+    {"semaphore_wakeup", "semaphore_roundtrip",
+        semaphore_wait, NULL, semaphore_signal},
+    {"event_wakeup", "event_roundtrip",
+        event_wait, event_cleanup, event_signal},
+    {"buffer_wakeup", "buffer_roundtrip",
+        buffer_wait, NULL, buffer_signal},
+    {"blackboard_wakeup", "blackboard_roundtrip",
+        blackboard_wait, blackboard_cleanup, blackboard_signal},
+};
+
+#define NB_WAKEUP_BENCHES (sizeof(wakeup_benches) / sizeof(wakeup_benches[0]))
+
+/* Timebase value just before the signal. */
+static volatile uint64_t signal_time;
+
+static void waiter_process(void)
+{
+    unsigned b;
+    int i;
+
+    for(b = 0; b < NB_WAKEUP_BENCHES; b++) {
+        struct wakeup_bench* bench = &wakeup_benches[b];
+
+        for(i = 0; i < BENCH_ITERATIONS; i++) {
+            bench->wait();
+            bench_result_add(&bench->wakeup, bench_now() - signal_time);
+            if(bench->cleanup) bench->cleanup();
+        }
+    }
+
+    STOP_SELF();
+}
+
+/* Measure operations, which neither block nor wake up anybody. */
+static void run_uncontended(void)
+{
+    RETURN_CODE_TYPE ret;
+    MESSAGE_SIZE_TYPE len;
+    char buf[MESSAGE_SIZE];
+    struct bench_result res;
+    uint64_t start;
+    int i;
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        bench_result_add(&res, bench_now() - start);
+    }
+    bench_result_print("timebase", &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        // Nothing to reschedule, so this is the cheapest syscall.
+        jet_resched();
+        bench_result_add(&res, bench_now() - start);
+    }
+    bench_result_print("null_syscall", &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        WAIT_SEMAPHORE(sem_free, 0, &ret);
+        SIGNAL_SEMAPHORE(sem_free, &ret);
+        bench_result_add(&res, bench_now() - start);
+    }
+    bench_result_print("semaphore_wait_signal", &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        SET_EVENT(event_free, &ret);
+        RESET_EVENT(event_free, &ret);
+        bench_result_add(&res, bench_now() - start);
+    }
+    bench_result_print("event_set_reset", &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        SEND_BUFFER(buffer_free, (MESSAGE_ADDR_TYPE)message, MESSAGE_SIZE,
+            0, &ret);
+        RECEIVE_BUFFER(buffer_free, 0, (MESSAGE_ADDR_TYPE)buf, &len, &ret);
+        bench_result_add(&res, bench_now() - start);
+    }
+    bench_result_print("buffer_send_receive", &res);
+
+    bench_result_init(&res);
+    for(i = 0; i < BENCH_ITERATIONS; i++) {
+        start = bench_now();
+        DISPLAY_BLACKBOARD(blackboard_free, (MESSAGE_ADDR_TYPE)message,
+            MESSAGE_SIZE, &ret);
+        READ_BLACKBOARD(blackboard_free, 0, (MESSAGE_ADDR_TYPE)buf, &len,
+            &ret);
+        bench_result_add(&res, bench_now() - start);
+    }
+    bench_result_print("blackboard_display_read", &res);
+}
+
+static void signaler_process(void)
+{
+    unsigned b;
+    int i;
+
+    bench_result_print("context_switch", &context_switch);
+
+    run_uncontended();
+
+    for(b = 0; b < NB_WAKEUP_BENCHES; b++) {
+        struct wakeup_bench* bench = &wakeup_benches[b];
+
+        for(i = 0; i < BENCH_ITERATIONS; i++) {
+            signal_time = bench_now();
+            bench->signal();
+            bench_result_add(&bench->roundtrip, bench_now() - signal_time);
+        }
+    }
+
+    for(b = 0; b < NB_WAKEUP_BENCHES; b++) {
+        bench_result_print(wakeup_benches[b].name_wakeup,
+            &wakeup_benches[b].wakeup);
+        bench_result_print(wakeup_benches[b].name_roundtrip,
+            &wakeup_benches[b].roundtrip);
+    }
+
+    bench_end("SCHED");
+
+    STOP_SELF();
+}
+
+static int create_and_start(void (*entry)(void), const char* name,
+    PRIORITY_TYPE priority)
+{
+    RETURN_CODE_TYPE ret;
+    PROCESS_ID_TYPE pid;
+    PROCESS_ATTRIBUTE_TYPE process_attrs = {
+        .PERIOD = INFINITE_TIME_VALUE,
+        .TIME_CAPACITY = INFINITE_TIME_VALUE,
+        .STACK_SIZE = 8096, // the only accepted stack size!
+        .DEADLINE = SOFT,
+    };
+
+    process_attrs.ENTRY_POINT = entry;
+    process_attrs.BASE_PRIORITY = priority;
+    strncpy(process_attrs.NAME, name, sizeof(PROCESS_NAME_TYPE));
+
+    CREATE_PROCESS(&process_attrs, &pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create process %s: %d\n", name, (int) ret);
+        return 1;
+    }
+
+    START(pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't start process %s: %d\n", name, (int) ret);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int create_objects(void)
+{
+    RETURN_CODE_TYPE ret;
+
+    CREATE_SEMAPHORE("sem_free", 1, 1, FIFO, &sem_free, &ret);
+    if (ret != NO_ERROR) goto err;
+    CREATE_SEMAPHORE("sem_contended", 0, BENCH_ITERATIONS, FIFO,
+        &sem_contended, &ret);
+    if (ret != NO_ERROR) goto err;
+
+    CREATE_EVENT("event_free", &event_free, &ret);
+    if (ret != NO_ERROR) goto err;
+    CREATE_EVENT("event_contended", &event_contended, &ret);
+    if (ret != NO_ERROR) goto err;
+
+    CREATE_BUFFER("buffer_free", MESSAGE_SIZE, 1, FIFO, &buffer_free, &ret);
+    if (ret != NO_ERROR) goto err;
+    CREATE_BUFFER("buffer_contended", MESSAGE_SIZE, 1, FIFO,
+        &buffer_contended, &ret);
+    if (ret != NO_ERROR) goto err;
+
+    CREATE_BLACKBOARD("blackboard_free", MESSAGE_SIZE, &blackboard_free, &ret);
+    if (ret != NO_ERROR) goto err;
+    CREATE_BLACKBOARD("blackboard_contended", MESSAGE_SIZE,
+        &blackboard_contended, &ret);
+    if (ret != NO_ERROR) goto err;
+
+    return 0;
+
+err:
+    printf("couldn't create objects: %d\n", (int) ret);
+    return 1;
+}
+
+static int real_main(void)
+{
+    RETURN_CODE_TYPE ret;
+    unsigned b;
+
+    memset(message, 0x5a, sizeof(message));
+
+    bench_result_init(&context_switch);
+    for(b = 0; b < NB_WAKEUP_BENCHES; b++) {
+        bench_result_init(&wakeup_benches[b].wakeup);
+        bench_result_init(&wakeup_benches[b].roundtrip);
+    }
+
+    if(create_objects()) return 1;
+
+    if(create_and_start(signaler_process, "signaler", MIN_PRIORITY_VALUE))
+        return 1;
+    if(create_and_start(waiter_process, "waiter", MIN_PRIORITY_VALUE + 1))
+        return 1;
+    if(create_and_start(yielder_1, "yielder 1", MIN_PRIORITY_VALUE + 2))
+        return 1;
+    if(create_and_start(yielder_2, "yielder 2", MIN_PRIORITY_VALUE + 2))
+        return 1;
+
+    // transition to NORMAL operating mode
+    // N.B. if everything is OK, this never returns
+    SET_PARTITION_MODE(NORMAL, &ret);
+
+    if (ret != NO_ERROR) {
+        printf("couldn't transit to normal operating mode: %d\n", (int) ret);
+    }
+
+    return 0;
+}
+
+void main(void) {
+    real_main();
+    STOP_SELF();
+}
@@ -0,0 +1,132 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+
+/*
+ * Second partition of the partition switch benchmark.
+ *
+ * Spins reading the timebase, like SWITCH_A does. At the beginning of
+ * every window it reads the end of SWITCH_A's previous window. The
+ * difference with the beginning of our previous window is the cost of
+ * switching from SWITCH_A to SWITCH_B: timer interrupt, partition
+ * scheduler, address space switch and return into user space.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <arinc653/partition.h>
+#include <arinc653/process.h>
+#include <arinc653/sampling.h>
+
+#include "../../common/bench.h"
+
+/* Number of windows to measure. */
+#define BENCH_WINDOWS 100
+
+static SAMPLING_PORT_ID_TYPE port;
+
+static void spinner_process(void)
+{
+    RETURN_CODE_TYPE ret;
+    uint64_t threshold = bench_ticks_per_ms() / 2;
+    uint64_t last = bench_now();
+    // Borders of our previous window.
+    uint64_t prev_first = 0, prev_last = 0;
+    struct bench_result res;
+    int windows = 0;
+
+    bench_result_init(&res);
+
+    while(windows < BENCH_WINDOWS) {
+        uint64_t now = bench_now();
+
+        if(now - last > threshold) {
+            uint64_t a_last;
+            MESSAGE_SIZE_TYPE len;
+            VALIDITY_TYPE validity;
+
+            READ_SAMPLING_MESSAGE(port, (MESSAGE_ADDR_TYPE)&a_last, &len,
+                &validity, &ret);
+            /*
+             * Message is accounted only if SWITCH_A has run between
+             * our two previous windows.
+             */
+            if(ret == NO_ERROR && len == sizeof(a_last)
+                && a_last > prev_last && a_last < prev_first)
+                bench_result_add(&res, prev_first - a_last);
+
+            prev_last = last;
+            prev_first = now;
+            windows++;
+            now = bench_now();
+        }
+        last = now;
+    }
+
+    bench_result_print("partition_switch", &res);
+    bench_end("SWITCH");
+
+    STOP_SELF();
+}
+
+static int real_main(void)
+{
+    RETURN_CODE_TYPE ret;
+    PROCESS_ID_TYPE pid;
+    PROCESS_ATTRIBUTE_TYPE process_attrs = {
+        .PERIOD = INFINITE_TIME_VALUE,
+        .TIME_CAPACITY = INFINITE_TIME_VALUE,
+        .STACK_SIZE = 8096, // the only accepted stack size!
+        .BASE_PRIORITY = MIN_PRIORITY_VALUE,
+        .DEADLINE = SOFT,
+    };
+
+    CREATE_SAMPLING_PORT("A_LAST", sizeof(uint64_t), DESTINATION, 1000000000LL,
+        &port, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create port A_LAST: %d\n", (int) ret);
+        return 1;
+    }
+
+    process_attrs.ENTRY_POINT = spinner_process;
+    strncpy(process_attrs.NAME, "spinner", sizeof(PROCESS_NAME_TYPE));
+
+    CREATE_PROCESS(&process_attrs, &pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't create process: %d\n", (int) ret);
+        return 1;
+    }
+
+    START(pid, &ret);
+    if (ret != NO_ERROR) {
+        printf("couldn't start process: %d\n", (int) ret);
+        return 1;
+    }
+
+    // transition to NORMAL operating mode
+    // N.B. if everything is OK, this never returns
+    SET_PARTITION_MODE(NORMAL, &ret);
+
+    if (ret != NO_ERROR) {
+        printf("couldn't transit to normal operating mode: %d\n", (int) ret);
+    }
+
+    return 0;
+}
+
+void main(void) {
+    real_main();
+    STOP_SELF();
+}
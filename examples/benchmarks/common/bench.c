@@ -0,0 +1,76 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <stdio.h>
+#include <arinc653/time.h>
+#include "bench.h"
+
+void bench_result_init(struct bench_result* res)
+{
+    res->min = (uint64_t)-1;
+    res->max = 0;
+    res->sum = 0;
+    res->n = 0;
+}
+
+void bench_result_add(struct bench_result* res, uint64_t value)
+{
+    if(value < res->min) res->min = value;
+    if(value > res->max) res->max = value;
+    res->sum += value;
+    res->n++;
+}
+
+void bench_result_print(const char* name, const struct bench_result* res)
+{
+    if(res->n == 0) {
+        printf("[BENCH] %s n=0\n", name);
+        return;
+    }
+
+    printf("[BENCH] %s n=%u min=%lu avg=%lu max=%lu\n", name, res->n,
+        (unsigned long)res->min,
+        (unsigned long)(res->sum / res->n),
+        (unsigned long)res->max);
+}
+
+/* Interval of system time for bench_ticks_per_ms(), in nanoseconds. */
+#define TICKS_PER_MS_INTERVAL 100000000LL
+
+uint64_t bench_ticks_per_ms(void)
+{
+    RETURN_CODE_TYPE ret;
+    SYSTEM_TIME_TYPE start_time, time;
+    uint64_t start;
+
+    // System time changes in steps: start exactly at the step.
+    GET_TIME(&time, &ret);
+    do {
+        GET_TIME(&start_time, &ret);
+    } while(start_time == time);
+    start = bench_now();
+
+    // Preemption during the measurement doesn't affect the ratio.
+    do {
+        GET_TIME(&time, &ret);
+    } while(time - start_time < TICKS_PER_MS_INTERVAL);
+
+    return (bench_now() - start) * 1000000 / (time - start_time);
+}
+
+void bench_end(const char* partition)
+{
+    printf("[BENCH] end %s\n", partition);
+}
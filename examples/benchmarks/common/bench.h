@@ -0,0 +1,67 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __BENCHMARKS_BENCH_H__
+#define __BENCHMARKS_BENCH_H__
+
+/*
+ * Helpers shared by all benchmark partitions.
+ *
+ * Every result is printed as single line
+ *
+ *     [BENCH] <name> n=<samples> min=<ticks> avg=<ticks> max=<ticks>
+ *
+ * and every partition finishes its output with
+ *
+ *     [BENCH] end <partition>
+ *
+ * Those lines are collected by misc/benchmarks.py.
+ */
+
+#include <types.h>
+#include <asp/time.h>
+
+/* Number of samples for every benchmark. */
+#define BENCH_ITERATIONS 1000
+
+struct bench_result
+{
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+    unsigned n;
+};
+
+/* Current value of the timebase (TSC on x86). */
+static inline uint64_t bench_now(void)
+{
+    return lja_timebase();
+}
+
+void bench_result_init(struct bench_result* res);
+void bench_result_add(struct bench_result* res, uint64_t value);
+void bench_result_print(const char* name, const struct bench_result* res);
+
+/*
+ * Return number of timebase ticks per millisecond of system time.
+ *
+ * Spins for about 100 milliseconds of system time.
+ */
+uint64_t bench_ticks_per_ms(void);
+
+/* Print line, which marks the end of partition's results. */
+void bench_end(const char* partition);
+
+#endif /* __BENCHMARKS_BENCH_H__ */
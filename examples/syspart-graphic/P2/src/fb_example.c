@@ -13,14 +13,28 @@
  * See the GNU General Public License version 3 for more details.
  */
 
+/*
+ * Airplane moving across the screen.
+ *
+ * The path is passed twice: first the whole image is redrawn per-pixel
+ * every frame, then gfx library is used, which erases and blends only
+ * changed areas and synchronizes buffers on swap by dirty rectangles.
+ *
+ * Time of every frame (drawing and swap, without waiting) is printed as
+ *
+ *     [BENCH] <name> n=<frames> min=<ticks> avg=<ticks> max=<ticks>
+ */
+
 #include <stdio.h>
 #include <string.h>
 #include <arinc653/time.h>
+#include <asp/time.h>
 
 #include <fb.h>
+#include <gfx.h>
 #define MILLISECOND 1000000
 
-uint32_t rgba_to_argb(uint32_t rgba_color);
+#define BACKGROUND 0xff000000u
 
 struct gimp_image {
   unsigned int  width;
@@ -31,34 +45,130 @@ struct gimp_image {
 
 extern const struct gimp_image gimp_image; //Image of airplane
 
+#define SPRITE_MAX_PIXELS (300 * 94)
+
+/* Image, converted to ARGB once. */
+static uint32_t sprite_pixels[SPRITE_MAX_PIXELS];
+
+struct frame_stats {
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+    unsigned n;
+};
+
+static void frame_stats_add(struct frame_stats *stats, uint64_t value)
+{
+    if (stats->n == 0 || value < stats->min) stats->min = value;
+    if (value > stats->max) stats->max = value;
+    stats->sum += value;
+    stats->n++;
+}
 
-static void draw_image(struct uwrm_scm_direct_fb *fb, int x_start, int y_start)
+static void frame_stats_print(const char *name, const struct frame_stats *stats)
+{
+    if (stats->n == 0)
+        return;
+
+    printf("[BENCH] %s n=%u min=%lu avg=%lu max=%lu\n", name, stats->n,
+        (unsigned long)stats->min,
+        (unsigned long)(stats->sum / stats->n),
+        (unsigned long)stats->max);
+}
+
+static void draw_image(struct gfx_surface *surface, int x_start, int y_start)
 {
     uint32_t *addr;
     for (int y = 0; y < gimp_image.height; y++) {
         for (int x = 0; x < gimp_image.width; x++) {
-            addr = (uint32_t *) fb->back_surface + (y+y_start)*fb->width + x + x_start;
+            addr = gfx_pixel(surface, x + x_start, y + y_start);
             uint32_t rgba_pixel = (((uint32_t*)gimp_image.pixel_data)[y*gimp_image.width + x]);
-            *addr = rgba_to_argb(rgba_pixel);
+            *addr = gfx_rgba_to_argb_pixel(rgba_pixel);
         }
     }
 }
 
-void fb_example_run(void)
+static void run_legacy(struct gfx_display *disp, struct frame_stats *stats)
 {
     RETURN_CODE_TYPE ret;
-
-    struct uwrm_scm_direct_fb fb;
-    uwrm_scm_get_direct_fb(&fb);
-
-    int y = fb.height - 100;
+    int y = disp->fb.height - 100;
     int x = 0;
 
     while (y > 0) {
-        draw_image(&fb, x, y);
-        uwrm_scm_fb_swap(&fb);
+        uint64_t start = lja_timebase();
+
+        draw_image(gfx_display_back(disp), x, y);
+        gfx_display_swap(disp);
+
+        frame_stats_add(stats, lja_timebase() - start);
         y--;
         x++;
         TIMED_WAIT(MILLISECOND, &ret);
     }
 }
+
+static void run_gfx(struct gfx_display *disp, struct frame_stats *stats)
+{
+    RETURN_CODE_TYPE ret;
+    struct gfx_surface sprite = {
+        .pixels = sprite_pixels,
+        .width = gimp_image.width,
+        .height = gimp_image.height,
+        .stride = gimp_image.width,
+    };
+    struct gfx_rect prev = {0, 0, 0, 0};
+    struct gfx_rect cur = {0, disp->fb.height - 100, sprite.width, sprite.height};
+
+    while (cur.y > 0) {
+        uint64_t start = lja_timebase();
+
+        gfx_fill_rect(gfx_display_back(disp), &prev, BACKGROUND);
+        gfx_display_mark(disp, &prev);
+
+        gfx_blend(gfx_display_back(disp), cur.x, cur.y, &sprite, NULL);
+        gfx_display_mark(disp, &cur);
+
+        gfx_display_swap(disp);
+
+        frame_stats_add(stats, lja_timebase() - start);
+        prev = cur;
+        cur.y--;
+        cur.x++;
+        TIMED_WAIT(MILLISECOND, &ret);
+    }
+}
+
+void fb_example_run(void)
+{
+    struct gfx_display disp;
+    struct frame_stats legacy = {0}, accelerated = {0};
+    struct gfx_rect all;
+
+    if (gfx_display_init(&disp, BACKGROUND) != UWRM_OK) {
+        printf("fb_example: couldn't get framebuffer\n");
+        return;
+    }
+
+    if (gimp_image.width * gimp_image.height > SPRITE_MAX_PIXELS) {
+        printf("fb_example: image is too large\n");
+        return;
+    }
+
+    gfx_rgba_to_argb(sprite_pixels, (const uint32_t *)gimp_image.pixel_data,
+        gimp_image.width * gimp_image.height);
+
+    run_legacy(&disp, &legacy);
+
+    all.x = 0;
+    all.y = 0;
+    all.w = disp.fb.width;
+    all.h = disp.fb.height;
+    gfx_fill_rect(gfx_display_back(&disp), &all, BACKGROUND);
+    gfx_display_mark(&disp, &all);
+    gfx_display_swap(&disp);
+
+    run_gfx(&disp, &accelerated);
+
+    frame_stats_print("fb_frame_legacy", &legacy);
+    frame_stats_print("fb_frame_gfx", &accelerated);
+}
@@ -27,6 +27,35 @@ QUEUING_PORT_ID_TYPE QP2;
 #define BIG_ARRAY_SIZE 10000
 char BIG_ARRAY[BIG_ARRAY_SIZE];
 
+/*
+ * Packets with zero first byte are sent back as is, only JetOS time
+ * is stored into them. Used by misc/net_load.py for latency measurement.
+ */
+#define ECHO_MODE 0
+#define ECHO_TIME_OFFSET 16
+#define ECHO_HEADER_SIZE 24
+
+static void echo_packet(MESSAGE_SIZE_TYPE len)
+{
+    RETURN_CODE_TYPE ret;
+    SYSTEM_TIME_TYPE now;
+    uint64_t t;
+    int i;
+
+    if (len < ECHO_HEADER_SIZE) return;
+
+    GET_TIME(&now, &ret);
+
+    // Network byte order.
+    t = now;
+    for (i = 7; i >= 0; i--) {
+        BIG_ARRAY[ECHO_TIME_OFFSET + i] = t & 0xff;
+        t >>= 8;
+    }
+
+    SEND_QUEUING_MESSAGE(QP1, (MESSAGE_ADDR_TYPE) BIG_ARRAY, len, 0, &ret);
+}
+
 static void first_process(void)
 {
     RETURN_CODE_TYPE ret;
@@ -59,7 +88,9 @@ static void first_process(void)
 
     while (1) {
         RECEIVE_QUEUING_MESSAGE(QP2, SECOND, (MESSAGE_ADDR_TYPE) BIG_ARRAY, &len, &ret);
-        if (ret == NO_ERROR) {
+        if (ret == NO_ERROR && BIG_ARRAY[0] == ECHO_MODE) {
+            echo_packet(len);
+        } else if (ret == NO_ERROR) {
             int COUNT = BIG_ARRAY[0];
             printf("START. sending %d\n", COUNT);
 
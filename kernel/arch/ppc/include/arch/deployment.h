@@ -50,6 +50,10 @@ struct ja_ppc_space
     size_t      size_total;
     /* State of the user stack allocator. */
     uint32_t    ustack_state;
+    /* TLB1 entry which maps the space, or -1. Set on initialization. */
+    int         tlb1_entry;
+    /* Number of TLB misses resolved for the space. */
+    uint32_t    nb_tlb_misses;
 };
 
 /*
@@ -58,7 +62,7 @@ struct ja_ppc_space
  * Should be defined in deployment.c.
  */
 extern struct ja_ppc_space ja_spaces[];
-extern int ja_spaces_n;
+extern const int ja_spaces_n;
 
 
 /*
@@ -75,6 +79,6 @@ struct tlb_entry {
 };
 
 extern struct tlb_entry jet_tlb_entries[];
-extern size_t jet_tlb_entries_n;
+extern const size_t jet_tlb_entries_n;
 
 #endif /* __JET_PPC_DEPLOYMENT_H__ */
@@ -24,6 +24,8 @@
 #include <core/debug.h>
 #include <libc.h>
 #include "reg.h"
+#include "msr.h"
+#include <core/profiler.h>
 
 #include "space.h"
 #include "timer.h"
@@ -200,7 +202,7 @@ unsigned long pok_int_system_call(struct jet_interrupt_context* ea,
 }
 
 void pok_int_decrementer(struct jet_interrupt_context* ea) {
-    (void) ea;
+    jet_profiler_tick(ea->srr0, (ea->srr1 & MSR_PR) == 0);
     pok_arch_decr_int();
 }
 
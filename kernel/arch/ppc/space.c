@@ -31,6 +31,7 @@
 #include "reg.h"
 #include "mmu.h"
 #include "space.h"
+#include "tlb.h"
 #include "cons.h"
 #include "core/partition.h"
 #include "core/partition_arinc.h"
@@ -67,9 +68,15 @@ void __user* ja_space_get_heap(jet_space_id space_id)
 
 void ja_space_switch (jet_space_id space_id)
 {
+    pok_ppc_tlb_space_switch(space_id);
     mtspr(SPRN_PID, space_id);
 }
 
+void ja_space_print_stats(void)
+{
+    pok_ppc_tlb_print_stats();
+}
+
 jet_space_id ja_space_get_current (void)
 {
     return (jet_space_id)mfspr(SPRN_PID);
@@ -99,173 +106,8 @@ jet_ustack_t ja_ustack_alloc (jet_space_id space_id, size_t stack_size)
     return result;
 }
 
-static unsigned next_resident = 0;
-static unsigned next_non_resident = 0;
-
-/*
- * Returns next available TLB1 entry index.
- *
- * If is_resident is true, entry will never be overwritten.
- *
- * First N entries are "resident" (kernel, devices, all that stuff), and others are evicted
- * by primitive round-robin algorithm.
- *
- * Note that the first request for resident TLB1 entry
- * returns the entry occupidied by the kernel.
- * This is intentional, as we have to overwrite it with
- * appropriate access rights.
- */
-int pok_get_next_tlb1_index(int is_resident)
-{
-
-    unsigned res;
-    unsigned available_space = pok_ppc_tlb_get_nentry(1); // mfspr(SPRN_TLB1CFG) & TLBnCFG_N_ENTRY_MASK;
-
-    if (is_resident) {
-        if (next_resident >= available_space) {
-            pok_fatal("Out of TLB1 space");
-        }
-
-        res = next_resident++;
-        next_non_resident = next_resident;
-    } else {
-        if (next_non_resident >= available_space) {
-            // wrap around
-            next_non_resident = next_resident;
-        }
-        if (next_non_resident >= available_space) {
-            pok_fatal("Out of TLB1 space");
-        }
-        res = next_non_resident++;
-    }
-
-    return res;
-}
-
-/*
- *  Quotes from the manual:
- *
- *      64-entry, fully-associative unified (for instruction and data accesses) L2 TLB array (TLB1)
- *      supports the 11 VSP page sizes shown in Section 6.2.3, “Variable-Sized Pages.”
- *
- *      The replacement algorithm for TLB1 must be implemented completely by the system software. Thus,
- *      when an entry in TLB1 is to be replaced, the software selects which entry to replace and writes the entry
- *      number to MAS0[ESEL] before executing a tlbwe instruction.
- */
-void pok_insert_tlb1(
-        uint64_t virtual,
-        uint64_t physical,
-        unsigned pgsize_enum,
-        unsigned permissions,
-        unsigned wimge,
-        unsigned pid,
-        pok_bool_t is_resident)
-{
-    /*
-     * TLB1 can be written by first writing the necessary information into MAS0–MAS3, MAS5, MAS7, and
-     * MAS8 using mtspr and then executing the tlbwe instruction. To write an entry into TLB1,
-     * MAS0[TLBSEL] must be equal to 1, and MAS0[ESEL] must point to the desired entry. When the tlbwe
-     * instruction is executed, the TLB entry information stored in MAS0–MAS3, MAS5, MAS7, and MAS8 is
-     * written into the selected TLB entry in the TLB1 array.
-     */
-
-    unsigned entry;
-
-    entry = pok_get_next_tlb1_index(is_resident);
-    pok_ppc_tlb_write(1,
-        virtual,
-        physical,
-        pgsize_enum,
-        permissions,
-        wimge,
-        pid,
-        entry,
-        TRUE);
-}
-
-static inline const char* pok_ppc_tlb_size(unsigned size)
-{
-    switch (size) {
-#define CASE(x) case E500MC_PGSIZE_##x: return #x;
-        CASE(4K);
-        CASE(16K);
-        CASE(64K);
-        CASE(256K);
-        CASE(1M);
-        CASE(4M);
-        CASE(16M);
-        CASE(64M);
-        CASE(256M);
-        CASE(1G);
-        CASE(4G);
-#undef CASE
-        default:
-        return "Unknown";
-    }
-}
-
-/*
- *  Quote from the manual:
- *
- *      A 512-entry, 4-way set-associative unified (for instruction and data accesses) L2 TLB array
- *      (TLB0) supports only 4-Kbyte pages.
- *
- *      TLB0 entry replacement is also implemented by software. To assist the software with TLB0 replacement,
- *      the core provides a hint that can be used for implementing a round-robin replacement algorithm. <...>
- */
-// XXX not implemented
-void pok_insert_tlb0();
-
-
 void pok_arch_space_init (void)
 {
-    // overwrites first TLB1 entry
-    // we just need to change access bits for the kernel,
-    // so user won't be able to access it
-    pok_insert_tlb1(
-        0,
-        0,
-        E500MC_PGSIZE_256M,  //TODO make smaller
-        MAS3_SW | MAS3_SR | MAS3_SX,
-        0,
-        0, // any pid
-        TRUE
-    );
-
-    /*
-     * Clear all other mappings. For instance, those created by u-boot.
-     */
-    unsigned limit = pok_ppc_tlb_get_nentry(1);
-//    pok_ppc_tlb_clear_entry(1, 2);
-    for (unsigned i = 1; i < limit; i++) {
-        pok_ppc_tlb_clear_entry(1, i);
-    }
-    pok_ppc_tlb_write(1,
-            pok_bsp.ccsrbar_base, pok_bsp.ccsrbar_base_phys, E500MC_PGSIZE_16M,
-            //MAS3_SW | MAS3_SR | MAS3_SX,
-            MAS3_SW | MAS3_SR | MAS3_SX | MAS3_UW | MAS3_UR,
-            MAS2_W | MAS2_I | MAS2_M | MAS2_G,
-            0,
-            limit-1,
-            TRUE);
-
-    // DIRTY HACK
-    // By some reason P3041 DUART blocks when TLB entry #1 is overrriden.
-    // Preserve it, let's POK write it's entries starting 2
-    next_non_resident = next_resident = 2;
-
-    for (int i = 0; i < jet_tlb_entries_n; i++) {
-        pok_insert_tlb1(
-                jet_tlb_entries[i].virt_addr,
-                jet_tlb_entries[i].phys_addr,
-                jet_tlb_entries[i].size,
-                jet_tlb_entries[i].permissions,
-                jet_tlb_entries[i].cache_policy,
-                jet_tlb_entries[i].pid,
-                TRUE
-                );
-    }
-
     for(int i = 0; i < ja_spaces_n; i++)
     {
         struct ja_ppc_space* space = &ja_spaces[i];
@@ -278,6 +120,8 @@ void pok_arch_space_init (void)
         // This should be checked when generate deployment.c too.
         assert(space->size_total < POK_PARTITION_MEMORY_SIZE);
     }
+
+    pok_ppc_tlb_init();
 }
 
 //TODO get this values from devtree!
@@ -292,23 +136,8 @@ void pok_arch_handle_page_fault(
 {
     int tlb_miss = (type == PF_INST_TLB_MISS || type == PF_DATA_TLB_MISS);
     unsigned pid = mfspr(SPRN_PID);
-    if (
-            tlb_miss &&
-            pid != 0 &&
-            faulting_address >= POK_PARTITION_MEMORY_BASE &&
-            faulting_address < POK_PARTITION_MEMORY_BASE + POK_PARTITION_MEMORY_SIZE)
-    {
-        jet_space_id space_id = pid;
-
-        pok_insert_tlb1(
-            POK_PARTITION_MEMORY_BASE,
-            ja_spaces[space_id - 1].phys_base,
-            E500MC_PGSIZE_16M,
-            MAS3_SW | MAS3_SR | MAS3_UW | MAS3_UR | MAS3_UX,
-            0,
-            pid,
-            FALSE
-        );
+    if (tlb_miss && pok_ppc_tlb_handle_miss(faulting_address, pid)) {
+        // Mapping is loaded, the access will be repeated.
     } else {
 #ifdef POK_NEEDS_DEBUG
         if (vctx->srr1 & MSR_PR) {
@@ -112,3 +112,14 @@ time_t ja_calendar_time(void)
 {
   return base_calendar_time + (time_t)(ja_system_time() / 1000000000);
 }
+
+void ja_time_fill_page(struct jet_kernel_time* __kuser kt)
+{
+  // User reads timebase via TBRU/TBRL, these SPRs are user-accessible.
+  kt->source = JET_KERNEL_TIME_SOURCE_TIMEBASE;
+  kt->tb_offset = time_first;
+  kt->tb_divider = time_inter;
+  kt->tb_multiplier = 1000000;
+  kt->value = 0;
+  kt->calendar_base = base_calendar_time;
+}
@@ -0,0 +1,429 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#include <types.h>
+#include <libc.h>
+#include <assert.h>
+#include <alloc.h>
+#include <core/debug.h>
+#include "bsp/bsp.h"
+
+#include "reg.h"
+#include "mmu.h"
+#include "tlb.h"
+
+#include <arch/deployment.h>
+
+/* Maximum number of TLB1 entries which may be managed. */
+#define TLB1_MAX_ENTRIES 64
+
+/*
+ * Region which requires more TLB1 pages than that is considered
+ * fragmented and is mapped via TLB0.
+ */
+#define TLB1_REGION_MAX_PAGES 4
+
+#define TLB_PAGE_SIZE_MIN 0x1000UL
+
+#define TLBnCFG_ASSOC_SHIFT 24
+#define TLBnCFG_ASSOC_MASK  0xff
+
+/* Size in bytes of the page with given size enumeration. */
+#define TLB_PGSIZE_BYTES(pgsize_enum) (1024ULL << (pgsize_enum))
+
+/* Contiguous mapping with the same attributes. */
+struct tlb_region
+{
+    uint32_t virt_addr;
+    uint64_t phys_addr;
+    uint64_t size;
+    unsigned permissions;
+    unsigned cache_policy;
+    unsigned pid;
+};
+
+/* Index of the first TLB1 entry which may be allocated. */
+static unsigned tlb1_next_resident;
+/* TLB1 entries in range [tlb1_next_resident; tlb1_limit) are evictable. */
+static unsigned tlb1_limit;
+static unsigned tlb1_next_victim;
+/* Space which mapping is stored in the evictable TLB1 entry, or 0. */
+static jet_space_id tlb1_owner[TLB1_MAX_ENTRIES];
+/* Whether all spaces are mapped with resident entries. */
+static pok_bool_t tlb1_spaces_resident;
+
+/* Regions mapped via TLB0. */
+static struct tlb_region* tlb0_regions;
+static size_t tlb0_regions_n;
+static unsigned tlb0_ways;
+static unsigned tlb0_next_way;
+
+/* Allocate resident TLB1 entry. */
+static unsigned tlb1_alloc_resident(void)
+{
+    if(tlb1_next_resident >= tlb1_limit)
+        pok_fatal("Out of TLB1 space");
+
+    return tlb1_next_resident++;
+}
+
+/* Allocate evictable TLB1 entry for the space. */
+static unsigned tlb1_alloc_evictable(jet_space_id space_id)
+{
+    unsigned entry;
+
+    if(tlb1_next_victim < tlb1_next_resident || tlb1_next_victim >= tlb1_limit)
+        tlb1_next_victim = tlb1_next_resident;
+
+    if(tlb1_next_victim >= tlb1_limit)
+        pok_fatal("Out of TLB1 space");
+
+    entry = tlb1_next_victim++;
+
+    if(tlb1_owner[entry] != 0)
+        ja_spaces[tlb1_owner[entry] - 1].tlb1_entry = -1;
+
+    tlb1_owner[entry] = space_id;
+
+    return entry;
+}
+
+/*
+ * Return the largest page for mapping the beginning of the region.
+ *
+ * Both addresses should be aligned to the page size.
+ */
+static unsigned tlb_region_page(uint32_t virt_addr, uint64_t phys_addr,
+    uint64_t size)
+{
+    unsigned pgsize_enum = E500MC_PGSIZE_4K;
+
+    while(pgsize_enum < E500MC_PGSIZE_4G)
+    {
+        uint64_t next_size = TLB_PGSIZE_BYTES(pgsize_enum + 2);
+
+        if(next_size > size) break;
+        if(virt_addr & (next_size - 1)) break;
+        if(phys_addr & (next_size - 1)) break;
+
+        pgsize_enum += 2;
+    }
+
+    return pgsize_enum;
+}
+
+/* Return number of pages needed for mapping the region with TLB1. */
+static unsigned tlb_region_n_pages(const struct tlb_region* region)
+{
+    uint32_t virt_addr = region->virt_addr;
+    uint64_t phys_addr = region->phys_addr;
+    uint64_t size = region->size;
+    unsigned n = 0;
+
+    while(size > 0)
+    {
+        uint64_t page_size = TLB_PGSIZE_BYTES(
+            tlb_region_page(virt_addr, phys_addr, size));
+
+        virt_addr += page_size;
+        phys_addr += page_size;
+        size -= page_size;
+        n++;
+    }
+
+    return n;
+}
+
+/* Map the region with resident TLB1 entries. */
+static void tlb_region_map_tlb1(const struct tlb_region* region)
+{
+    uint32_t virt_addr = region->virt_addr;
+    uint64_t phys_addr = region->phys_addr;
+    uint64_t size = region->size;
+
+    while(size > 0)
+    {
+        unsigned pgsize_enum = tlb_region_page(virt_addr, phys_addr, size);
+        uint64_t page_size = TLB_PGSIZE_BYTES(pgsize_enum);
+
+        pok_ppc_tlb_write(1,
+            virt_addr,
+            phys_addr,
+            pgsize_enum,
+            region->permissions,
+            region->cache_policy,
+            region->pid,
+            tlb1_alloc_resident(),
+            TRUE);
+
+        virt_addr += page_size;
+        phys_addr += page_size;
+        size -= page_size;
+    }
+}
+
+/* Whether region 'b' may be appended to the region 'a'. */
+static pok_bool_t tlb_region_is_adjacent(const struct tlb_region* a,
+    const struct tlb_region* b)
+{
+    return a->pid == b->pid
+        && a->permissions == b->permissions
+        && a->cache_policy == b->cache_policy
+        && (uint64_t)a->virt_addr + a->size == b->virt_addr
+        && a->phys_addr + a->size == b->phys_addr;
+}
+
+/* Order regions by attributes, then by virtual address. */
+static pok_bool_t tlb_region_less(const struct tlb_region* a,
+    const struct tlb_region* b)
+{
+    if(a->pid != b->pid) return a->pid < b->pid;
+    if(a->permissions != b->permissions) return a->permissions < b->permissions;
+    if(a->cache_policy != b->cache_policy) return a->cache_policy < b->cache_policy;
+    return a->virt_addr < b->virt_addr;
+}
+
+/*
+ * Map memory blocks.
+ *
+ * Mappings are coalesced into regions, each region is mapped either
+ * with TLB1 (if it requires few pages) or with TLB0.
+ *
+ * 'nb_reserved' TLB1 entries are left for spaces.
+ */
+static void tlb_map_memory_blocks(unsigned nb_reserved)
+{
+    struct tlb_region* regions;
+    size_t regions_n = 0;
+    size_t i, j;
+
+    if(jet_tlb_entries_n == 0) return;
+
+    regions = ja_mem_alloc_aligned(jet_tlb_entries_n * sizeof(*regions),
+        __alignof__(*regions));
+
+    // Insertion sort: number of entries is small.
+    for(i = 0; i < jet_tlb_entries_n; i++)
+    {
+        struct tlb_region region = {
+            .virt_addr = jet_tlb_entries[i].virt_addr,
+            .phys_addr = jet_tlb_entries[i].phys_addr,
+            .size = TLB_PGSIZE_BYTES(jet_tlb_entries[i].size),
+            .permissions = jet_tlb_entries[i].permissions,
+            .cache_policy = jet_tlb_entries[i].cache_policy,
+            .pid = jet_tlb_entries[i].pid,
+        };
+
+        for(j = i; j > 0 && tlb_region_less(&region, &regions[j - 1]); j--)
+            regions[j] = regions[j - 1];
+
+        regions[j] = region;
+    }
+
+    for(i = 0; i < jet_tlb_entries_n; i++)
+    {
+        if(regions_n > 0 && tlb_region_is_adjacent(&regions[regions_n - 1], &regions[i]))
+            regions[regions_n - 1].size += regions[i].size;
+        else
+            regions[regions_n++] = regions[i];
+    }
+
+    /*
+     * Regions which are not mapped via TLB1 are moved to the beginning
+     * of the array, which becomes the TLB0 table.
+     */
+    tlb0_regions = regions;
+    tlb0_regions_n = 0;
+
+    for(i = 0; i < regions_n; i++)
+    {
+        unsigned n_pages = tlb_region_n_pages(&regions[i]);
+
+        if(n_pages <= TLB1_REGION_MAX_PAGES
+            && tlb1_next_resident + n_pages + nb_reserved <= tlb1_limit)
+        {
+            tlb_region_map_tlb1(&regions[i]);
+        }
+        else
+        {
+            regions[tlb0_regions_n++] = regions[i];
+        }
+    }
+}
+
+/* Map the space with the TLB1 entry. */
+static void tlb_space_map(jet_space_id space_id, unsigned entry)
+{
+    pok_ppc_tlb_write(1,
+        POK_PARTITION_MEMORY_BASE,
+        ja_spaces[space_id - 1].phys_base,
+        E500MC_PGSIZE_16M,
+        MAS3_SW | MAS3_SR | MAS3_UW | MAS3_UR | MAS3_UX,
+        0,
+        space_id,
+        entry,
+        TRUE);
+
+    ja_spaces[space_id - 1].tlb1_entry = entry;
+}
+
+static void tlb_space_map_evictable(jet_space_id space_id)
+{
+    tlb_space_map(space_id, tlb1_alloc_evictable(space_id));
+}
+
+void pok_ppc_tlb_init(void)
+{
+    unsigned limit = pok_ppc_tlb_get_nentry(1);
+    unsigned i;
+
+    assert(limit <= TLB1_MAX_ENTRIES);
+
+    // Overwrite the first TLB1 entry: we just need to change access
+    // bits for the kernel, so user won't be able to access it.
+    pok_ppc_tlb_write(1,
+        0,
+        0,
+        E500MC_PGSIZE_256M,  //TODO make smaller
+        MAS3_SW | MAS3_SR | MAS3_SX,
+        0,
+        0, // any pid
+        0,
+        TRUE);
+
+    /*
+     * Clear all other mappings. For instance, those created by u-boot.
+     */
+    for (i = 1; i < limit; i++) {
+        pok_ppc_tlb_clear_entry(1, i);
+    }
+    pok_ppc_tlb_write(1,
+            pok_bsp.ccsrbar_base, pok_bsp.ccsrbar_base_phys, E500MC_PGSIZE_16M,
+            //MAS3_SW | MAS3_SR | MAS3_SX,
+            MAS3_SW | MAS3_SR | MAS3_SX | MAS3_UW | MAS3_UR,
+            MAS2_W | MAS2_I | MAS2_M | MAS2_G,
+            0,
+            limit-1,
+            TRUE);
+
+    // DIRTY HACK
+    // By some reason P3041 DUART blocks when TLB entry #1 is overrriden.
+    // Preserve it, let's POK write it's entries starting 2
+    tlb1_next_resident = 2;
+    // The last entry is occupied by CCSR.
+    tlb1_limit = limit - 1;
+
+    tlb0_ways = (mfspr(SPRN_TLB0CFG) >> TLBnCFG_ASSOC_SHIFT) & TLBnCFG_ASSOC_MASK;
+    tlb0_next_way = 0;
+
+    // At least one entry is needed for evictable mappings of spaces.
+    tlb_map_memory_blocks(ja_spaces_n > 0 ? 1 : 0);
+
+    for(i = 0; i < TLB1_MAX_ENTRIES; i++)
+        tlb1_owner[i] = 0;
+
+    tlb1_spaces_resident = (tlb1_limit - tlb1_next_resident >= (unsigned)ja_spaces_n);
+
+    for(i = 0; i < (unsigned)ja_spaces_n; i++)
+    {
+        ja_spaces[i].tlb1_entry = -1;
+        ja_spaces[i].nb_tlb_misses = 0;
+
+        if(tlb1_spaces_resident)
+            tlb_space_map(i + 1, tlb1_alloc_resident());
+    }
+
+    tlb1_next_victim = tlb1_next_resident;
+}
+
+void pok_ppc_tlb_space_switch(jet_space_id space_id)
+{
+    if(space_id == 0) return;
+
+    // Preload mapping instead of taking TLB miss after the switch.
+    if(ja_spaces[space_id - 1].tlb1_entry < 0)
+        tlb_space_map_evictable(space_id);
+}
+
+/* Load 4K page for the address from the region into TLB0. */
+static void tlb0_load(const struct tlb_region* region, uintptr_t address)
+{
+    uint32_t virt_addr = address & ~(TLB_PAGE_SIZE_MIN - 1);
+    unsigned way = tlb0_next_way;
+
+    tlb0_next_way = (tlb0_next_way + 1) % tlb0_ways;
+
+    pok_ppc_tlb_write(0,
+        virt_addr,
+        region->phys_addr + (virt_addr - region->virt_addr),
+        E500MC_PGSIZE_4K,
+        region->permissions,
+        region->cache_policy,
+        region->pid,
+        way,
+        TRUE);
+}
+
+pok_bool_t pok_ppc_tlb_handle_miss(uintptr_t address, unsigned pid)
+{
+    size_t i;
+
+    if(pid != 0
+        && address >= POK_PARTITION_MEMORY_BASE
+        && address < POK_PARTITION_MEMORY_BASE + POK_PARTITION_MEMORY_SIZE
+        && ja_spaces[pid - 1].tlb1_entry < 0)
+    {
+        ja_spaces[pid - 1].nb_tlb_misses++;
+
+        tlb_space_map_evictable(pid);
+
+        return TRUE;
+    }
+
+    for(i = 0; i < tlb0_regions_n; i++)
+    {
+        const struct tlb_region* region = &tlb0_regions[i];
+
+        if(region->pid != 0 && region->pid != pid) continue;
+        if(address < region->virt_addr) continue;
+        if(address - region->virt_addr >= region->size) continue;
+
+        if(pid != 0) ja_spaces[pid - 1].nb_tlb_misses++;
+
+        tlb0_load(region, address);
+
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+void pok_ppc_tlb_print_stats(void)
+{
+    int i;
+
+    printf("TLB1: %u resident entries, %u evictable, spaces are %s\n",
+        tlb1_next_resident, tlb1_limit - tlb1_next_resident,
+        tlb1_spaces_resident ? "resident" : "evictable");
+    printf("TLB0: %u regions\n", (unsigned)tlb0_regions_n);
+
+    for(i = 0; i < ja_spaces_n; i++)
+    {
+        printf("Space %d: %lu TLB misses\n", i + 1,
+            (unsigned long)ja_spaces[i].nb_tlb_misses);
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __POK_PPC_TLB_H__
+#define __POK_PPC_TLB_H__
+
+/*
+ * TLB manager.
+ *
+ * TLB1 entries are allocated as follows:
+ *
+ *  - entry 0 maps the kernel, entry 1 is preserved (see pok_ppc_tlb_init),
+ *    the last entry maps CCSR;
+ *  - memory blocks are coalesced into the fewest variable-size pages,
+ *    which are resident;
+ *  - every user space is mapped with a single 16M page tagged with
+ *    the space's PID. If there is enough room, these entries are
+ *    resident too. Otherwise they are evicted in round-robin order and
+ *    reloaded on switching into the space.
+ *
+ * Memory blocks which would require too many TLB1 entries (or don't fit
+ * into TLB1 at all) are mapped with 4K pages in TLB0 on demand, by the
+ * TLB miss handler.
+ */
+
+#include <types.h>
+#include <asp/space.h>
+
+/* Initialize TLB for the kernel, devices, memory blocks and spaces. */
+void pok_ppc_tlb_init(void);
+
+/* Make sure that mapping of the space is loaded into TLB. */
+void pok_ppc_tlb_space_switch(jet_space_id space_id);
+
+/*
+ * Resolve TLB miss for given address and PID.
+ *
+ * Return TRUE if mapping has been loaded, FALSE if address is not mapped.
+ */
+pok_bool_t pok_ppc_tlb_handle_miss(uintptr_t address, unsigned pid);
+
+/* Print usage of the TLB and number of TLB misses for every space. */
+void pok_ppc_tlb_print_stats(void);
+
+#endif /* __POK_PPC_TLB_H__ */
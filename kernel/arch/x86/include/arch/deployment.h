@@ -79,6 +79,6 @@ struct ja_x86_space
  * Should be defined in deployment.c.
  */
 extern struct ja_x86_space ja_spaces[];
-extern int ja_spaces_n;
+extern const int ja_spaces_n;
 
 #endif /* __JET_PPC_DEPLOYMENT_H__ */
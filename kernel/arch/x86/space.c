@@ -208,6 +208,12 @@ void ja_space_switch (jet_space_id space_id)
     current_space_id = space_id;
 }
 
+void ja_space_print_stats(void)
+{
+    // Spaces are segments, there are no per-space translation counters.
+    printf("No address translation statistics for x86\n");
+}
+
 jet_space_id ja_space_get_current (void)
 {
     return current_space_id;
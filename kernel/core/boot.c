@@ -31,6 +31,7 @@
 #include <core/partition.h>
 #include <core/partition_arinc.h>
 #include <core/channel.h>
+#include <core/profiler.h>
 #include <asp/entries.h>
 #include <libc.h>
 
@@ -50,6 +51,7 @@ void jet_boot (void)
 
 #ifdef POK_NEEDS_PARTITIONS
    pok_partition_arinc_init_all();
+   jet_profiler_init();
 #endif
 #ifdef POK_NEEDS_MONITOR
    pok_monitor_thread_init();
@@ -20,74 +20,359 @@
 
 #include <core/sched.h>
 #include <alloc.h>
+#include <libc.h>
 
 /*********************** Queuing channel ******************************/
 
-void pok_channel_queuing_init(pok_channel_queuing_t* channel)
+/* Alignment of messages in the channel's store. */
+#define CHANNEL_QUEUING_MESSAGE_ALIGNMENT __alignof__(int)
+
+/*
+ * Alignment of records (and of the size) of the packed ring.
+ *
+ * Should be not less than the record's header: a gap at the end of
+ * the ring is filled with the padding header.
+ */
+#define CHANNEL_QUEUING_RECORD_ALIGNMENT 8
+
+/* Helper: Allocate queue for the channel's side. */
+static void channel_queuing_side_alloc(struct pok_channel_queuing_side* side)
 {
-    channel->max_nb_message =
-        channel->recv.max_nb_message + channel->send.max_nb_message;
+    side->queue = ja_mem_alloc_aligned(
+        sizeof(*side->queue) * side->max_nb_message,
+        __alignof__(*side->queue));
 
-    channel->border = channel->recv.next_message = channel->send.next_message = 0;
+    side->nb_message = 0;
+    side->first_message = 0;
 
-    const unsigned int message_alignment = __alignof__(int);
+    side->generation = 0;
+    side->is_notify = FALSE;
+    side->message_discarded = FALSE;
+}
+
+/* Helper: Return number of bytes occupied by the record in the ring. */
+static inline uint32_t channel_queuing_record_len(pok_message_size_t size)
+{
+    return ALIGN_VAL(sizeof(struct jet_channel_queuing_record),
+            CHANNEL_QUEUING_RECORD_ALIGNMENT)
+        + ALIGN_VAL(size, CHANNEL_QUEUING_RECORD_ALIGNMENT);
+}
+
+/* Helper: Allocate store with slots for messages. */
+static void channel_queuing_slots_alloc(pok_channel_queuing_t* channel)
+{
+    pok_message_range_t i;
 
     channel->message_stride = ALIGN_VAL(channel->max_message_size,
-        message_alignment);
+        CHANNEL_QUEUING_MESSAGE_ALIGNMENT);
 
     channel->messages = ja_mem_alloc_aligned(
         channel->message_stride * channel->max_nb_message,
-        message_alignment);
+        CHANNEL_QUEUING_MESSAGE_ALIGNMENT);
 
     channel->message_sizes = ja_mem_alloc_aligned(
         sizeof(*channel->message_sizes) * channel->max_nb_message,
         __alignof__(*channel->message_sizes));
 
-    channel->send.generation = 0;
-    channel->send.is_notify = FALSE;
+    channel->message_refs = ja_mem_alloc_aligned(
+        sizeof(*channel->message_refs) * channel->max_nb_message,
+        __alignof__(*channel->message_refs));
 
-    channel->recv.generation = 0;
-    channel->recv.is_notify = FALSE;
+    channel->message_next_free = ja_mem_alloc_aligned(
+        sizeof(*channel->message_next_free) * channel->max_nb_message,
+        __alignof__(*channel->message_next_free));
 
-    channel->message_discarded = FALSE;
+    // Initially all slots are free.
+    for(i = 0; i < channel->max_nb_message; i++)
+    {
+        channel->message_refs[i] = 0;
+        channel->message_next_free[i] = i + 1;
+    }
+    channel->free_first = 0;
 }
 
-/*
- * Helper: Add index to given buffer's position in the channel.
+/* Helper: Allocate ring for packed messages. */
+static void channel_queuing_ring_alloc(pok_channel_queuing_t* channel)
+{
+    uint32_t min_bytes = channel_queuing_record_len(channel->max_message_size);
+
+    assert(sizeof(struct jet_channel_queuing_record)
+        <= CHANNEL_QUEUING_RECORD_ALIGNMENT);
+
+    channel->max_nb_bytes = ALIGN_VAL(channel->max_nb_bytes,
+        CHANNEL_QUEUING_RECORD_ALIGNMENT);
+    if(channel->max_nb_bytes < min_bytes)
+        channel->max_nb_bytes = min_bytes;
+
+    channel->messages = ja_mem_alloc_aligned(channel->max_nb_bytes,
+        CHANNEL_QUEUING_RECORD_ALIGNMENT);
+
+    channel->nb_bytes = 0;
+    channel->bytes_tail = 0;
+    channel->bytes_head = 0;
+    channel->bytes_reserved = 0;
+}
+
+void pok_channel_queuing_init(pok_channel_queuing_t* channel)
+{
+    pok_message_range_t i;
+
+    assert(channel->recv_n > 0);
+
+    channel_queuing_side_alloc(&channel->send);
+    channel->max_nb_message = channel->send.max_nb_message;
+
+    for(i = 0; i < channel->recv_n; i++)
+    {
+        channel_queuing_side_alloc(&channel->recv[i]);
+        channel->max_nb_message += channel->recv[i].max_nb_message;
+    }
+
+    if(channel->storage == JET_CHANNEL_QUEUING_STORAGE_PACKED)
+        channel_queuing_ring_alloc(channel);
+    else
+        channel_queuing_slots_alloc(channel);
+}
+
+/* Helper: Return record in the ring at given offset. */
+static inline struct jet_channel_queuing_record* channel_queuing_record_at(
+    pok_channel_queuing_t* channel, uint32_t offset)
+{
+    assert(offset < channel->max_nb_bytes);
+
+    return (struct jet_channel_queuing_record*)&channel->messages[offset];
+}
+
+/* Helper: Return message in the store with given reference. */
+static inline char* channel_queuing_message_at(
+    pok_channel_queuing_t* channel, jet_channel_queuing_ref_t ref)
+{
+    if(channel->storage == JET_CHANNEL_QUEUING_STORAGE_PACKED)
+        return (char*)channel_queuing_record_at(channel, ref)
+            + channel_queuing_record_len(0);
+
+    assert(ref < channel->max_nb_message);
+
+    return &channel->messages[channel->message_stride * ref];
+}
+
+/* Helper: Return size of the message with given reference. */
+static inline pok_message_size_t channel_queuing_message_size(
+    pok_channel_queuing_t* channel, jet_channel_queuing_ref_t ref)
+{
+    if(channel->storage == JET_CHANNEL_QUEUING_STORAGE_PACKED)
+        return channel_queuing_record_at(channel, ref)->size;
+
+    return channel->message_sizes[ref];
+}
+
+/* Helper: Return pointer to the counter of references to the message. */
+static inline uint8_t* channel_queuing_message_refs(
+    pok_channel_queuing_t* channel, jet_channel_queuing_ref_t ref)
+{
+    if(channel->storage == JET_CHANNEL_QUEUING_STORAGE_PACKED)
+        return &channel_queuing_record_at(channel, ref)->refs;
+
+    return &channel->message_refs[ref];
+}
+
+/* Helper: Return first message in the side's queue. */
+static inline jet_channel_queuing_ref_t channel_queuing_side_first(
+    struct pok_channel_queuing_side* side)
+{
+    assert(side->nb_message > 0);
+
+    return side->queue[side->first_message];
+}
+
+/* Helper: Add message to the end of the side's queue. */
+static inline void channel_queuing_side_push(
+    struct pok_channel_queuing_side* side, jet_channel_queuing_ref_t ref)
+{
+    pok_message_range_t pos;
+
+    assert(side->nb_message < side->max_nb_message);
+
+    pos = side->first_message + side->nb_message;
+    if(pos >= side->max_nb_message) pos -= side->max_nb_message;
+
+    side->queue[pos] = ref;
+    side->nb_message++;
+
+    if(side->nb_message > side->stats.nb_message_max)
+        side->stats.nb_message_max = side->nb_message;
+}
+
+/* Helper: Remove the first message from the side's queue and return it. */
+static inline jet_channel_queuing_ref_t channel_queuing_side_pop(
+    struct pok_channel_queuing_side* side)
+{
+    jet_channel_queuing_ref_t ref = channel_queuing_side_first(side);
+
+    if(++side->first_message == side->max_nb_message)
+        side->first_message = 0;
+    side->nb_message--;
+
+    return ref;
+}
+
+/* 
+ * Helper: Find place in the ring for the message of maximum size.
+ * 
+ * On success, store offset of the place into `bytes_reserved`.
  * 
- * Take into account cyclic nature of the channel's buffer.
+ * Because receivers may consume messages only at the tail of the ring,
+ * record is never wrapped: if it doesn't fit at the end of the ring,
+ * it is placed at the beginning.
  */
-static inline
-uint16_t channel_queuing_cyclic_add(pok_channel_queuing_t* channel,
-    uint16_t pos, uint16_t index)
+static pok_bool_t channel_queuing_ring_reserve(pok_channel_queuing_t* channel)
 {
-    uint16_t sum = pos + index;
-    if(sum >= channel->max_nb_message) sum -= channel->max_nb_message;
+    uint32_t len = channel_queuing_record_len(channel->max_message_size);
+    uint32_t head, tail;
 
-    return sum;
+    if(channel->nb_bytes == 0)
+    {
+        // Ring is empty, start from the beginning.
+        channel->bytes_head = 0;
+        channel->bytes_tail = 0;
+    }
+
+    head = channel->bytes_head;
+    tail = channel->bytes_tail;
+
+    if(head >= tail && channel->nb_bytes < channel->max_nb_bytes)
+    {
+        // Free space is [head, end) and [0, tail).
+        if(channel->max_nb_bytes - head >= len)
+        {
+            channel->bytes_reserved = head;
+            return TRUE;
+        }
+        else if(tail >= len)
+        {
+            channel->bytes_reserved = 0;
+            return TRUE;
+        }
+    }
+    else if(tail - head >= len)
+    {
+        // Free space is [head, tail).
+        channel->bytes_reserved = head;
+        return TRUE;
+    }
+
+    return FALSE;
 }
 
-/*
- * Helper: Get number of messages between given buffer's positions.
+/* 
+ * Helper: Commit record of given size at `bytes_reserved` offset.
  * 
- * Take into account cyclic nature of the channel's buffer.
+ * Return offset of the record.
  */
-static inline
-pok_message_range_t channel_queuing_cyclic_sub(pok_channel_queuing_t* channel,
-    pok_message_range_t pos_end, pok_message_range_t pos_start)
+static uint32_t channel_queuing_ring_commit(pok_channel_queuing_t* channel,
+    pok_message_size_t size)
 {
-    return pos_end >= pos_start
-        ? pos_end - pos_start
-        : pos_end + channel->max_nb_message - pos_start;
+    uint32_t offset = channel->bytes_reserved;
+    uint32_t len = channel_queuing_record_len(size);
+    struct jet_channel_queuing_record* record;
+
+    if(offset != channel->bytes_head)
+    {
+        // Record is placed at the beginning: pad the rest of the ring.
+        record = channel_queuing_record_at(channel, channel->bytes_head);
+        record->size = 0;
+        record->refs = 0;
+        record->is_used = FALSE;
+
+        channel->nb_bytes += channel->max_nb_bytes - channel->bytes_head;
+    }
+
+    record = channel_queuing_record_at(channel, offset);
+    record->size = size;
+    record->refs = 0;
+    record->is_used = TRUE;
+
+    channel->nb_bytes += len;
+    channel->bytes_head = (offset + len == channel->max_nb_bytes) ? 0 : offset + len;
+
+    return offset;
 }
 
-/* Helper: Return message in the buffer at given index. */
-static inline char* channel_queuing_message_at(
-    pok_channel_queuing_t* channel, pok_message_range_t pos)
+/* Helper: Mark message as free, so its bytes may be reused. */
+static void channel_queuing_ring_free(pok_channel_queuing_t* channel,
+    uint32_t offset)
 {
-    assert(pos < channel->max_nb_message);
+    channel_queuing_record_at(channel, offset)->is_used = FALSE;
+
+    // Release all free records at the tail of the ring.
+    while(channel->nb_bytes > 0)
+    {
+        uint32_t tail = channel->bytes_tail;
+        struct jet_channel_queuing_record* record =
+            channel_queuing_record_at(channel, tail);
+        uint32_t len;
 
-    return &channel->messages[channel->message_stride * pos];
+        if(record->is_used) break;
+
+        len = record->size
+            ? channel_queuing_record_len(record->size)
+            : channel->max_nb_bytes - tail;
+
+        channel->nb_bytes -= len;
+        tail += len;
+        channel->bytes_tail = (tail == channel->max_nb_bytes) ? 0 : tail;
+    }
+}
+
+/* Helper: Release the message, which is no longer referred. */
+static inline void channel_queuing_slot_free(pok_channel_queuing_t* channel,
+    jet_channel_queuing_ref_t ref)
+{
+    assert(*channel_queuing_message_refs(channel, ref) == 0);
+
+    if(channel->storage == JET_CHANNEL_QUEUING_STORAGE_PACKED)
+    {
+        channel_queuing_ring_free(channel, ref);
+        return;
+    }
+
+    channel->message_next_free[ref] = channel->free_first;
+    channel->free_first = ref;
+}
+
+/* Helper: Drop reference to the message from the receiver. */
+static inline void channel_queuing_slot_put(pok_channel_queuing_t* channel,
+    jet_channel_queuing_ref_t ref)
+{
+    uint8_t* refs = channel_queuing_message_refs(channel, ref);
+
+    assert(*refs > 0);
+
+    if(--*refs == 0)
+        channel_queuing_slot_free(channel, ref);
+}
+
+/* Helper: Drop all messages on the receiver side. */
+static void channel_queuing_r_drop_all(pok_channel_queuing_t* channel,
+    struct pok_channel_queuing_side* recv)
+{
+    while(recv->nb_message)
+        channel_queuing_slot_put(channel, channel_queuing_side_pop(recv));
+}
+
+/* Helper: Drop all messages on the sender side. */
+static void channel_queuing_s_drop_all(pok_channel_queuing_t* channel)
+{
+    while(channel->send.nb_message)
+        channel_queuing_slot_free(channel,
+            channel_queuing_side_pop(&channel->send));
+}
+
+/* Helper: Whether receiver has its connection initialized. */
+static inline pok_bool_t channel_queuing_side_is_ready(
+    struct pok_channel_queuing_side* side)
+{
+    return side->part->partition_generation == side->generation;
 }
 
 /* 
@@ -108,50 +393,126 @@ static inline void channel_queuing_side_notify(struct pok_channel_queuing_side*
     }
 }
 
+/* 
+ * Helper: Move messages from the sender buffer to receivers, while
+ * it is possible.
+ * 
+ * Should be executed with global preemption disabled.
+ */
+static void channel_queuing_transmit(pok_channel_queuing_t* channel)
+{
+    pok_bool_t sender_space_released = FALSE;
+
+    while(channel->send.nb_message)
+    {
+        jet_channel_queuing_ref_t ref = channel_queuing_side_first(&channel->send);
+        uint8_t* refs = channel_queuing_message_refs(channel, ref);
+        uint8_t i;
+
+        if(channel->overflow_strategy == JET_CHANNEL_QUEUING_SENDER_BLOCK)
+        {
+            // Message may be transmitted only when all receivers are ready for it.
+            for(i = 0; i < channel->recv_n; i++)
+            {
+                struct pok_channel_queuing_side* recv = &channel->recv[i];
+                if(channel_queuing_side_is_ready(recv)
+                    && recv->nb_message == recv->max_nb_message)
+                    break;
+            }
+            if(i < channel->recv_n) break;
+        }
+
+        channel_queuing_side_pop(&channel->send);
+        sender_space_released = TRUE;
+
+        for(i = 0; i < channel->recv_n; i++)
+        {
+            struct pok_channel_queuing_side* recv = &channel->recv[i];
+
+            if(!channel_queuing_side_is_ready(recv))
+            {
+                // Drop all messages which have been received.
+                channel_queuing_r_drop_all(channel, recv);
+            }
+            else if(recv->nb_message == recv->max_nb_message)
+            {
+                // Discard message for given receiver and store note about that.
+                recv->message_discarded = TRUE;
+                recv->stats.nb_discarded++;
+                channel->send.stats.nb_discarded++;
+            }
+            else
+            {
+                channel_queuing_side_push(recv, ref);
+                (*refs)++;
+                // And notify receiver, if requested.
+                channel_queuing_side_notify(recv,
+                    JET_PARTITION_EVENT_TYPE_PORT_RECEIVE_AVAILABLE);
+            }
+        }
+
+        // Noone has received the message.
+        if(*refs == 0)
+            channel_queuing_slot_free(channel, ref);
+    }
+
+    if(sender_space_released)
+        channel_queuing_side_notify(&channel->send,
+            JET_PARTITION_EVENT_TYPE_PORT_SEND_AVAILABLE);
+}
+
 void pok_channel_queuing_side_init(pok_channel_queuing_t* channel,
     struct pok_channel_queuing_side* side,
     uint16_t handler_id)
 {
     pok_preemption_disable();
-    side->next_message = channel->border;
+
+    if(side == &channel->send)
+        channel_queuing_s_drop_all(channel);
+    else
+        channel_queuing_r_drop_all(channel, side);
+
     side->is_notify = FALSE;
+    side->message_discarded = FALSE;
     side->generation = side->part->partition_generation;
     side->handler_id = handler_id;
 
     __pok_preemption_enable();
 }
 
-pok_message_range_t pok_channel_queuing_r_n_messages(pok_channel_queuing_t* channel)
+pok_message_range_t pok_channel_queuing_r_n_messages(
+    pok_channel_queuing_t* channel,
+    uint8_t recv_id)
 {
-    pok_preemption_disable();
-
-    size_t n_messages = channel_queuing_cyclic_sub(channel,
-        channel->border,
-        channel->recv.next_message);
+    assert(recv_id < channel->recv_n);
 
-    __pok_preemption_enable();
-
-    return n_messages;
+    // Reading single field is atomic.
+    return channel->recv[recv_id].nb_message;
 }
 
 const char* pok_channel_queuing_r_get_message(
     pok_channel_queuing_t* channel,
+    uint8_t recv_id,
     pok_message_size_t* size,
     pok_bool_t subscribe)
 {
+    struct pok_channel_queuing_side* recv = &channel->recv[recv_id];
     const char* message;
 
+    assert(recv_id < channel->recv_n);
+
     pok_preemption_disable();
 
-    if(channel->recv.next_message != channel->border)
+    if(recv->nb_message)
     {
-        message = channel_queuing_message_at(channel, channel->recv.next_message);
-        *size = channel->message_sizes[channel->recv.next_message];
+        jet_channel_queuing_ref_t ref = channel_queuing_side_first(recv);
+        message = channel_queuing_message_at(channel, ref);
+        *size = channel_queuing_message_size(channel, ref);
     }
     else
     {
         message = NULL;
-        if(subscribe) channel->recv.is_notify = TRUE;
+        if(subscribe) recv->is_notify = TRUE;
     }
 
     __pok_preemption_enable();
@@ -162,26 +523,34 @@ const char* pok_channel_queuing_r_get_message(
 
 void pok_channel_queuing_r_consume_message(
     pok_channel_queuing_t* channel,
+    uint8_t recv_id,
     pok_bool_t* message_discarded)
 {
-    assert(channel->recv.next_message != channel->border);
+    struct pok_channel_queuing_side* recv = &channel->recv[recv_id];
+
+    assert(recv_id < channel->recv_n);
+    assert(recv->nb_message);
 
     pok_preemption_disable();
 
-    channel->recv.next_message = channel_queuing_cyclic_add(channel,
-        channel->recv.next_message, 1);
+    recv->stats.nb_messages++;
+    recv->stats.nb_bytes += channel_queuing_message_size(channel,
+        channel_queuing_side_first(recv));
+
+    channel_queuing_slot_put(channel, channel_queuing_side_pop(recv));
 
-    if(channel->send.part->partition_generation == channel->send.generation
-        && channel->border != channel->send.next_message)
+    if(channel_queuing_side_is_ready(&channel->send))
     {
-        channel->border = channel_queuing_cyclic_add(channel,
-            channel->border, 1);
-        channel_queuing_side_notify(&channel->send,
-            JET_PARTITION_EVENT_TYPE_PORT_SEND_AVAILABLE);
+        channel_queuing_transmit(channel);
+
+        // With packed storage, sender may wait for the bytes in the ring.
+        if(channel->storage == JET_CHANNEL_QUEUING_STORAGE_PACKED)
+            channel_queuing_side_notify(&channel->send,
+                JET_PARTITION_EVENT_TYPE_PORT_SEND_AVAILABLE);
     }
 
-    *message_discarded = channel->message_discarded;
-    channel->message_discarded = FALSE;
+    *message_discarded = recv->message_discarded;
+    recv->message_discarded = FALSE;
     pok_preemption_enable();
 }
 
@@ -189,21 +558,29 @@ char* pok_channel_queuing_s_get_message(
     pok_channel_queuing_t* channel,
     pok_bool_t subscribe)
 {
-    pok_message_range_t n_used;
     char* message;
 
     pok_preemption_disable();
 
-    n_used = channel_queuing_cyclic_sub(channel,
-        channel->send.next_message, channel->border);
-
-    if(n_used < channel->send.max_nb_message)
+    if(channel->send.nb_message == channel->send.max_nb_message)
+    {
+        message = NULL;
+    }
+    else if(channel->storage == JET_CHANNEL_QUEUING_STORAGE_PACKED)
     {
-        message = channel_queuing_message_at(channel, channel->send.next_message);
+        message = channel_queuing_ring_reserve(channel)
+            ? channel_queuing_message_at(channel, channel->bytes_reserved)
+            : NULL;
     }
     else
     {
-        message = NULL;
+        // Free slot always exists in that case.
+        assert(channel->free_first < channel->max_nb_message);
+        message = channel_queuing_message_at(channel, channel->free_first);
+    }
+
+    if(message == NULL)
+    {
         if(subscribe)
             channel->send.is_notify = TRUE;
     }
@@ -217,58 +594,56 @@ void pok_channel_queuing_s_produce_message(
     pok_channel_queuing_t* channel,
     pok_message_size_t size)
 {
-    assert(channel_queuing_cyclic_sub(channel, channel->send.next_message,
-        channel->border) < channel->send.max_nb_message);
+    jet_channel_queuing_ref_t ref;
+
+    assert(channel->send.nb_message < channel->send.max_nb_message);
 
     assert(size > 0);
     assert(size <= channel->max_message_size);
 
     pok_preemption_disable();
 
-    channel->message_sizes[channel->send.next_message] = size;
-    channel->send.next_message = channel_queuing_cyclic_add(channel,
-        channel->send.next_message, 1);
-
-    if(channel->recv.part->partition_generation == channel->recv.generation)
+    if(channel->storage == JET_CHANNEL_QUEUING_STORAGE_PACKED)
     {
-        // Receiver is ready.
-        pok_message_range_t nb_message_receive = channel_queuing_cyclic_sub(
-            channel, channel->border, channel->recv.next_message);
-
-        if(nb_message_receive < channel->recv.max_nb_message)
-        {
-            // Move message to the receiver buffer
-            channel->border = channel->send.next_message;
-            // And notify receiver, if requested.
-            channel_queuing_side_notify(&channel->recv,
-                JET_PARTITION_EVENT_TYPE_PORT_RECEIVE_AVAILABLE);
-        }
-        else if(channel->overflow_strategy == JET_CHANNEL_QUEUING_RECEIVER_DISCARD)
-        {
-            /* Discard message and store note about that.*/
-            channel->send.next_message = channel->border;
-            channel->message_discarded = TRUE;
-        }
+        // Message has been filled in the reserved record.
+        ref = channel_queuing_ring_commit(channel, size);
     }
     else
     {
-        // Just drop the message and all previous ones which have been received.
-        channel->border = channel->send.next_message;
+        // Message has been filled in the first free slot.
+        ref = channel->free_first;
+        channel->free_first = channel->message_next_free[ref];
+
+        channel->message_sizes[ref] = size;
     }
 
+    channel_queuing_side_push(&channel->send, ref);
+
+    channel->send.stats.nb_messages++;
+    channel->send.stats.nb_bytes += size;
+
+    channel_queuing_transmit(channel);
+
     pok_preemption_enable();
 }
 
 pok_message_range_t pok_channel_queuing_s_n_messages(pok_channel_queuing_t* channel)
+{
+    // Reading single field is atomic.
+    return channel->send.nb_message;
+}
+
+void pok_channel_queuing_account_wait(struct pok_channel_queuing_side* side,
+    pok_time_t wait_time)
 {
     pok_preemption_disable();
 
-    pok_message_range_t n_messages = channel_queuing_cyclic_sub(channel,
-        channel->send.next_message, channel->border);
+    side->stats.nb_waits++;
+    side->stats.wait_time_total += wait_time;
+    if(wait_time > side->stats.wait_time_max)
+        side->stats.wait_time_max = wait_time;
 
     __pok_preemption_enable();
-
-    return n_messages;
 }
 
 /*********************** Sampling channel *****************************/
@@ -276,14 +651,33 @@ pok_message_range_t pok_channel_queuing_s_n_messages(pok_channel_queuing_t* chan
 void pok_channel_sampling_init(pok_channel_sampling_t* channel)
 {
     const unsigned int message_alignment = __alignof__(int);
+    uint8_t i;
+
+    assert(channel->recv_n > 0);
+
+    channel->nb_slots = channel->recv_n + 2;
 
     channel->message_stride = ALIGN_VAL(channel->max_message_size,
         message_alignment);
-    channel->messages = ja_mem_alloc_aligned(3 * channel->message_stride,
+    channel->messages = ja_mem_alloc_aligned(
+        channel->nb_slots * channel->message_stride,
         message_alignment);
+    channel->message_sizes = ja_mem_alloc_aligned(
+        channel->nb_slots * sizeof(*channel->message_sizes),
+        __alignof__(*channel->message_sizes));
+    channel->timestamps = ja_mem_alloc_aligned(
+        channel->nb_slots * sizeof(*channel->timestamps),
+        __alignof__(*channel->timestamps));
+
+    for(i = 0; i < channel->recv_n; i++)
+    {
+        channel->recv[i].read_pos = 0;
+        channel->recv[i].is_cleared = FALSE;
+        channel->recv[i].generation = 0;
+        channel->recv[i].is_notify = FALSE;
+    }
 
     channel->read_pos_next = 0;
-    channel->read_pos = 0;
 
     // Mark the first message as empty.
     channel->message_sizes[0] = 0;
@@ -291,14 +685,64 @@ void pok_channel_sampling_init(pok_channel_sampling_t* channel)
     channel->write_pos = 1;
 }
 
-char* channel_sampling_message_at(
+static char* channel_sampling_message_at(
     pok_channel_sampling_t* channel, int pos)
 {
-    assert(pos <= 2);
+    assert(pos < channel->nb_slots);
 
     return &channel->messages[pos * channel->message_stride];
 }
 
+/* 
+ * Helper: Find slot, which differs from every slot used for read.
+ * 
+ * Should be executed with global preemption disabled.
+ */
+static uint8_t channel_sampling_find_write_pos(pok_channel_sampling_t* channel)
+{
+    uint8_t pos;
+
+    /* 
+     * There are (recv_n + 2) slots, and at most (recv_n + 1) of them
+     * are used for read. So search always succeed.
+     */
+    for(pos = 0; pos < channel->nb_slots; pos++)
+    {
+        uint8_t i;
+
+        if(pos == channel->read_pos_next) continue;
+
+        for(i = 0; i < channel->recv_n; i++)
+        {
+            if(channel->recv[i].read_pos == pos) break;
+        }
+
+        if(i == channel->recv_n) return pos;
+    }
+
+    unreachable();
+}
+
+/* 
+ * Helper: Make the newest message current for the receiver.
+ * 
+ * Should be executed with global preemption disabled.
+ */
+static inline void channel_sampling_r_update(pok_channel_sampling_t* channel,
+    struct pok_channel_sampling_receiver* recv)
+{
+    if(recv->read_pos != channel->read_pos_next)
+    {
+        recv->read_pos = channel->read_pos_next;
+        recv->is_cleared = FALSE;
+
+        if(channel->message_sizes[recv->read_pos] != 0)
+        {
+            recv->stats.nb_messages++;
+            recv->stats.nb_bytes += channel->message_sizes[recv->read_pos];
+        }
+    }
+}
 
 /*
  * Get pointer to the message for read it.
@@ -312,41 +756,94 @@ char* channel_sampling_message_at(
  */
 const char* pok_channel_sampling_r_get_message(
     pok_channel_sampling_t* channel,
+    uint8_t recv_id,
     pok_message_size_t* size,
     pok_time_t* timestamp)
 {
+    struct pok_channel_sampling_receiver* recv = &channel->recv[recv_id];
     uint8_t read_pos;
+    pok_bool_t is_cleared;
+
+    assert(recv_id < channel->recv_n);
 
     pok_preemption_disable();
-    read_pos = channel->read_pos = channel->read_pos_next;
+    channel_sampling_r_update(channel, recv);
+    read_pos = recv->read_pos;
+    is_cleared = recv->is_cleared;
     __pok_preemption_enable();
 
+    if(is_cleared) return NULL;
+
     pok_message_size_t message_size = channel->message_sizes[read_pos];
     if(!message_size) return NULL;
 
     *size = message_size;
     *timestamp = channel->timestamps[read_pos];
 
-    return channel_sampling_message_at(channel, read_pos);;
+    return channel_sampling_message_at(channel, read_pos);
 }
 
-void pok_channel_sampling_r_clear_message(pok_channel_sampling_t* channel)
+void pok_channel_sampling_r_clear_message(pok_channel_sampling_t* channel,
+    uint8_t recv_id)
 {
+    assert(recv_id < channel->recv_n);
+
     pok_preemption_disable();
-    channel->message_sizes[channel->read_pos] = 0;
+    channel->recv[recv_id].is_cleared = TRUE;
     __pok_preemption_enable();
 }
 
-pok_bool_t pok_channel_sampling_r_check_new_message(pok_channel_sampling_t* channel)
+void pok_channel_sampling_r_init(pok_channel_sampling_t* channel,
+    uint8_t recv_id,
+    uint16_t handler_id)
 {
+    struct pok_channel_sampling_receiver* recv = &channel->recv[recv_id];
+
+    assert(recv_id < channel->recv_n);
+
+    pok_preemption_disable();
+    recv->is_cleared = TRUE;
+    recv->is_notify = FALSE;
+    recv->handler_id = handler_id;
+    recv->generation = recv->part->partition_generation;
+    __pok_preemption_enable();
+}
+
+pok_bool_t pok_channel_sampling_r_is_updated(
+    pok_channel_sampling_t* channel,
+    uint8_t recv_id,
+    pok_bool_t subscribe)
+{
+    struct pok_channel_sampling_receiver* recv = &channel->recv[recv_id];
+    pok_bool_t ret;
+
+    assert(recv_id < channel->recv_n);
+
+    pok_preemption_disable();
+    ret = (recv->read_pos != channel->read_pos_next)
+        && (channel->message_sizes[channel->read_pos_next] != 0);
+    if(!ret && subscribe)
+        recv->is_notify = TRUE;
+    __pok_preemption_enable();
+
+    return ret;
+}
+
+pok_bool_t pok_channel_sampling_r_check_new_message(
+    pok_channel_sampling_t* channel,
+    uint8_t recv_id)
+{
+    struct pok_channel_sampling_receiver* recv = &channel->recv[recv_id];
     pok_bool_t ret = FALSE;
 
+    assert(recv_id < channel->recv_n);
+
     pok_preemption_disable();
-    if(channel->read_pos != channel->read_pos_next)
+    if(recv->read_pos != channel->read_pos_next)
     {
         ret = TRUE;
         // TODO: This mark message as consumed. Do we need that?
-        channel->read_pos = channel->read_pos_next;
+        channel_sampling_r_update(channel, recv);
     }
     __pok_preemption_enable();
 
@@ -364,28 +861,74 @@ void pok_channel_sampling_send_message(
     pok_message_size_t size)
 {
     uint8_t read_pos_next;
+    uint8_t i;
 
     assert(size);
 
     pok_preemption_disable();
+
+    channel->send_stats.nb_messages++;
+    channel->send_stats.nb_bytes += size;
+    if(channel->message_sizes[channel->read_pos_next] != 0)
+    {
+        // Receivers which haven't fetched previous message will lose it.
+        for(i = 0; i < channel->recv_n; i++)
+        {
+            if(channel->recv[i].read_pos != channel->read_pos_next)
+                channel->recv[i].stats.nb_discarded++;
+        }
+    }
+
     channel->read_pos_next = read_pos_next = channel->write_pos;
     channel->timestamps[read_pos_next] = jet_system_time();
     channel->message_sizes[read_pos_next] = size;
 
-    /*
-     * The only choice for `write_pos`, which can differ from both
-     * `read_pos` and `read_pos_next`.
-     * 
-     * (read_pos + read_pos_next + write_pos = 0 + 1 + 2 = 3).
-     */
-    channel->write_pos = 3 - channel->read_pos - read_pos_next;
+    channel->write_pos = channel_sampling_find_write_pos(channel);
+
+    for(i = 0; i < channel->recv_n; i++)
+    {
+        struct pok_channel_sampling_receiver* recv = &channel->recv[i];
+
+        if(recv->is_notify)
+        {
+            recv->is_notify = FALSE;
+            // Do not notify partition which has been restarted since subscription.
+            if(recv->part->partition_generation == recv->generation)
+                pok_partition_add_event(recv->part,
+                    JET_PARTITION_EVENT_TYPE_PORT_SAMPLING_UPDATED,
+                    recv->handler_id);
+        }
+    }
     __pok_preemption_enable();
 }
 
 void pok_channel_sampling_s_clear_message(pok_channel_sampling_t* channel)
 {
+    uint8_t read_pos;
+    uint8_t i;
+
     pok_preemption_disable();
-    channel->read_pos_next = channel->read_pos;
+
+    read_pos = channel->recv[0].read_pos;
+
+    for(i = 1; i < channel->recv_n; i++)
+    {
+        if(channel->recv[i].read_pos != read_pos) break;
+    }
+
+    if(i == channel->recv_n)
+    {
+        // Revert to the message which every receiver already has.
+        channel->read_pos_next = read_pos;
+    }
+    else
+    {
+        // Receivers have different messages. Publish empty one.
+        channel->read_pos_next = channel->write_pos;
+        channel->message_sizes[channel->write_pos] = 0;
+        channel->write_pos = channel_sampling_find_write_pos(channel);
+    }
+
     __pok_preemption_enable();
 }
 
@@ -404,3 +947,163 @@ void pok_channels_init_all(void)
         pok_channel_sampling_init(&pok_channels_sampling[i]);
     }
 }
+
+/************************** Statistics ********************************/
+void pok_channels_print_stats(void)
+{
+    int i;
+    int j;
+
+    printf("kind     chan side  max  high        msgs       bytes  discard"
+        "  waits  wait_max\n");
+
+    for(i = 0; i < pok_channels_queuing_n; i++)
+    {
+        pok_channel_queuing_t* channel = &pok_channels_queuing[i];
+
+        for(j = 0; j <= channel->recv_n; j++)
+        {
+            // Side 0 is the sender, others are receivers.
+            struct pok_channel_queuing_side* side = (j == 0)
+                ? &channel->send : &channel->recv[j - 1];
+
+            printf("queuing  %4d %4d %4u %5u %11lu %11llu %8lu %6lu %9lld\n",
+                i, j,
+                (unsigned)side->max_nb_message,
+                (unsigned)side->stats.nb_message_max,
+                (unsigned long)side->stats.nb_messages,
+                (unsigned long long)side->stats.nb_bytes,
+                (unsigned long)side->stats.nb_discarded,
+                (unsigned long)side->stats.nb_waits,
+                (long long)side->stats.wait_time_max);
+        }
+    }
+
+    for(i = 0; i < pok_channels_sampling_n; i++)
+    {
+        pok_channel_sampling_t* channel = &pok_channels_sampling[i];
+
+        for(j = 0; j <= channel->recv_n; j++)
+        {
+            const pok_port_stats_t* stats = (j == 0)
+                ? &channel->send_stats : &channel->recv[j - 1].stats;
+
+            printf("sampling %4d %4d %4u %5u %11lu %11llu %8lu %6lu %9lld\n",
+                i, j, 1, 1,
+                (unsigned long)stats->nb_messages,
+                (unsigned long long)stats->nb_bytes,
+                (unsigned long)stats->nb_discarded,
+                0UL, 0LL);
+        }
+    }
+}
+
+/* Magic of the binary statistics dump ("JCST"). */
+#define CHANNELS_STATS_MAGIC 0x5453434aUL
+#define CHANNELS_STATS_VERSION 1
+/* Size of one record in the binary dump. */
+#define CHANNELS_STATS_RECORD_SIZE 48
+
+#define CHANNELS_STATS_KIND_QUEUING 1
+#define CHANNELS_STATS_KIND_SAMPLING 2
+
+/* Helper: Store value into the buffer in little-endian order. */
+static uint8_t* channels_stats_put(uint8_t* buf, uint64_t value, int size)
+{
+    int i;
+
+    for(i = 0; i < size; i++)
+    {
+        buf[i] = (uint8_t)value;
+        value >>= 8;
+    }
+
+    return buf + size;
+}
+
+/* Helper: Print buffer as one line of the dump. */
+static void channels_stats_print_line(const uint8_t* buf, int size)
+{
+    int i;
+
+    printf("[CHANNELS] ");
+    for(i = 0; i < size; i++)
+        printf("%02x", (unsigned)buf[i]);
+    printf("\n");
+}
+
+/* Helper: Print one record of the dump. */
+static void channels_stats_print_record(uint8_t kind, int channel_index,
+    int side_index, pok_message_range_t max_nb_message,
+    pok_message_range_t nb_message_max, const pok_port_stats_t* stats)
+{
+    uint8_t buf[CHANNELS_STATS_RECORD_SIZE];
+    uint8_t* p = buf;
+
+    p = channels_stats_put(p, kind, 1);
+    // Side index is at most 255: there are no more than 255 receivers.
+    p = channels_stats_put(p, side_index, 1);
+    p = channels_stats_put(p, channel_index, 2);
+    p = channels_stats_put(p, max_nb_message, 4);
+    p = channels_stats_put(p, nb_message_max, 4);
+    p = channels_stats_put(p, stats->nb_messages, 4);
+    p = channels_stats_put(p, stats->nb_discarded, 4);
+    p = channels_stats_put(p, stats->nb_waits, 4);
+    p = channels_stats_put(p, stats->nb_bytes, 8);
+    p = channels_stats_put(p, stats->wait_time_total, 8);
+    p = channels_stats_put(p, stats->wait_time_max, 8);
+
+    assert(p == buf + CHANNELS_STATS_RECORD_SIZE);
+
+    channels_stats_print_line(buf, CHANNELS_STATS_RECORD_SIZE);
+}
+
+void pok_channels_dump_stats(void)
+{
+    uint8_t header[12];
+    uint8_t* p = header;
+    uint32_t nb_records = 0;
+    int i;
+    int j;
+
+    for(i = 0; i < pok_channels_queuing_n; i++)
+        nb_records += pok_channels_queuing[i].recv_n + 1;
+    for(i = 0; i < pok_channels_sampling_n; i++)
+        nb_records += pok_channels_sampling[i].recv_n + 1;
+
+    p = channels_stats_put(p, CHANNELS_STATS_MAGIC, 4);
+    p = channels_stats_put(p, CHANNELS_STATS_VERSION, 2);
+    p = channels_stats_put(p, CHANNELS_STATS_RECORD_SIZE, 2);
+    p = channels_stats_put(p, nb_records, 4);
+
+    channels_stats_print_line(header, sizeof(header));
+
+    for(i = 0; i < pok_channels_queuing_n; i++)
+    {
+        pok_channel_queuing_t* channel = &pok_channels_queuing[i];
+
+        for(j = 0; j <= channel->recv_n; j++)
+        {
+            struct pok_channel_queuing_side* side = (j == 0)
+                ? &channel->send : &channel->recv[j - 1];
+
+            channels_stats_print_record(CHANNELS_STATS_KIND_QUEUING, i, j,
+                side->max_nb_message, side->stats.nb_message_max,
+                &side->stats);
+        }
+    }
+
+    for(i = 0; i < pok_channels_sampling_n; i++)
+    {
+        pok_channel_sampling_t* channel = &pok_channels_sampling[i];
+
+        for(j = 0; j <= channel->recv_n; j++)
+        {
+            const pok_port_stats_t* stats = (j == 0)
+                ? &channel->send_stats : &channel->recv[j - 1].stats;
+
+            channels_stats_print_record(CHANNELS_STATS_KIND_SAMPLING, i, j,
+                1, 1, stats);
+        }
+    }
+}
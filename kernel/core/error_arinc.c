@@ -51,6 +51,7 @@ const char* error_thread_name = "Error_Handler";
 pok_ret_t pok_error_thread_create (uint32_t stack_size, void* __user entry)
 {
     pok_thread_t* t;
+    pok_thread_cold_t* t_cold;
     pok_partition_arinc_t* part = current_partition_arinc;
 
     /**
@@ -74,14 +75,15 @@ pok_ret_t pok_error_thread_create (uint32_t stack_size, void* __user entry)
 
 
     t = &part->threads[part->nthreads_used];
+    t_cold = pok_thread_cold(part, t);
 
-    strncpy(t->name, error_thread_name, MAX_NAME_LENGTH);
-    t->entry = entry;
+    strncpy(t_cold->name, error_thread_name, MAX_NAME_LENGTH);
+    t_cold->entry = entry;
     t->base_priority = ERROR_THREAD_PRIORITY;
-    t->period = POK_TIME_INFINITY;
-    t->time_capacity = POK_TIME_INFINITY; // TODO: support deadline for error handler
-    t->deadline = DEADLINE_SOFT;
-    t->user_stack_size = stack_size;
+    t_cold->period = POK_TIME_INFINITY;
+    t_cold->time_capacity = POK_TIME_INFINITY; // TODO: support deadline for error handler
+    t_cold->deadline = DEADLINE_SOFT;
+    t_cold->user_stack_size = stack_size;
 
     if(!thread_create(t))
        return POK_ERRNO_UNAVAILABLE;
@@ -340,8 +342,10 @@ pok_ret_t pok_error_raise_application_error (const char* __user msg, size_t msg_
     assert(part->thread_error);
     assert(part->thread_current != part->thread_error);
 
-    thread->wait_buffer.src = k_msg;
-    thread->wait_len = msg_size;
+    pok_thread_cold_t* thread_cold = pok_thread_cold(part, thread);
+
+    thread_cold->wait_buffer.src = k_msg;
+    thread_cold->wait_len = msg_size;
 
     pok_preemption_local_disable();
 
@@ -442,9 +446,11 @@ pok_ret_t pok_error_get (pok_error_status_t* __user status,
 
          if(part->sync_error == POK_ERROR_ID_APPLICATION_ERROR)
          {
-             k_status->msg_size = thread->wait_len;
+             pok_thread_cold_t* thread_cold = pok_thread_cold(part, thread);
+
+             k_status->msg_size = thread_cold->wait_len;
              k_status->error_kind = get_error_kind(POK_ERROR_ID_APPLICATION_ERROR);
-             memcpy(k_msg, thread->wait_buffer.src, thread->wait_len);
+             memcpy(k_msg, thread_cold->wait_buffer.src, thread_cold->wait_len);
          }
          else
          {
@@ -41,18 +41,51 @@
 #include <core/space.h>
 
 #include <core/loader.h>
+#include <core/lz4.h>
 
 extern size_t pok_elf_sizes[];
-extern char __archive2_begin;
+/* Compression method for every elf. Generated with sizes. */
+extern uint8_t pok_elf_compression[];
+extern char __archive2_begin[];
 
-/**
+/* Values for 'pok_elf_compression'. Should be synchronized with misc/elf_compress.py. */
+#define LOADER_COMPRESSION_NONE 0
+#define LOADER_COMPRESSION_LZ4  1
+
+/*
+ * Fill the segment's content with its pristine data and zero the rest.
+ *
+ * Compressed data are decompressed directly into the space.
+ */
+static void loader_segment_fill(const struct jet_loader_segment* segment)
+{
+    if(segment->is_compressed)
+    {
+        if(!jet_lz4_decompress(segment->kernel_dest, segment->filesz,
+            segment->src, segment->src_size))
+        {
+            printf("Partition's ELF has corrupted compressed segment.\n");
+            pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+        }
+    }
+    else
+    {
+        memcpy(segment->kernel_dest, segment->src, segment->filesz);
+    }
+
+    memset(segment->kernel_dest + segment->filesz, 0,
+        segment->memsz - segment->filesz);
+}
+
+/*
  * Load an ELF file.
  *
- *  @param file
+ * If 'image' is not NULL, fill it.
  */
-void jet_loader_elf_load   (uint8_t elf_id,
-                                 jet_space_id space_id,
-                                 void (** entry)(void))
+static void loader_elf_load_common(uint8_t elf_id,
+                                   jet_space_id space_id,
+                                   void (** entry)(void),
+                                   struct jet_loader_image* image)
 {
     size_t elf_offset, elf_size;
 
@@ -73,7 +106,24 @@ void jet_loader_elf_load   (uint8_t elf_id,
          pok_raise_error(POK_ERROR_ID_CONFIG_ERROR, FALSE, NULL);
     }
 
-    const char* elf_start = &__archive2_begin + elf_offset;
+    const char* elf_start = __archive2_begin + elf_offset;
+
+    pok_bool_t is_compressed;
+
+    switch(pok_elf_compression[elf_id])
+    {
+    case LOADER_COMPRESSION_NONE:
+        is_compressed = FALSE;
+        break;
+    case LOADER_COMPRESSION_LZ4:
+        is_compressed = TRUE;
+        break;
+    default:
+        printf("Partition's ELF has unknown compression method %u.\n",
+            (unsigned)pok_elf_compression[elf_id]);
+        pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+        unreachable();
+    }
 
     Elf32_Ehdr*  elf_header;
     Elf32_Phdr*  elf_phdr;
@@ -133,6 +183,13 @@ void jet_loader_elf_load   (uint8_t elf_id,
        pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
     }
 
+    if(image)
+    {
+        image->is_valid = FALSE;
+        image->entry = *entry;
+        image->nsegments = 0;
+    }
+
     for (int i = 0; i < elf_header->e_phnum; ++i)
     {
         char* user_dest = (char *)elf_phdr[i].p_vaddr;
@@ -145,9 +202,73 @@ void jet_loader_elf_load   (uint8_t elf_id,
 
         char* kernel_dest = space_layout.kernel_addr + (user_dest - space_layout.user_addr);
 
-        memcpy (kernel_dest, elf_phdr[i].p_offset + elf_start, filesz);
-        memset (kernel_dest + filesz, 0, memsz - filesz);
+        if(elf_phdr[i].p_offset > elf_size
+            || (!is_compressed && filesz > elf_size - elf_phdr[i].p_offset))
+        {
+           printf("Partition's ELF has segment outside of the file.\n");
+           pok_raise_error(POK_ERROR_ID_PARTLOAD_ERROR, FALSE, NULL);
+        }
+
+        struct jet_loader_segment segment = {
+            .kernel_dest = kernel_dest,
+            .src = elf_phdr[i].p_offset + elf_start,
+            // Compressed data may be up to the end of the file.
+            .src_size = is_compressed ? elf_size - elf_phdr[i].p_offset : filesz,
+            .filesz = filesz,
+            .memsz = memsz,
+            .is_writable = (elf_phdr[i].p_flags & PF_W) ? TRUE : FALSE,
+            .is_compressed = is_compressed
+        };
+
+        loader_segment_fill(&segment);
+
+        if(image && memsz != 0)
+        {
+            if(image->nsegments == JET_LOADER_IMAGE_MAX_SEGMENTS)
+            {
+                // Image will be left invalid.
+                image = NULL;
+                continue;
+            }
+
+            image->segments[image->nsegments++] = segment;
+        }
    }
+
+   if(image) image->is_valid = TRUE;
+}
+
+void jet_loader_elf_load   (uint8_t elf_id,
+                                 jet_space_id space_id,
+                                 void (** entry)(void))
+{
+    loader_elf_load_common(elf_id, space_id, entry, NULL);
+}
+
+void jet_loader_elf_load_image(uint8_t elf_id,
+                               jet_space_id space_id,
+                               struct jet_loader_image* image)
+{
+    void (*entry)(void);
+
+    loader_elf_load_common(elf_id, space_id, &entry, image);
+
+    // Entry should be available even when image is invalid.
+    image->entry = entry;
+}
+
+void jet_loader_image_restore(const struct jet_loader_image* image)
+{
+    assert(image->is_valid);
+
+    for (int i = 0; i < image->nsegments; i++)
+    {
+        const struct jet_loader_segment* segment = &image->segments[i];
+
+        if(!segment->is_writable) continue;
+
+        loader_segment_fill(segment);
+    }
 }
 
 #endif /* POK_NEEDS_PARTITIONS */
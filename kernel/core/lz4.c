@@ -0,0 +1,102 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Decompressor for LZ4 block format.
+ *
+ * Block is a sequence of
+ *
+ *   [token][literal length...][literals][offset][match length...]
+ *
+ * where high 4 bits of token is a literal length and low 4 bits is
+ * a match length minus 4. Value 15 means that length is continued
+ * with following bytes, until byte other than 255. Last sequence
+ * contains literals only.
+ *
+ * Compressor is misc/elf_compress.py.
+ */
+
+#include <core/lz4.h>
+#include <libc.h>
+
+#define LZ4_MIN_MATCH 4
+
+/*
+ * Read continuation of the length.
+ *
+ * Returns FALSE if input ends.
+ */
+static pok_bool_t lz4_read_length(const uint8_t** ip, const uint8_t* iend,
+    size_t* length)
+{
+    uint8_t b;
+
+    do {
+        if(*ip == iend) return FALSE;
+        b = *(*ip)++;
+        *length += b;
+    } while(b == 255);
+
+    return TRUE;
+}
+
+pok_bool_t jet_lz4_decompress(char* dest, size_t dest_size,
+    const char* src, size_t src_size)
+{
+    const uint8_t* ip = (const uint8_t*)src;
+    const uint8_t* iend = ip + src_size;
+    uint8_t* op = (uint8_t*)dest;
+    uint8_t* oend = op + dest_size;
+
+    while(op < oend) {
+        uint8_t token;
+        size_t length;
+        size_t offset;
+        const uint8_t* match;
+
+        if(ip == iend) return FALSE;
+        token = *ip++;
+
+        length = token >> 4;
+        if(length == 15 && !lz4_read_length(&ip, iend, &length)) return FALSE;
+
+        if(length > (size_t)(iend - ip) || length > (size_t)(oend - op))
+            return FALSE;
+
+        memcpy(op, ip, length);
+        op += length;
+        ip += length;
+
+        if(op == oend) break; // Last sequence has no match.
+
+        if(iend - ip < 2) return FALSE;
+        offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        if(offset == 0 || offset > (size_t)(op - (uint8_t*)dest)) return FALSE;
+
+        length = token & 0xf;
+        if(length == 15 && !lz4_read_length(&ip, iend, &length)) return FALSE;
+        length += LZ4_MIN_MATCH;
+
+        if(length > (size_t)(oend - op)) return FALSE;
+
+        // Match may overlap with output, so copy byte by byte.
+        match = op - offset;
+        while(length--) *op++ = *match++;
+    }
+
+    return TRUE;
+}
@@ -21,11 +21,13 @@
 #include <common.h>
 #include <asp/arch.h>
 #include <core/uaccess.h>
+#include <core/time.h>
 #include <system_limits.h>
 
 #include <cswitch.h>
 #include <core/loader.h>
 #include <alloc.h>
+#include <libc.h>
 
 
 /*
@@ -57,9 +59,9 @@ void pok_partition_arinc_idle(void)
 /*
  * Reset thread object as it is not used.
  */
-static void thread_reset(pok_thread_t* t)
+static void thread_reset(pok_partition_arinc_t* part, pok_thread_t* t)
 {
-    t->name[0] = '\0';
+    pok_thread_cold(part, t)->name[0] = '\0';
     // Everything else will be set at thread creation time.
 }
 
@@ -69,9 +71,13 @@ static void thread_reset(pok_thread_t* t)
  * 
  * Executed once during partition initialization.
  */
-static void thread_init(pok_thread_t* t)
+static void thread_init(pok_partition_arinc_t* part, pok_thread_t* t)
 {
-    t->initial_sp = pok_stack_alloc(KERNEL_STACK_SIZE_DEFAULT);
+    if(t - part->threads < part->kernel_stacks_n)
+        thread_kernel_stack_alloc(part, t);
+    else
+        t->initial_sp = 0;
+
     t->fp_store = ja_alloc_fp_store();
 }
 
@@ -89,9 +95,22 @@ static void partition_arinc_start(void)
 		part->mode = POK_PARTITION_MODE_INIT_COLD;
 	}
 
-	jet_loader_elf_load(part->base_part.space_id - 1, /* elf_id*/
-		part->base_part.space_id,
-		&part->main_entry);
+	pok_time_t load_start = jet_system_time();
+
+	if(part->restart_image.is_valid)
+	{
+		// Restart: elf is already parsed, reload only writable data.
+		jet_loader_image_restore(&part->restart_image);
+	}
+	else
+	{
+		jet_loader_elf_load_image(part->base_part.space_id - 1, /* elf_id*/
+			part->base_part.space_id,
+			&part->restart_image);
+	}
+
+	part->main_entry = part->restart_image.entry;
+	part->load_duration = jet_system_time() - load_start;
 
 	part->kshd = ja_space_shared_data(part->base_part.space_id);
 
@@ -107,6 +126,9 @@ static void partition_arinc_start(void)
        part->kshd->heap_start = NULL;
        part->kshd->heap_end = NULL;
     }
+    part->kshd->heap_used = 0;
+    part->kshd->intra_used = 0;
+    part->kshd->intra_size = 0;
 
 	for(int i = 0; i < part->nports_queuing; i++)
 	{
@@ -122,10 +144,11 @@ static void partition_arinc_start(void)
 
 	INIT_LIST_HEAD(&part->eligible_threads);
 	delayed_event_queue_init(&part->partition_delayed_events);
+	pok_thread_wq_init(&part->wait_any_waiters);
 
 	for(int i = 0; i < part->nthreads; i++)
 	{
-		thread_reset(&part->threads[i]);
+		thread_reset(part, &part->threads[i]);
 	}
 
 	part->nthreads_used = 0;
@@ -137,14 +160,15 @@ static void partition_arinc_start(void)
 #endif
 
     pok_thread_t* thread_main = &part->threads[POK_PARTITION_ARINC_MAIN_THREAD_ID];
+    pok_thread_cold_t* thread_main_cold = pok_thread_cold(part, thread_main);
 
-	thread_main->entry = (void* __user)part->main_entry;
+	thread_main_cold->entry = (void* __user)part->main_entry;
 	thread_main->base_priority = 0;
-	thread_main->period = POK_TIME_INFINITY;
-	thread_main->time_capacity = POK_TIME_INFINITY;
-	thread_main->deadline = DEADLINE_SOFT;
-	strncpy(thread_main->name, main_thread_name, MAX_NAME_LENGTH);
-	thread_main->user_stack_size = part->main_user_stack_size;
+	thread_main_cold->period = POK_TIME_INFINITY;
+	thread_main_cold->time_capacity = POK_TIME_INFINITY;
+	thread_main_cold->deadline = DEADLINE_SOFT;
+	strncpy(thread_main_cold->name, main_thread_name, MAX_NAME_LENGTH);
+	thread_main_cold->user_stack_size = part->main_user_stack_size;
 
     if(!thread_create(thread_main)) unreachable(); // Configurator should check stack size for main thread.
 
@@ -154,6 +178,9 @@ static void partition_arinc_start(void)
 	part->kshd->current_thread_id = JET_THREAD_ID_NONE;
 	part->kshd->max_n_threads = part->nthreads;
 	part->kshd->partition_mode = part->mode;
+	part->kshd->wait_any_pending = FALSE;
+	part->kshd->time.seq = 0;
+	jet_time_publish(part->base_part.space_id);
 
 	sched_arinc_start();
 
@@ -231,11 +258,11 @@ static void pok_sched_arinc_get_thread_info(pok_partition_t* part, int index, vo
 	else if(index == POK_PARTITION_ARINC_MAIN_THREAD_ID)
 	{
 		// Main thread. Currently do not bother with its state
-		WRITE_STR(t->name);
+		WRITE_STR(pok_thread_cold(part_arinc, t)->name);
 	}
 	else if(index < part_arinc->nthreads_used)
 	{
-		WRITE_STR(t->name);
+		WRITE_STR(pok_thread_cold(part_arinc, t)->name);
 		// Write state of the thread
 		WRITE_STR(" ");
 		switch(t->state)
@@ -308,11 +335,20 @@ void pok_partition_arinc_init(pok_partition_arinc_t* part)
 {
 	pok_partition_init(&part->base_part);
 
+	part->restart_image.is_valid = FALSE;
+	part->load_duration = 0;
+
+	if(part->kernel_stack_size == 0)
+		part->kernel_stack_size = KERNEL_STACK_SIZE_DEFAULT;
+
+	if(part->kernel_stacks_n == 0 || part->kernel_stacks_n > part->nthreads)
+		part->kernel_stacks_n = part->nthreads;
+
 	part->base_part.initial_sp = pok_stack_alloc(DEFAULT_STACK_SIZE);
 
 	for(int i = 0; i < part->nthreads; i++)
 	{
-		thread_init(&part->threads[i]);
+		thread_init(part, &part->threads[i]);
 	}
 
 	part->base_part.part_ops = &arinc_ops;
@@ -346,6 +382,7 @@ static void partition_set_mode_normal(void)
 	for(int i = POK_PARTITION_ARINC_MAIN_THREAD_ID + 1; i < part->nthreads_used; i++)
 	{
 		pok_thread_t* t = &part->threads[i];
+		pok_thread_cold_t* t_cold = pok_thread_cold(part, t);
 		pok_time_t thread_start_time;
 
 		if(t->state == POK_STATE_STOPPED) continue;
@@ -355,17 +392,17 @@ static void partition_set_mode_normal(void)
 		 * NORMAL mode switch.
 		 */
 
-		if(pok_time_is_infinity(t->period))
+		if(pok_time_is_infinity(t_cold->period))
 		{
 			// Aperiodic process.
-			thread_start_time = current_time + t->delayed_time;
+			thread_start_time = current_time + t_cold->delayed_time;
 		}
 		else
 		{
 			// Periodic process
 			if(pok_time_is_infinity(periodic_release_point))
 				periodic_release_point = get_next_periodic_processing_start();
-			thread_start_time = periodic_release_point + t->delayed_time;
+			thread_start_time = periodic_release_point + t_cold->delayed_time;
 		}
 
 		if(thread_start_time <= current_time)
@@ -373,9 +410,9 @@ static void partition_set_mode_normal(void)
 		else
 			thread_delay_event(t, thread_start_time, &thread_wake_up);
 
-		if(!pok_time_is_infinity(t->time_capacity))
+		if(!pok_time_is_infinity(t_cold->time_capacity))
 		{
-			thread_set_deadline(t, thread_start_time + t->time_capacity);
+			thread_set_deadline(t, thread_start_time + t_cold->time_capacity);
 		}
 	}
 }
@@ -517,3 +554,54 @@ void pok_partition_arinc_init_all(void)
 #endif
 	}
 }
+
+void pok_partitions_arinc_dump_memory(void)
+{
+    /*
+     * Format of lines is parsed by misc/footprint.py:
+     *
+     *   [MEMORY] partition <index> <name> heap <size> <used> intra <size> <used>
+     *   [MEMORY] thread <partition index> <thread index> <name> user_stack <size> <used> kernel_stack <size> <used>
+     *
+     * Usage of stacks is known only if they are painted
+     * (POK_NEEDS_STACK_USAGE); otherwise '-' is printed instead.
+     */
+    pok_preemption_disable();
+
+    for(int i = 0; i < pok_partitions_arinc_n; i++)
+    {
+        pok_partition_arinc_t* part = &pok_partitions_arinc[i];
+
+        // Partition has never been started.
+        if(part->kshd == NULL) continue;
+
+        printf("[MEMORY] partition %d %s heap %lu %lu intra %lu %lu\n",
+            i, part->base_part.name,
+            (unsigned long)part->heap_size,
+            (unsigned long)part->kshd->heap_used,
+            (unsigned long)part->kshd->intra_size,
+            (unsigned long)part->kshd->intra_used);
+
+        for(uint32_t j = 0; j < part->nthreads_used; j++)
+        {
+            pok_thread_t* t = &part->threads[j];
+            pok_thread_cold_t* t_cold = pok_thread_cold(part, t);
+
+#ifdef POK_NEEDS_STACK_USAGE
+            printf("[MEMORY] thread %d %u %s user_stack %lu %lu kernel_stack %lu %lu\n",
+                i, (unsigned)j, t_cold->name,
+                (unsigned long)t_cold->user_stack_size,
+                (unsigned long)thread_user_stack_used(part, t),
+                (unsigned long)part->kernel_stack_size,
+                (unsigned long)thread_kernel_stack_used(part, t));
+#else
+            printf("[MEMORY] thread %d %u %s user_stack %lu - kernel_stack %lu -\n",
+                i, (unsigned)j, t_cold->name,
+                (unsigned long)t_cold->user_stack_size,
+                (unsigned long)part->kernel_stack_size);
+#endif
+        }
+    }
+
+    pok_preemption_enable();
+}
@@ -68,27 +68,31 @@ void port_queuing_receive(pok_port_queuing_t* port, pok_thread_t* t)
 {
     pok_message_size_t message_size;
     const char* message = pok_channel_queuing_r_get_message(
-        port->channel, &message_size, FALSE);
+        port->channel, port->receiver_id, &message_size, FALSE);
+
+    pok_thread_cold_t* t_cold = pok_thread_cold(current_partition_arinc, t);
 
     assert(message);
 
-    memcpy(t->wait_buffer.dest, message, message_size);
-    t->wait_len = message_size;
+    memcpy(t_cold->wait_buffer.dest, message, message_size);
+    t_cold->wait_len = message_size;
 
     pok_bool_t message_discarded;
-    pok_channel_queuing_r_consume_message(port->channel, &message_discarded);
+    pok_channel_queuing_r_consume_message(port->channel, port->receiver_id,
+        &message_discarded);
 
     t->wait_result = message_discarded? POK_ERRNO_TOOMANY : POK_ERRNO_OK;
 }
 
 void port_queuing_send(pok_port_queuing_t* port, pok_thread_t* t)
 {
+    pok_thread_cold_t* t_cold = pok_thread_cold(current_partition_arinc, t);
     char* message = pok_channel_queuing_s_get_message(port->channel, FALSE);
     assert(message);
 
-    memcpy(message, t->wait_buffer.src, t->wait_len);
+    memcpy(message, t_cold->wait_buffer.src, t_cold->wait_len);
 
-    pok_channel_queuing_s_produce_message(port->channel, t->wait_len);
+    pok_channel_queuing_s_produce_message(port->channel, t_cold->wait_len);
 
     t->wait_result = POK_ERRNO_OK;
 }
@@ -130,7 +134,7 @@ pok_ret_t pok_port_queuing_create(
 
     if(direction == POK_PORT_DIRECTION_IN)
     {
-        if(max_nb_message != port_queuing->channel->recv.max_nb_message)
+        if(max_nb_message != port_queuing->channel->recv[port_queuing->receiver_id].max_nb_message)
             return POK_ERRNO_EINVAL;
     }
     else // (direction == POK_PORT_DIRECTION_OUT)
@@ -148,7 +152,7 @@ pok_ret_t pok_port_queuing_create(
 
     if(direction == POK_PORT_DIRECTION_IN) {
         pok_channel_queuing_side_init(port_queuing->channel,
-            &port_queuing->channel->recv,
+            &port_queuing->channel->recv[port_queuing->receiver_id],
             port_queuing - current_partition_arinc->ports_queuing);
     }
     else {
@@ -191,6 +195,7 @@ pok_ret_t pok_port_queuing_receive(
     pok_port_queuing_t* port_queuing;
     pok_ret_t ret;
     pok_thread_t* t;
+    pok_thread_cold_t* t_cold;
 
     port_queuing = get_port_queuing(id);
     if(!port_queuing) return POK_ERRNO_PORT;
@@ -211,6 +216,7 @@ pok_ret_t pok_port_queuing_receive(
     pok_preemption_local_disable();
 
     t = current_thread;
+    t_cold = pok_thread_cold(current_partition_arinc, t);
 
     /*
      * We need to specify notification flag when trying get message
@@ -235,6 +241,7 @@ pok_ret_t pok_port_queuing_receive(
     pok_message_size_t message_size; // Only for call r_get_message().
     if(!pok_thread_wq_is_empty(&port_queuing->waiters) ||
         !pok_channel_queuing_r_get_message(port_queuing->channel,
+            port_queuing->receiver_id,
             &message_size,
             ret == POK_ERRNO_OK))
     {
@@ -246,7 +253,8 @@ pok_ret_t pok_port_queuing_receive(
         }
 
         // Prepare to wait.
-        t->wait_buffer.dest = k_data;
+        t_cold->wait_buffer.dest = k_data;
+        t_cold->wait_start = jet_system_time();
 
         pok_thread_wq_add_common(&port_queuing->waiters, t,
             port_queuing->discipline);
@@ -257,14 +265,14 @@ pok_ret_t pok_port_queuing_receive(
     }
 
     /* Message is ready in the buffer. */
-    t->wait_buffer.dest = k_data;
+    t_cold->wait_buffer.dest = k_data;
     port_queuing_receive(port_queuing, t);
 
 out:
     pok_preemption_local_enable(); // Possible wait here
 
     *k_len = (t->wait_result == POK_ERRNO_OK || t->wait_result == POK_ERRNO_TOOMANY)?
-        t->wait_len: // Success.
+        t_cold->wait_len: // Success.
         0; // Fail
 
     return t->wait_result;
@@ -286,6 +294,7 @@ pok_ret_t pok_port_queuing_send(
     pok_port_queuing_t* port_queuing;
     pok_ret_t ret;
     pok_thread_t* t = current_thread;
+    pok_thread_cold_t* t_cold = pok_thread_cold(current_partition_arinc, t);
 
     port_queuing = get_port_queuing(id);
 
@@ -340,8 +349,9 @@ pok_ret_t pok_port_queuing_send(
         }
 
         // Prepare to wait.
-        t->wait_len = len;
-        t->wait_buffer.src = k_data;
+        t_cold->wait_len = len;
+        t_cold->wait_buffer.src = k_data;
+        t_cold->wait_start = jet_system_time();
 
         pok_thread_wq_add_common(&port_queuing->waiters, t,
             port_queuing->discipline);
@@ -351,8 +361,8 @@ pok_ret_t pok_port_queuing_send(
         goto out;
     }
     /* There is place for message in the buffer. */
-    t->wait_len = len;
-    t->wait_buffer.src = k_data;
+    t_cold->wait_len = len;
+    t_cold->wait_buffer.src = k_data;
 
     port_queuing_send(port_queuing, t);
 
@@ -391,8 +401,9 @@ pok_ret_t pok_port_queuing_status(
     k_status->waiting_processes = pok_thread_wq_get_nwaits(&port_queuing->waiters);
 
     if(port_queuing->direction == POK_PORT_DIRECTION_IN) {
-        k_status->max_nb_message = channel->recv.max_nb_message;
-        k_status->nb_message = pok_channel_queuing_r_n_messages(channel);
+        k_status->max_nb_message = channel->recv[port_queuing->receiver_id].max_nb_message;
+        k_status->nb_message = pok_channel_queuing_r_n_messages(channel,
+            port_queuing->receiver_id);
     }
     else {
         /* port_queuing->direction == POK_PORT_DIRECTION_OUT */
@@ -405,6 +416,35 @@ pok_ret_t pok_port_queuing_status(
     return POK_ERRNO_OK;
 }
 
+pok_ret_t pok_port_queuing_stats(
+    pok_port_id_t               id,
+    pok_port_stats_t* __user    stats)
+{
+    pok_port_queuing_t* port_queuing;
+    pok_channel_queuing_t* channel;
+
+    pok_port_stats_t* __kuser k_stats = jet_user_to_kernel_typed(stats);
+    if(!k_stats) return POK_ERRNO_EFAULT;
+
+    port_queuing = get_port_queuing(id);
+
+    if(!port_queuing) return POK_ERRNO_PORT;
+
+    channel = port_queuing->channel;
+
+    pok_preemption_local_disable();
+
+    if(port_queuing->direction == POK_PORT_DIRECTION_IN)
+        *k_stats = channel->recv[port_queuing->receiver_id].stats;
+    else
+        /* port_queuing->direction == POK_PORT_DIRECTION_OUT */
+        *k_stats = channel->send.stats;
+
+    pok_preemption_local_enable();
+
+    return POK_ERRNO_OK;
+}
+
 pok_ret_t pok_port_queuing_id(
     const char* __user name,
     pok_port_id_t* __user id)
@@ -438,13 +478,39 @@ pok_ret_t pok_port_queuing_clear(pok_port_id_t id)
 
     pok_preemption_local_disable();
     pok_channel_queuing_side_init(port_queuing->channel,
-            &port_queuing->channel->recv,
+            &port_queuing->channel->recv[port_queuing->receiver_id],
             port_queuing - current_partition_arinc->ports_queuing);
     pok_preemption_local_enable();
 
     return POK_ERRNO_OK;
 }
 
+pok_ret_t pok_port_queuing_check_ready(pok_port_id_t id,
+    pok_bool_t subscribe)
+{
+    pok_port_queuing_t* port_queuing = get_port_queuing(id);
+    pok_bool_t is_ready;
+
+    if(!port_queuing) return POK_ERRNO_PORT;
+
+    // Threads which are already waited on the port have precedence.
+    if(!pok_thread_wq_is_empty(&port_queuing->waiters))
+        return POK_ERRNO_EMPTY;
+
+    if(port_queuing->direction == POK_PORT_DIRECTION_IN) {
+        pok_message_size_t message_size; // Just for function's call.
+        is_ready = pok_channel_queuing_r_get_message(port_queuing->channel,
+            port_queuing->receiver_id, &message_size, subscribe) != NULL;
+    }
+    else {
+        /* port_queuing->direction == POK_PORT_DIRECTION_OUT */
+        is_ready = pok_channel_queuing_s_get_message(port_queuing->channel,
+            subscribe) != NULL;
+    }
+
+    return is_ready ? POK_ERRNO_OK : POK_ERRNO_EMPTY;
+}
+
 /**********************************************************************/
 /* 
  * Find *configured* sampling port by name, which comes from user space.
@@ -540,7 +606,9 @@ pok_ret_t pok_port_sampling_create(
     }
     else
     {
-        pok_channel_sampling_r_clear_message(port_sampling->channel);
+        pok_channel_sampling_r_init(port_sampling->channel,
+            port_sampling->receiver_id,
+            port_sampling - current_partition_arinc->ports_sampling);
     }
 
     *k_id = port_sampling - current_partition_arinc->ports_sampling;
@@ -615,7 +683,7 @@ pok_ret_t pok_port_sampling_read(
     pok_preemption_local_disable();
 
     message = pok_channel_sampling_r_get_message(port_sampling->channel,
-        &message_size, &ts);
+        port_sampling->receiver_id, &message_size, &ts);
 
     if(message)
     {
@@ -691,6 +759,46 @@ pok_ret_t pok_port_sampling_status (
     return POK_ERRNO_OK;
 }
 
+pok_ret_t pok_port_sampling_stats(
+    pok_port_id_t               id,
+    pok_port_stats_t* __user    stats)
+{
+    pok_port_sampling_t* port_sampling;
+
+    port_sampling = get_port_sampling(id);
+
+    if(!port_sampling) return POK_ERRNO_PORT;
+
+    pok_port_stats_t* __kuser k_stats = jet_user_to_kernel_typed(stats);
+    if(!k_stats) return POK_ERRNO_EFAULT;
+
+    pok_preemption_local_disable();
+
+    if(port_sampling->direction == POK_PORT_DIRECTION_IN)
+        *k_stats = port_sampling->channel->recv[port_sampling->receiver_id].stats;
+    else
+        /* port_sampling->direction == POK_PORT_DIRECTION_OUT */
+        *k_stats = port_sampling->channel->send_stats;
+
+    pok_preemption_local_enable();
+
+    return POK_ERRNO_OK;
+}
+
+pok_ret_t pok_port_sampling_check_ready(pok_port_id_t id,
+    pok_bool_t subscribe)
+{
+    pok_port_sampling_t* port_sampling = get_port_sampling(id);
+
+    if(!port_sampling) return POK_ERRNO_PORT;
+
+    if(port_sampling->direction != POK_PORT_DIRECTION_IN)
+        return POK_ERRNO_DIRECTION;
+
+    return pok_channel_sampling_r_is_updated(port_sampling->channel,
+        port_sampling->receiver_id, subscribe) ? POK_ERRNO_OK : POK_ERRNO_EMPTY;
+}
+
 // TODO: This should be transformed into READ_UPDATED_SAMPLING_MESSAGE eventually.
 pok_ret_t pok_port_sampling_check(pok_port_id_t id)
 {
@@ -707,7 +815,8 @@ pok_ret_t pok_port_sampling_check(pok_port_id_t id)
 
 
     pok_preemption_local_disable();
-    ret = pok_channel_sampling_r_check_new_message(port_sampling->channel)
+    ret = pok_channel_sampling_r_check_new_message(port_sampling->channel,
+            port_sampling->receiver_id)
         ? POK_ERRNO_OK
         : POK_ERRNO_EMPTY;
     pok_preemption_local_enable();
@@ -0,0 +1,196 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <core/profiler.h>
+#include <core/partition_arinc.h>
+#include <core/sched.h>
+#include <core/time.h>
+#include <alloc.h>
+#include <libc.h>
+
+/*
+ * Maximum number of hash table entries checked for the sample.
+ *
+ * Bounds overhead of the sampling: when all these entries are occupied
+ * by other PCs, the sample is dropped.
+ */
+#define PROFILER_MAX_PROBES 8
+
+/*
+ * Histograms, one per ARINC partition and one for the kernel.
+ *
+ * Histogram for partition is indexed by its space id, kernel one has
+ * index 0.
+ */
+static struct jet_profiler_histogram* profiler_histograms;
+static uint32_t profiler_nb_histograms;
+
+/* Ticks remained until the next sample. */
+static uint32_t profiler_countdown;
+
+void jet_profiler_init(void)
+{
+    uint32_t size = 1;
+    uint32_t i;
+
+    if(jet_profiler_period == 0) return;
+
+    while(size < jet_profiler_histogram_size) size <<= 1;
+
+    profiler_nb_histograms = pok_partitions_arinc_n + 1;
+    profiler_histograms = ja_mem_alloc_aligned(
+        sizeof(*profiler_histograms) * profiler_nb_histograms,
+        __alignof__(*profiler_histograms));
+
+    for(i = 0; i < profiler_nb_histograms; i++)
+    {
+        struct jet_profiler_histogram* histogram = &profiler_histograms[i];
+
+        histogram->entries = ja_mem_alloc_aligned(
+            sizeof(*histogram->entries) * size,
+            __alignof__(*histogram->entries));
+        histogram->mask = size - 1;
+    }
+
+    jet_profiler_reset();
+
+    profiler_countdown = jet_profiler_period;
+}
+
+void jet_profiler_reset(void)
+{
+    uint32_t i, j;
+
+    for(i = 0; i < profiler_nb_histograms; i++)
+    {
+        struct jet_profiler_histogram* histogram = &profiler_histograms[i];
+
+        for(j = 0; j <= histogram->mask; j++)
+            histogram->entries[j].count = 0;
+
+        histogram->nb_samples = 0;
+        histogram->nb_dropped = 0;
+    }
+}
+
+/* Add sample into the histogram. */
+static void profiler_histogram_add(struct jet_profiler_histogram* histogram,
+    uintptr_t pc, uint16_t thread_index, pok_bool_t is_kernel)
+{
+    uint32_t hash = (pc >> 2) ^ (thread_index * 0x9e3779b1u);
+    int probe;
+
+    histogram->nb_samples++;
+
+    for(probe = 0; probe < PROFILER_MAX_PROBES; probe++)
+    {
+        struct jet_profiler_entry* entry =
+            &histogram->entries[(hash + probe) & histogram->mask];
+
+        if(entry->count == 0)
+        {
+            entry->pc = pc;
+            entry->thread_index = thread_index;
+            entry->is_kernel = is_kernel;
+            entry->count = 1;
+            return;
+        }
+
+        if(entry->pc == pc && entry->thread_index == thread_index
+            && entry->is_kernel == is_kernel)
+        {
+            entry->count++;
+            return;
+        }
+    }
+
+    histogram->nb_dropped++;
+}
+
+void jet_profiler_tick(uintptr_t pc, pok_bool_t is_kernel)
+{
+    uint32_t space_id;
+    uint16_t thread_index = JET_PROFILER_THREAD_NONE;
+
+    if(jet_profiler_period == 0) return;
+
+    if(--profiler_countdown != 0) return;
+    profiler_countdown = jet_profiler_period;
+
+    space_id = current_partition->space_id;
+
+    if(space_id != 0 && space_id < profiler_nb_histograms)
+    {
+        pok_partition_arinc_t* part = current_partition_arinc;
+
+        if(part->thread_current)
+            thread_index = part->thread_current - part->threads;
+    }
+    else
+    {
+        // Non-ARINC partition executes in the kernel only.
+        space_id = 0;
+    }
+
+    profiler_histogram_add(&profiler_histograms[space_id], pc, thread_index,
+        is_kernel);
+}
+
+void jet_profiler_dump(void)
+{
+    uint32_t i, j;
+
+    if(jet_profiler_period == 0)
+    {
+        printf("Profiler is disabled\n");
+        return;
+    }
+
+    /*
+     * Format of lines is parsed by misc/profile.py:
+     *
+     *   [PROFILE] period <ticks> frequency <ticks per second>
+     *   [PROFILE] histogram <index> <partition name> samples <n> dropped <n>
+     *   [PROFILE] sample <index> <thread index> <kernel|user> <pc> <count>
+     */
+    printf("[PROFILE] period %lu frequency %lu\n",
+        (unsigned long)jet_profiler_period,
+        (unsigned long)POK_TIMER_FREQUENCY);
+
+    for(i = 0; i < profiler_nb_histograms; i++)
+    {
+        struct jet_profiler_histogram* histogram = &profiler_histograms[i];
+
+        printf("[PROFILE] histogram %lu %s samples %lu dropped %lu\n",
+            (unsigned long)i,
+            i == 0 ? "kernel" : pok_partitions_arinc[i - 1].base_part.name,
+            (unsigned long)histogram->nb_samples,
+            (unsigned long)histogram->nb_dropped);
+
+        for(j = 0; j <= histogram->mask; j++)
+        {
+            struct jet_profiler_entry* entry = &histogram->entries[j];
+
+            if(entry->count == 0) continue;
+
+            printf("[PROFILE] sample %lu %u %s 0x%lx %lu\n",
+                (unsigned long)i,
+                (unsigned)entry->thread_index,
+                entry->is_kernel ? "kernel" : "user",
+                (unsigned long)entry->pc,
+                (unsigned long)entry->count);
+        }
+    }
+}
@@ -174,7 +174,11 @@ static void inter_partition_switch(pok_partition_t* part)
     current_partition = part;
 
     if(part->space_id != 0)
+    {
         pok_space_switch(part->space_id);
+        // Time page could be outdated while partition has been inactive.
+        jet_time_publish(part->space_id);
+    }
     else
         pok_space_switch(0); // TODO: This should disable all user space tables
 #ifdef POK_NEEDS_MONITOR
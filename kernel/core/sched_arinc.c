@@ -23,14 +23,17 @@
 #include <asp/arch.h>
 #include <core/syscall.h>
 #include <core/uaccess.h>
+#include <core/wait_any.h>
 
 static void thread_start_func(void)
 {
     pok_thread_t* thread_current = current_thread;
+    pok_thread_cold_t* thread_current_cold = pok_thread_cold(
+        current_partition_arinc, thread_current);
 
     pok_partition_jump_user(
-        thread_current->entry,
-        thread_current->init_stack_addr,
+        thread_current_cold->entry,
+        thread_current_cold->init_stack_addr,
         thread_current->initial_sp);
 }
 
@@ -64,6 +67,8 @@ void sched_arinc_start(void)
 /* Notification is received for given queuing port. */
 static void port_queuing_fired(pok_port_queuing_t* port_queuing)
 {
+    pok_partition_arinc_t* part = current_partition_arinc;
+
     if(port_queuing->direction == POK_PORT_DIRECTION_IN)
     {
         while(!pok_thread_wq_is_empty(&port_queuing->waiters))
@@ -72,11 +77,15 @@ static void port_queuing_fired(pok_port_queuing_t* port_queuing)
             pok_message_size_t message_size; // Just for function's call.
 
             if(!pok_channel_queuing_r_get_message(port_queuing->channel,
-                &message_size, TRUE))
+                port_queuing->receiver_id, &message_size, TRUE))
                 break; // wait again
 
             t = pok_thread_wq_wake_up(&port_queuing->waiters);
 
+            pok_channel_queuing_account_wait(
+                &port_queuing->channel->recv[port_queuing->receiver_id],
+                jet_system_time() - pok_thread_cold(part, t)->wait_start);
+
             port_queuing_receive(port_queuing, t);
         }
     }
@@ -91,6 +100,9 @@ static void port_queuing_fired(pok_port_queuing_t* port_queuing)
 
             t = pok_thread_wq_wake_up(&port_queuing->waiters);
 
+            pok_channel_queuing_account_wait(&port_queuing->channel->send,
+                jet_system_time() - pok_thread_cold(part, t)->wait_start);
+
             port_queuing_send(port_queuing, t);
         }
     }
@@ -194,6 +206,12 @@ again:
                 case JET_PARTITION_EVENT_TYPE_PORT_SEND_AVAILABLE:
                 case JET_PARTITION_EVENT_TYPE_PORT_RECEIVE_AVAILABLE:
                     port_queuing_fired(&part->ports_queuing[event.handler_id]);
+                    // Port may remain ready after waiters are served.
+                    if(!pok_thread_wq_is_empty(&part->wait_any_waiters))
+                        jet_wait_any_recheck();
+                    break;
+                case JET_PARTITION_EVENT_TYPE_PORT_SAMPLING_UPDATED:
+                    jet_wait_any_recheck();
                     break;
                 default:
                     unreachable();
@@ -35,117 +35,121 @@
 
 #include <cons.h>
 #include <core/port.h>
+#include <core/uaccess.h>
 
-/* Call given function without protection(with enabled interrupts). */
-static pok_ret_t unprotected_syscall(
-   pok_ret_t (*f)(const pok_syscall_args_t* args),
-   const pok_syscall_args_t*    args)
-{
-   pok_ret_t ret;
-   ja_preempt_enable();
-   ret = f(args);
-   pok_partition_return_user();
-   return ret;
-}
-
-#define SYSCALL_ENTRY(id) case id: return unprotected_syscall(pok_syscall_wrapper_ ## id, args); break;
-
-/**
- * \file kernel/core/syscalls.c
- * \brief This file implement generic system calls
- * \author Julien Delange
+/*
+ * Flags for the syscall table entry.
+ *
+ * Entry without flags is executed with preemption disabled and returns
+ * directly to the user space.
+ */
+/* Enable preemption while syscall is executed. */
+#define JET_SYSCALL_FLAG_PREEMPTIBLE 1
+/* Process partition's events and restore FPU state on return. */
+#define JET_SYSCALL_FLAG_RETURN_USER 2
+/*
+ * Syscall only reads kernel state and never waits.
+ *
+ * Such syscall cannot generate events for the partition, and cannot
+ * switch to other thread or partition, so nothing is needed on return.
  */
+#define JET_SYSCALL_FLAG_READONLY 4
 
-static inline pok_ret_t pok_core_syscall_internal (const pok_syscall_id_t       syscall_id,
-                            const pok_syscall_args_t*    args,
-                            const pok_syscall_info_t*    infos)
+struct jet_syscall_entry
 {
-   switch (syscall_id)
-   {
+   pok_ret_t (*func)(const pok_syscall_args_t* args);
+   unsigned flags;
+};
+
 #if defined (POK_NEEDS_CONSOLE) || defined (POK_NEEDS_DEBUG)
-      case POK_SYSCALL_CONSWRITE:
-         return jet_console_write_user((const char* __user)args->arg1, args->arg2);
-         break;
+static pok_ret_t syscall_conswrite(const pok_syscall_args_t* args)
+{
+   return jet_console_write_user((const char* __user)args->arg1, args->arg2);
+}
 #endif
 
 #if defined POK_NEEDS_GETTICK
-      case POK_SYSCALL_CLOCK_GETTIME:
-         return pok_clock_gettime ((clockid_t)args->arg1, (pok_time_t* __user)args->arg2);
-         break;
+static pok_ret_t syscall_clock_gettime(const pok_syscall_args_t* args)
+{
+   return pok_clock_gettime ((clockid_t)args->arg1, (pok_time_t* __user)args->arg2);
+}
 #endif
-      case POK_SYSCALL_TIME:
-         return jet_time((time_t*)args->arg1);
-
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_CREATE)
 
-#ifdef POK_NEEDS_THREAD_SLEEP
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_SLEEP)
-#endif
+static pok_ret_t syscall_time(const pok_syscall_args_t* args)
+{
+   return jet_time((time_t*)args->arg1);
+}
 
-#ifdef POK_NEEDS_THREAD_SLEEP_UNTIL
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_SLEEP_UNTIL)
-#endif
+/* Converted address is stored into user variable pointed by the second argument. */
+static pok_ret_t syscall_mem_virt_to_phys(const pok_syscall_args_t* args)
+{
+   uintptr_t* __kuser k_phys = jet_user_to_kernel_typed((uintptr_t* __user)args->arg2);
+   if(!k_phys) return POK_ERRNO_EFAULT;
 
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_PERIOD)
+   *k_phys = pok_virt_to_phys(args->arg1);
 
-#if defined (POK_NEEDS_THREAD_SUSPEND) || defined (POK_NEEDS_ERROR_HANDLING)
-      SYSCALL_ENTRY(POK_SYSCALL_THREAD_SUSPEND)
-#endif
+   return POK_ERRNO_OK;
+}
 
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_STATUS)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_DELAYED_START)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_SET_PRIORITY)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_RESUME)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_SUSPEND_TARGET)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_YIELD)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_REPLENISH)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_STOP)
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_STOPSELF)
-
-   SYSCALL_ENTRY(POK_SYSCALL_THREAD_FIND)
-
-   SYSCALL_ENTRY(POK_SYSCALL_RESCHED)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_ENTER_HELPER)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_WAIT)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_NOTIFY)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_WQ_NOTIFY)
-   SYSCALL_ENTRY(POK_SYSCALL_MSECTION_WQ_SIZE)
-
-#ifdef POK_NEEDS_PARTITIONS
-   SYSCALL_ENTRY(POK_SYSCALL_PARTITION_SET_MODE)
-   SYSCALL_ENTRY(POK_SYSCALL_PARTITION_GET_STATUS)
-   SYSCALL_ENTRY(POK_SYSCALL_PARTITION_INC_LOCK_LEVEL)
-   SYSCALL_ENTRY(POK_SYSCALL_PARTITION_DEC_LOCK_LEVEL)
-#endif
+static pok_ret_t syscall_mem_phys_to_virt(const pok_syscall_args_t* args)
+{
+   uintptr_t* __kuser k_virt = jet_user_to_kernel_typed((uintptr_t* __user)args->arg2);
+   if(!k_virt) return POK_ERRNO_EFAULT;
 
-#ifdef POK_NEEDS_ERROR_HANDLING
-   SYSCALL_ENTRY(POK_SYSCALL_ERROR_HANDLER_CREATE)
-   SYSCALL_ENTRY(POK_SYSCALL_ERROR_RAISE_APPLICATION_ERROR)
-   SYSCALL_ENTRY(POK_SYSCALL_ERROR_GET)
-#endif
+   *k_virt = pok_phys_to_virt(args->arg1);
 
-   SYSCALL_ENTRY(POK_SYSCALL_ERROR_RAISE_OS_ERROR)
+   return POK_ERRNO_OK;
+}
 
-   /* Middleware syscalls */
-#ifdef POK_NEEDS_PORTS_SAMPLING
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_CREATE)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_WRITE)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_READ)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_ID)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_STATUS)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_CHECK)
-#endif /* POK_NEEDS_PORTS_SAMPLING */
+static pok_ret_t syscall_get_bsp_info(const pok_syscall_args_t* args)
+{
+   return pok_bsp_get_info((void* __user)args->arg1);
+}
 
+/*
+ * Table of syscalls, indexed by syscall id.
+ *
+ * Entries without function correspond to unknown syscalls.
+ */
+static const struct jet_syscall_entry jet_syscall_table[] =
+{
+   /* Syscalls which are not described in the syscall map. */
+#if defined (POK_NEEDS_CONSOLE) || defined (POK_NEEDS_DEBUG)
+   [POK_SYSCALL_CONSWRITE] = { syscall_conswrite, 0 },
+#endif
+#if defined POK_NEEDS_GETTICK
+   [POK_SYSCALL_CLOCK_GETTIME] = { syscall_clock_gettime, 0 },
+#endif
+   [POK_SYSCALL_TIME] = { syscall_time, 0 },
+   [POK_SYSCALL_MEM_VIRT_TO_PHYS] = { syscall_mem_virt_to_phys, 0 },
+   [POK_SYSCALL_MEM_PHYS_TO_VIRT] = { syscall_mem_phys_to_virt, 0 },
+   [POK_SYSCALL_GET_BSP_INFO] = { syscall_get_bsp_info, 0 },
+
+   /*
+    * Syscalls from the syscall map.
+    *
+    * Generated file contains lines from the map "as is". Includes there
+    * are already processed via <core/syscall.h>, so they are no-op.
+    */
+#define SYSCALL_TABLE_ENTRY(id, entry_flags) \
+   [id] = { pok_syscall_wrapper_ ## id, (entry_flags) },
+#include <core/syscall_table_arinc.h>
+#undef SYSCALL_TABLE_ENTRY
+};
 
-#ifdef POK_NEEDS_PORTS_QUEUEING
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CREATE)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_ID)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_STATUS)
-   SYSCALL_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR)
-#endif /* POK_NEEDS_PORTS_QUEUEING */
+/**
+ * \file kernel/core/syscalls.c
+ * \brief This file implement generic system calls
+ * \author Julien Delange
+ */
 
+/* Syscalls which cannot be expressed via table entry. */
+static pok_ret_t pok_core_syscall_other (const pok_syscall_id_t       syscall_id,
+                            const pok_syscall_args_t*    args,
+                            const pok_syscall_info_t*    infos)
+{
+   switch (syscall_id)
+   {
 #ifdef POK_NEEDS_IO
       case POK_SYSCALL_INB:
          if ((args->arg1 < pok_partitions[infos->partition].io_min) ||
@@ -173,20 +177,6 @@ static inline pok_ret_t pok_core_syscall_internal (const pok_syscall_id_t
        break;
 #endif /* POK_NEEDS_IO */
 
-      //TODO rewrite this! This two syscall needs to return pok_ret_t!
-      case POK_SYSCALL_MEM_VIRT_TO_PHYS:
-         return pok_virt_to_phys(args->arg1);
-         break;
-      case POK_SYSCALL_MEM_PHYS_TO_VIRT:
-         return pok_phys_to_virt(args->arg1);
-         break;
-
-      case POK_SYSCALL_GET_BSP_INFO:
-         return pok_bsp_get_info((void* __user)args->arg1);
-         break;
-
-      SYSCALL_ENTRY(POK_SYSCALL_MEMORY_BLOCK_GET_STATUS)
-
       default:
        /*
         * Unrecognized system call ID.
@@ -198,7 +188,34 @@ static inline pok_ret_t pok_core_syscall_internal (const pok_syscall_id_t
          break;
    }
 
-   return POK_ERRNO_EINVAL; // TODO: Unreachable?
+   // Health monitor may ignore the error and return to the caller.
+   return POK_ERRNO_EINVAL;
+}
+
+static inline pok_ret_t pok_core_syscall_internal (const pok_syscall_id_t       syscall_id,
+                            const pok_syscall_args_t*    args,
+                            const pok_syscall_info_t*    infos)
+{
+   const struct jet_syscall_entry* entry;
+   pok_ret_t ret;
+
+   if((unsigned)syscall_id >= sizeof(jet_syscall_table) / sizeof(jet_syscall_table[0]))
+      return pok_core_syscall_other(syscall_id, args, infos);
+
+   entry = &jet_syscall_table[syscall_id];
+
+   if(entry->func == NULL)
+      return pok_core_syscall_other(syscall_id, args, infos);
+
+   if(entry->flags & JET_SYSCALL_FLAG_PREEMPTIBLE)
+      ja_preempt_enable();
+
+   ret = entry->func(args);
+
+   if(entry->flags & JET_SYSCALL_FLAG_RETURN_USER)
+      pok_partition_return_user();
+
+   return ret;
 }
 
 pok_ret_t pok_core_syscall (const pok_syscall_id_t       syscall_id,
@@ -55,7 +55,7 @@ static pok_thread_t* find_thread(const char name[MAX_NAME_LENGTH])
 #ifdef POK_NEEDS_ERROR_HANDLING
 		if(part->thread_error == t) continue; /* error thread is not searchable. */
 #endif
-        if(!pok_compare_names(t->name, name)) return t;
+        if(!pok_compare_names(pok_thread_cold(part, t)->name, name)) return t;
     }
 
     return NULL;
@@ -90,6 +90,7 @@ pok_ret_t pok_thread_create (const char* __user name,
     pok_thread_id_t* __user         thread_id)
 {
     pok_thread_t* t;
+    pok_thread_cold_t* t_cold;
     pok_partition_arinc_t* part = current_partition_arinc;
 
     /*
@@ -113,31 +114,32 @@ pok_ret_t pok_thread_create (const char* __user name,
     }
 
     t = &part->threads[part->nthreads_used];
+    t_cold = pok_thread_cold(part, t);
 
-    t->entry = entry;
+    t_cold->entry = entry;
     t->base_priority = k_attr->priority;
-    t->period = k_attr->period;
-    t->time_capacity = k_attr->time_capacity;
-    t->deadline = k_attr->deadline;
+    t_cold->period = k_attr->period;
+    t_cold->time_capacity = k_attr->time_capacity;
+    t_cold->deadline = k_attr->deadline;
 
     if (t->base_priority > MAX_PRIORITY_VALUE ||
         t->base_priority < MIN_PRIORITY_VALUE) return POK_ERRNO_EINVAL;
 
-    if (t->period == 0) {
+    if (t_cold->period == 0) {
         return POK_ERRNO_PARAM;
     }
-    if (t->time_capacity == 0) {
+    if (t_cold->time_capacity == 0) {
         return POK_ERRNO_PARAM;
     }
 
-    if(!pok_time_is_infinity(t->period))
+    if(!pok_time_is_infinity(t_cold->period))
     {
-        if(pok_time_is_infinity(t->time_capacity)) {
+        if(pok_time_is_infinity(t_cold->time_capacity)) {
             // periodic process must have definite time capacity
             return POK_ERRNO_PARAM;
         }
 
-        if(t->time_capacity > t->period) {
+        if(t_cold->time_capacity > t_cold->period) {
             // for periodic process, time capacity <= period
             return POK_ERRNO_PARAM;
         }
@@ -146,15 +148,15 @@ pok_ret_t pok_thread_create (const char* __user name,
    }
 
     // do at least basic check of entry point
-    if (!jet_check_access_exec(t->entry)) {
+    if (!jet_check_access_exec(t_cold->entry)) {
         return POK_ERRNO_PARAM;
     }
 
-    memcpy(t->name, k_name, MAX_NAME_LENGTH);
+    memcpy(t_cold->name, k_name, MAX_NAME_LENGTH);
 
-    if(find_thread(t->name)) return POK_ERRNO_EXISTS;
+    if(find_thread(t_cold->name)) return POK_ERRNO_EXISTS;
 
-    t->user_stack_size = k_attr->stack_size;
+    t_cold->user_stack_size = k_attr->stack_size;
 
     if(!thread_create(t)) return POK_ERRNO_UNAVAILABLE;
 
@@ -230,6 +232,8 @@ static pok_ret_t thread_delayed_start_internal (pok_thread_t* thread,
 {
     pok_partition_arinc_t* part = current_partition_arinc;
 
+    pok_thread_cold_t* thread_cold = pok_thread_cold(part, thread);
+
     pok_time_t thread_start_time;
 
     struct jet_thread_shared_data* tshd = part->kshd->tshd
@@ -241,7 +245,7 @@ static pok_ret_t thread_delayed_start_internal (pok_thread_t* thread,
         return POK_ERRNO_UNAVAILABLE;
     }
 
-    if (!pok_time_is_infinity(thread->period) && delay >= thread->period) {
+    if (!pok_time_is_infinity(thread_cold->period) && delay >= thread_cold->period) {
         return POK_ERRNO_EINVAL;
     }
 
@@ -252,32 +256,33 @@ static pok_ret_t thread_delayed_start_internal (pok_thread_t* thread,
     tshd->msection_entering = NULL;
     tshd->priority = thread->priority;
     tshd->thread_kernel_flags = 0;
+    tshd->deadline_time = POK_TIME_INFINITY;
 
 	if(part->mode != POK_PARTITION_MODE_NORMAL)
 	{
 		/* Delay thread's starting until normal mode. */
-		thread->delayed_time = delay;
+		thread_cold->delayed_time = delay;
 		thread->state = POK_STATE_WAITING;
 
 		return POK_ERRNO_OK;
 	}
 
     // Normal mode.
-    if (pok_time_is_infinity(thread->period)) {
+    if (pok_time_is_infinity(thread_cold->period)) {
         // aperiodic process
         thread_start_time = jet_system_time() + delay;
     }
     else {
 		// periodic process
 		thread_start_time = get_next_periodic_processing_start() + delay;
-		thread->next_activation = thread_start_time + thread->period;
+		thread->next_activation = thread_start_time + thread_cold->period;
 	}
 
-	if(!pok_time_is_infinity(thread->time_capacity))
-		thread_set_deadline(thread, thread_start_time + thread->time_capacity);
+	if(!pok_time_is_infinity(thread_cold->time_capacity))
+		thread_set_deadline(thread, thread_start_time + thread_cold->time_capacity);
 
 	/* Only non-delayed aperiodic process starts immediately */
-	if(delay == 0 && pok_time_is_infinity(thread->period))
+	if(delay == 0 && pok_time_is_infinity(thread_cold->period))
         thread_start(thread);
 	else
 		thread_wait_timed(thread, thread_start_time);
@@ -330,6 +335,8 @@ pok_ret_t pok_thread_get_status (pok_thread_id_t id,
     pok_thread_t *t = get_thread_by_id(id);
     if(!t) return POK_ERRNO_PARAM;
 
+    pok_thread_cold_t* t_cold = pok_thread_cold(current_partition_arinc, t);
+
     pok_thread_status_t* __kuser k_status = jet_user_to_kernel_typed(status);
     if(!k_status) return POK_ERRNO_EFAULT;
 
@@ -339,14 +346,14 @@ pok_ret_t pok_thread_get_status (pok_thread_id_t id,
     char* __kuser k_name = jet_user_to_kernel(name, MAX_NAME_LENGTH);
     if(!k_name) return POK_ERRNO_EFAULT;
 
-    memcpy(k_name, t->name, MAX_NAME_LENGTH);
-    *k_entry = t->entry;
+    memcpy(k_name, t_cold->name, MAX_NAME_LENGTH);
+    *k_entry = t_cold->entry;
 
     k_status->attributes.priority = t->base_priority;
-	k_status->attributes.period = t->period;
-	k_status->attributes.deadline = t->deadline;
-	k_status->attributes.time_capacity = t->time_capacity;
-	k_status->attributes.stack_size = t->user_stack_size;
+	k_status->attributes.period = t_cold->period;
+	k_status->attributes.deadline = t_cold->deadline;
+	k_status->attributes.time_capacity = t_cold->time_capacity;
+	k_status->attributes.stack_size = t_cold->user_stack_size;
 
     pok_preemption_local_disable();
 
@@ -364,10 +371,10 @@ pok_ret_t pok_thread_get_status (pok_thread_id_t id,
     else
         k_status->state = t->state;
 
-	if(pok_time_is_infinity(t->time_capacity))
+	if(pok_time_is_infinity(t_cold->time_capacity))
 		k_status->deadline_time = POK_TIME_INFINITY;
 	else
-		k_status->deadline_time = t->thread_deadline_event.timepoint;
+		k_status->deadline_time = t_cold->thread_deadline_event.timepoint;
 
 	pok_preemption_local_enable();
 
@@ -656,6 +663,7 @@ pok_ret_t pok_thread_find(const char* __user name, pok_thread_id_t* __user id)
 pok_ret_t pok_sched_end_period(void)
 {
     pok_thread_t* t = current_thread;
+    pok_thread_cold_t* t_cold = pok_thread_cold(current_partition_arinc, t);
 
     if(!pok_thread_is_periodic(t)) return POK_ERRNO_MODE;
 
@@ -664,8 +672,8 @@ pok_ret_t pok_sched_end_period(void)
     pok_preemption_local_disable();
 
 	thread_wait_timed(t, t->next_activation);
-	thread_set_deadline(t, t->next_activation + t->time_capacity);
-	t->next_activation += t->period;
+	thread_set_deadline(t, t->next_activation + t_cold->time_capacity);
+	t->next_activation += t_cold->period;
 
 	pok_preemption_local_enable();
 
@@ -683,6 +691,7 @@ pok_ret_t pok_sched_replenish(const pok_time_t* __user budget)
     pok_time_t kernel_budget = *k_budget;
 
     pok_thread_t* t = current_thread;
+    pok_thread_cold_t* t_cold = pok_thread_cold(part, t);
 
 #ifdef POK_NEEDS_ERROR_HANDLING
     if(t == part->thread_error) return POK_ERRNO_UNAVAILABLE;
@@ -691,27 +700,26 @@ pok_ret_t pok_sched_replenish(const pok_time_t* __user budget)
     if(part->mode != POK_PARTITION_MODE_NORMAL)
 		return POK_ERRNO_UNAVAILABLE;
 
-    if(pok_time_is_infinity(t->time_capacity)) return POK_ERRNO_OK; //nothing to do
+    if(pok_time_is_infinity(t_cold->time_capacity)) return POK_ERRNO_OK; //nothing to do
 
     pok_preemption_local_disable();
 
     if(pok_time_is_infinity(kernel_budget))
     {
-        if(!pok_time_is_infinity(t->period))
+        if(!pok_time_is_infinity(t_cold->period))
         {
             ret = POK_ERRNO_MODE;
             goto out;
         }
 
-        delayed_event_remove(&part->partition_delayed_events,
-            &t->thread_deadline_event);
+        thread_cancel_deadline(t);
         ret = POK_ERRNO_OK;
     }
     else
     {
         pok_time_t calculated_deadline = jet_system_time() + kernel_budget;
 
-        if(!pok_time_is_infinity(t->period)
+        if(!pok_time_is_infinity(t_cold->period)
             && calculated_deadline >= t->next_activation)
         {
             ret = POK_ERRNO_MODE;
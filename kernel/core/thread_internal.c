@@ -16,16 +16,105 @@
 #include "thread_internal.h"
 #include <core/sched_arinc.h>
 #include <core/space.h>
+#include <asp/stack.h>
+#include <asp/uaccess.h>
+#include <common.h>
+
+#ifdef POK_NEEDS_STACK_USAGE
+/*
+ * Unused part of the stacks is filled with this pattern, so their
+ * high-water marks may be found for the memory footprint report.
+ *
+ * Painting takes time proportional to the stack size, so it is
+ * performed only if stack usage is requested in the build.
+ */
+#define STACK_PAINT_PATTERN 0x5354434bu /* "STCK" */
+
+static void stack_paint(uint32_t* bottom, size_t size)
+{
+    for(size_t i = 0; i < size / sizeof(uint32_t); i++)
+        bottom[i] = STACK_PAINT_PATTERN;
+}
+
+/* Return number of bytes at the top of painted area which are overwritten. */
+static size_t stack_used(const uint32_t* bottom, size_t size)
+{
+    size_t n = size / sizeof(uint32_t);
+    size_t i = 0;
+
+    while(i < n && bottom[i] == STACK_PAINT_PATTERN) i++;
+
+    return (n - i) * sizeof(uint32_t);
+}
+
+/*
+ * Return kernel address of the thread's user stack bottom, or NULL.
+ *
+ * Stack area is [init_stack_addr - user_stack_size; init_stack_addr).
+ */
+static uint32_t* __kuser user_stack_bottom(pok_partition_arinc_t* part,
+    pok_thread_t* t, size_t* size)
+{
+    pok_thread_cold_t* t_cold = pok_thread_cold(part, t);
+
+    *size = t_cold->user_stack_size & ~(sizeof(uint32_t) - 1);
+    if(*size == 0) return NULL;
+
+    return ja_user_to_kernel_space(
+        (void* __user)(t_cold->init_stack_addr - *size), *size,
+        part->base_part.space_id);
+}
+
+/*
+ * Return bottom of the thread's kernel stack.
+ *
+ * pok_stack_alloc() may spend a couple of words of the requested size
+ * for the terminating frame, so a bit less than 'kernel_stack_size'
+ * is painted.
+ */
+static uint32_t* kernel_stack_bottom(pok_partition_arinc_t* part,
+    pok_thread_t* t, size_t* size)
+{
+    uintptr_t bottom = ALIGN_VAL(t->initial_sp - part->kernel_stack_size
+        + 2 * sizeof(uint32_t), sizeof(uint32_t));
+
+    *size = t->initial_sp - bottom;
+
+    return (uint32_t*)bottom;
+}
+#endif /* POK_NEEDS_STACK_USAGE */
+
+void thread_kernel_stack_alloc(pok_partition_arinc_t* part, pok_thread_t* t)
+{
+    t->initial_sp = pok_stack_alloc(part->kernel_stack_size);
+
+#ifdef POK_NEEDS_STACK_USAGE
+    size_t stack_size;
+    uint32_t* kstack = kernel_stack_bottom(part, t, &stack_size);
+    stack_paint(kstack, stack_size);
+#endif
+}
 
 pok_bool_t thread_create(pok_thread_t* t)
 {
     pok_partition_arinc_t* part = current_partition_arinc;
 
-    t->init_stack_addr = ja_ustack_alloc(
+    pok_thread_cold_t* t_cold = pok_thread_cold(part, t);
+
+    // Kernel stack is not reserved for the thread.
+    if(t->initial_sp == 0) return FALSE;
+
+    t_cold->init_stack_addr = ja_ustack_alloc(
         part->base_part.space_id,
-        t->user_stack_size);
+        t_cold->user_stack_size);
+
+    if(t_cold->init_stack_addr == 0) return FALSE;
 
-    if(t->init_stack_addr == 0) return FALSE;
+#ifdef POK_NEEDS_STACK_USAGE
+    size_t stack_size;
+    uint32_t* __kuser ustack = user_stack_bottom(part, t, &stack_size);
+    if(ustack) stack_paint(ustack, stack_size);
+#endif
 
     // Initialize thread shared data
     struct jet_thread_shared_data* tshd_t = part->kshd->tshd
@@ -52,8 +141,8 @@ pok_bool_t thread_create(pok_thread_t* t)
 
     t->msection_entering = NULL;
 
-    delayed_event_init(&t->thread_deadline_event);
-    delayed_event_init(&t->thread_delayed_event);
+    delayed_event_init(&t_cold->thread_deadline_event);
+    delayed_event_init(&t_cold->thread_delayed_event);
     INIT_LIST_HEAD(&t->wait_elem);
     INIT_LIST_HEAD(&t->eligible_elem);
     INIT_LIST_HEAD(&t->error_elem);
@@ -148,19 +237,22 @@ static void thread_set_uneligible(pok_thread_t* t)
  */
 static void thread_process_delayed_event(uint16_t handler_id)
 {
-    pok_thread_t* t = &current_partition_arinc->threads[handler_id];
-    t->thread_delayed_func(t);
+    pok_partition_arinc_t* part = current_partition_arinc;
+    pok_thread_t* t = &part->threads[handler_id];
+
+    pok_thread_cold(part, t)->thread_delayed_func(t);
 }
 
 void thread_delay_event(pok_thread_t* t, pok_time_t delay_time,
 	void (*thread_delayed_func)(pok_thread_t* t))
 {
     pok_partition_arinc_t* part = current_partition_arinc;
+    pok_thread_cold_t* t_cold = pok_thread_cold(part, t);
 
-    t->thread_delayed_func = thread_delayed_func;
+    t_cold->thread_delayed_func = thread_delayed_func;
 
     delayed_event_add(&part->partition_delayed_events,
-	&t->thread_delayed_event, delay_time,
+	&t_cold->thread_delayed_event, delay_time,
 	t - part->threads,
 	&thread_process_delayed_event);
 }
@@ -173,7 +265,7 @@ void thread_delay_event(pok_thread_t* t, pok_time_t delay_time,
 static void thread_deadline_occured(uint16_t handler_id)
 {
     pok_thread_t* thread = &current_partition_arinc->threads[handler_id];
-    printf_debug("Deadline occured for thread %s (%d)\n", thread->name, (int)(thread - current_partition_arinc->threads));
+    printf_debug("Deadline occured for thread %s (%d)\n", pok_thread_cold(current_partition_arinc, thread)->name, (int)(thread - current_partition_arinc->threads));
     pok_thread_emit_deadline_missed(thread);
 
     // TODO: if error was ignored, what to do?
@@ -184,9 +276,21 @@ void thread_set_deadline(pok_thread_t* t, pok_time_t deadline_time)
     pok_partition_arinc_t* part = current_partition_arinc;
 
     delayed_event_add(&part->partition_delayed_events,
-	&t->thread_deadline_event, deadline_time,
+	&pok_thread_cold(part, t)->thread_deadline_event, deadline_time,
         t - part->threads,
 	&thread_deadline_occured);
+
+    part->kshd->tshd[t - part->threads].deadline_time = deadline_time;
+}
+
+void thread_cancel_deadline(pok_thread_t* t)
+{
+    pok_partition_arinc_t* part = current_partition_arinc;
+
+    delayed_event_remove(&part->partition_delayed_events,
+	&pok_thread_cold(part, t)->thread_deadline_event);
+
+    part->kshd->tshd[t - part->threads].deadline_time = POK_TIME_INFINITY;
 }
 
 void thread_delay_event_cancel(pok_thread_t* t)
@@ -194,7 +298,7 @@ void thread_delay_event_cancel(pok_thread_t* t)
     pok_partition_arinc_t* part = current_partition_arinc;
 
     delayed_event_remove(&part->partition_delayed_events,
-	&t->thread_delayed_event);
+	&pok_thread_cold(part, t)->thread_delayed_event);
 }
 
 
@@ -210,8 +314,7 @@ void thread_stop(pok_thread_t* t)
     // Remove thread from all queues except one for error handler.
     thread_delay_event_cancel(t);
 
-    delayed_event_remove(&part->partition_delayed_events,
-	&t->thread_deadline_event);
+    thread_cancel_deadline(t);
 
     pok_thread_wq_remove(t);
 
@@ -349,9 +452,11 @@ void thread_suspend_timed(pok_thread_t* t, pok_time_t time)
 
 void thread_resume(pok_thread_t* t)
 {
+    pok_thread_cold_t* t_cold = pok_thread_cold(current_partition_arinc, t);
+
     t->suspended = FALSE;
-    if(delayed_event_is_active(&t->thread_delayed_event)
-	&& t->thread_delayed_func == &thread_resume_waited)
+    if(delayed_event_is_active(&t_cold->thread_delayed_event)
+	&& t_cold->thread_delayed_func == &thread_resume_waited)
     {
 	// We are waited on timer for suspencion. Cancel that waiting.
 	t->state = POK_STATE_RUNNABLE;
@@ -367,3 +472,36 @@ void thread_resume(pok_thread_t* t)
         thread_set_eligible(t);
     }
 }
+
+#ifdef POK_NEEDS_STACK_USAGE
+size_t thread_user_stack_used(pok_partition_arinc_t* part, pok_thread_t* t)
+{
+    size_t size;
+    size_t used = 0;
+    /*
+     * Kernel address of user memory may be valid only while the space
+     * is current (e.g., on PowerPC), so the space is switched for the
+     * time of reading.
+     */
+    jet_space_id space_id_prev = ja_space_get_current();
+
+    ja_space_switch(part->base_part.space_id);
+
+    const uint32_t* __kuser ustack = user_stack_bottom(part, t, &size);
+    if(ustack) used = stack_used(ustack, size);
+
+    ja_space_switch(space_id_prev);
+
+    return used;
+}
+
+size_t thread_kernel_stack_used(pok_partition_arinc_t* part, pok_thread_t* t)
+{
+    size_t size;
+    const uint32_t* kstack;
+
+    kstack = kernel_stack_bottom(part, t, &size);
+
+    return stack_used(kstack, size);
+}
+#endif /* POK_NEEDS_STACK_USAGE */
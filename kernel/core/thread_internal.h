@@ -46,6 +46,16 @@
  */
 pok_bool_t thread_create(pok_thread_t* t);
 
+/*
+ * Allocate kernel stack of the thread.
+ *
+ * Executed once during partition initialization, so the kernel memory
+ * doesn't depend on the threads created at runtime.
+ *
+ * Thread without kernel stack cannot be created.
+ */
+void thread_kernel_stack_alloc(pok_partition_arinc_t* part, pok_thread_t* t);
+
 
 /*
  * Postpone event for given thread.
@@ -70,6 +80,13 @@ void thread_delay_event_cancel(pok_thread_t* t);
  */
 void thread_set_deadline(pok_thread_t* t, pok_time_t deadline_time);
 
+/*
+ * Remove deadline of given thread, if it was.
+ * 
+ * Called with local preemption disabled.
+ */
+void thread_cancel_deadline(pok_thread_t* t);
+
 /* 
  * Mark thread as waiting on any condition except suspension.
  * 
@@ -192,4 +209,21 @@ void thread_start(pok_thread_t* t);
  * Called with local preemption disabled.
  */
 void thread_yield(pok_thread_t *t);
+
+#ifdef POK_NEEDS_STACK_USAGE
+/*
+ * Return number of bytes of the thread's user stack which have been
+ * used since the thread is created.
+ *
+ * Should be called with local preemption disabled.
+ */
+size_t thread_user_stack_used(pok_partition_arinc_t* part, pok_thread_t* t);
+
+/*
+ * Return number of bytes of the thread's kernel stack which have been
+ * used since the partition is initialized (the stack is kept on restart).
+ */
+size_t thread_kernel_stack_used(pok_partition_arinc_t* part, pok_thread_t* t);
+#endif /* POK_NEEDS_STACK_USAGE */
+
 #endif /* __POK_THREAD_INTERNAL_H__ */
@@ -21,11 +21,39 @@
 #include <core/time.h>
 #include <core/uaccess.h>
 #include <core/sched.h>
+#include <core/partition.h>
 
 #include <asp/entries.h> /* jet_on_tick() declaration. */
 
+void jet_time_publish(jet_space_id space_id)
+{
+    struct jet_kernel_time* __kuser kt = &ja_space_shared_data(space_id)->time;
+
+    kt->seq++;
+    barrier();
+    ja_time_fill_page(kt);
+    barrier();
+    kt->seq++;
+}
+
 void jet_on_tick(void)
 {
+    /*
+     * Time of the current partition is updated before scheduling,
+     * as the latter may switch to other partition and return later.
+     *
+     * Only published value of the time becomes outdated on tick.
+     * Parameters of the timebase are constant, so the page with them
+     * is republished only on space switch.
+     */
+    if(current_partition->space_id != 0)
+    {
+        jet_space_id space_id = current_partition->space_id;
+
+        if(ja_space_shared_data(space_id)->time.source == JET_KERNEL_TIME_SOURCE_VALUE)
+            jet_time_publish(space_id);
+    }
+
     pok_sched_on_time_changed();
 }
 
@@ -0,0 +1,204 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <core/wait_any.h>
+#include <core/partition_arinc.h>
+#include <core/port.h>
+#include <core/thread.h>
+#include "thread_internal.h"
+#include <core/uaccess.h>
+#include <core/sched_arinc.h>
+#include <uapi/wait_any_types.h>
+
+/*
+ * Check whether object is ready.
+ *
+ * Returns POK_ERRNO_OK if ready, POK_ERRNO_EMPTY if not ready and
+ * other error code if object is incorrect.
+ */
+static pok_ret_t wait_any_check_object(
+    const jet_wait_any_object_t* __kuser object,
+    pok_bool_t subscribe)
+{
+    const int32_t* __kuser k_counter;
+
+    switch(object->kind) {
+    case JET_WAIT_ANY_QUEUING_PORT:
+        return pok_port_queuing_check_ready(object->port_id, subscribe);
+    case JET_WAIT_ANY_SAMPLING_PORT:
+        return pok_port_sampling_check_ready(object->port_id, subscribe);
+    case JET_WAIT_ANY_COUNTER:
+        k_counter = jet_user_to_kernel_typed_ro(object->counter);
+        if(!k_counter) return POK_ERRNO_EFAULT;
+        return (*(const volatile int32_t*)k_counter > 0)
+            ? POK_ERRNO_OK : POK_ERRNO_EMPTY;
+    default:
+        return POK_ERRNO_EINVAL;
+    }
+}
+
+/*
+ * Find the first ready object.
+ *
+ * Returns POK_ERRNO_OK and sets 'index' if found.
+ * Returns POK_ERRNO_EMPTY if none of objects is ready.
+ * Otherwise returns error for incorrect object.
+ *
+ * Should be called with local preemption disabled.
+ */
+static pok_ret_t wait_any_find_ready(
+    const jet_wait_any_object_t* __kuser objects,
+    size_t n,
+    pok_bool_t subscribe,
+    size_t* index)
+{
+    size_t i;
+    pok_ret_t ret = POK_ERRNO_EMPTY;
+
+    for(i = 0; i < n; i++)
+    {
+        pok_ret_t ret_object = wait_any_check_object(&objects[i], subscribe);
+
+        if(ret_object == POK_ERRNO_OK)
+        {
+            *index = i;
+            return POK_ERRNO_OK;
+        }
+        else if(ret_object != POK_ERRNO_EMPTY)
+        {
+            ret = ret_object;
+        }
+    }
+
+    return ret;
+}
+
+pok_ret_t jet_wait_any(const jet_wait_any_object_t* __user objects,
+    size_t n,
+    const pok_time_t* __user timeout,
+    size_t* __user ready_index)
+{
+    pok_partition_arinc_t* part = current_partition_arinc;
+    pok_thread_t* t;
+    pok_thread_cold_t* t_cold;
+    pok_ret_t ret;
+    size_t index;
+
+    if(n == 0 || n > JET_WAIT_ANY_MAX_OBJECTS) return POK_ERRNO_EINVAL;
+
+    const jet_wait_any_object_t* __kuser k_objects =
+        jet_user_to_kernel_ro(objects, n * sizeof(*objects));
+    if(!k_objects) return POK_ERRNO_EFAULT;
+
+    size_t* __kuser k_ready_index = jet_user_to_kernel_typed(ready_index);
+    if(!k_ready_index) return POK_ERRNO_EFAULT;
+
+    const pok_time_t* __kuser k_timeout = jet_user_to_kernel_typed_ro(timeout);
+    if(!k_timeout) return POK_ERRNO_EFAULT;
+    pok_time_t kernel_timeout = *k_timeout;
+
+    pok_preemption_local_disable();
+
+    t = current_thread;
+    t_cold = pok_thread_cold(part, t);
+
+    /*
+     * Subscribe for notifications only if waiting is possible.
+     * Incorrect object is reported only if no object is ready.
+     */
+    ret = wait_any_find_ready(k_objects, n,
+        kernel_timeout != 0 && thread_is_waiting_allowed(), &index);
+
+    if(ret == POK_ERRNO_OK)
+    {
+        *k_ready_index = index;
+        goto err;
+    }
+    else if(ret != POK_ERRNO_EMPTY)
+    {
+        goto err;
+    }
+
+    if(kernel_timeout == 0)
+    {
+        goto err; // POK_ERRNO_EMPTY
+    }
+    else if(!thread_is_waiting_allowed())
+    {
+        ret = POK_ERRNO_MODE;
+        goto err;
+    }
+
+    // Prepare to wait.
+    t_cold->wait_buffer.src = k_objects;
+    t_cold->wait_len = n;
+
+    pok_thread_wq_add(&part->wait_any_waiters, t);
+    part->kshd->wait_any_pending = TRUE;
+
+    thread_wait_common(t, kernel_timeout);
+
+    pok_preemption_local_enable(); // Possible wait here
+
+    if(t->wait_result == POK_ERRNO_OK)
+        *k_ready_index = t_cold->wait_len;
+
+    return t->wait_result;
+
+err:
+    pok_preemption_local_enable();
+
+    return ret;
+}
+
+void jet_wait_any_recheck(void)
+{
+    pok_partition_arinc_t* part = current_partition_arinc;
+    pok_thread_t* t;
+    pok_thread_t* t_next;
+
+    list_for_each_entry_safe(t, t_next, &part->wait_any_waiters.waits, wait_elem)
+    {
+        pok_thread_cold_t* t_cold = pok_thread_cold(part, t);
+        size_t index;
+
+        /*
+         * Objects have been checked when wait started, so error here
+         * is possible only if user space modified the array. Ignore it.
+         */
+        if(wait_any_find_ready(t_cold->wait_buffer.src, t_cold->wait_len, TRUE, &index)
+            != POK_ERRNO_OK)
+            continue;
+
+        // Remove thread from the queue, so it won't be treated as timeouted.
+        pok_thread_wq_remove(t);
+        thread_wake_up(t);
+
+        t_cold->wait_len = index;
+        t->wait_result = POK_ERRNO_OK;
+    }
+
+    part->kshd->wait_any_pending =
+        !pok_thread_wq_is_empty(&part->wait_any_waiters);
+}
+
+pok_ret_t jet_wait_any_kick(void)
+{
+    pok_preemption_local_disable();
+    jet_wait_any_recheck();
+    pok_preemption_local_enable();
+
+    return POK_ERRNO_OK;
+}
@@ -23,6 +23,14 @@
 // TODO: Where should be that definition?
 #define KERNEL_STACK_SIZE_DEFAULT 8192
 
+/*
+ * Size of the data cache line.
+ *
+ * Both supported architectures (x86 and e500mc) have 64-byte lines.
+ * Used for the layout of frequently accessed kernel structures.
+ */
+#define JET_CACHE_LINE_SIZE 64
+
 /**
  * Disable interrupts
  */
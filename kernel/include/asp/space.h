@@ -79,6 +79,14 @@ void ja_user_space_jump(
  */
 void   ja_space_switch (jet_space_id new_space_id);
 
+/*
+ * Print statistics of address translation for every space
+ * (e.g., TLB misses).
+ *
+ * Used by the monitor.
+ */
+void ja_space_print_stats(void);
+
 /*
  * Return id of current space.
  */
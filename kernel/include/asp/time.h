@@ -18,6 +18,7 @@
 
 #include <types.h>
 #include <uapi/time.h>
+#include <uapi/kernel_shared_data.h>
 
 /* Return current system time. */
 pok_time_t ja_system_time(void);
@@ -25,5 +26,14 @@ pok_time_t ja_system_time(void);
 /* Return current calendar time (seconds since Epoch). */
 time_t ja_calendar_time(void);
 
+/*
+ * Fill time page for the user space.
+ *
+ * Every field except 'seq' should be set.
+ *
+ * Called with local preemption disabled, and 'kt->seq' is odd.
+ */
+void ja_time_fill_page(struct jet_kernel_time* __kuser kt);
+
 
 #endif /* __JET_ASP_TIME_H__ */
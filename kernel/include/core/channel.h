@@ -23,21 +23,40 @@
 #include <types.h>
 
 #include <core/partition.h>
+#include <uapi/port_types.h>
 
 /*********************** Queuing channel ******************************/
 
-/* One side of the channel: receiver or sender. */
+/* 
+ * Reference to the message in the channel's store.
+ * 
+ * Index of the slot for JET_CHANNEL_QUEUING_STORAGE_SLOTS storage,
+ * offset of the record for JET_CHANNEL_QUEUING_STORAGE_PACKED storage.
+ */
+typedef uint32_t jet_channel_queuing_ref_t;
+
+/* 
+ * One side of the channel: receiver or sender.
+ * 
+ * Every side has its own queue of messages. Queue contains references
+ * to messages in the channel's store, so the same message may be queued
+ * at several receivers at once.
+ */
 struct pok_channel_queuing_side
 {
     /* Maximum number of messages on this side. Set in deployment.c. */
     pok_message_range_t max_nb_message;
+
+    /* Current number of messages on this side. */
+    pok_message_range_t nb_message;
+    /* Position of the first message in the `queue`. */
+    pok_message_range_t first_message;
     /* 
-     * Next message on this side:
+     * Cyclic queue of message references with `max_nb_message` elements.
      * 
-     * For receiver: the next message it will consume.
-     * For sender: the next message it will fill.
+     * Allocated on channel's initialization.
      */
-    pok_message_range_t next_message;
+    jet_channel_queuing_ref_t* queue;
 
     /* Partition corresponded for this side. Set in deployment.c */
     pok_partition_t* part;
@@ -50,6 +69,15 @@ struct pok_channel_queuing_side
 
     /* Identificator for use in notification event. Set on port creation. */
     uint16_t handler_id;
+
+    /* 
+     * Flag is set when message is discarded for this (receiver) side.
+     * Flag is cleared after receiver is notified about that.
+     */
+    pok_bool_t message_discarded;
+
+    /* Traffic statistics for this side. */
+    pok_port_stats_t stats;
 };
 
 /* What to do when receiving buffer is full and new message is sent. */
@@ -72,15 +100,59 @@ enum jet_channel_queuing_overflow_strategy
     JET_CHANNEL_QUEUING_RECEIVER_DISCARD
 };
 
+/* How messages are stored in the channel. */
+enum jet_channel_queuing_storage
+{
+    /* 
+     * Every message occupies slot of `max_message_size` bytes.
+     * 
+     * Number of slots is sum of all sides capacities.
+     */
+    JET_CHANNEL_QUEUING_STORAGE_SLOTS,
+    /* 
+     * Messages are packed into the ring of `max_nb_bytes` bytes.
+     * 
+     * Every message occupies only its actual size plus small header.
+     * Sender may produce new message only when both its queue and
+     * the ring have a space for it.
+     */
+    JET_CHANNEL_QUEUING_STORAGE_PACKED
+};
+
+/* 
+ * Header of the message record in the packed storage.
+ * 
+ * Record with zero size pads the ring up to its end.
+ */
+struct jet_channel_queuing_record
+{
+    pok_message_size_t size;
+    /* Number of receivers which still refer to the message. */
+    uint8_t refs;
+    /* Whether record is still used (by the sender or receivers). */
+    pok_bool_t is_used;
+};
+
 /* 
  * Queuing channel between partitions.
  * 
- * Receiver has buffer of received messages.
+ * Channel has single sender and one or more receivers.
+ * 
+ * Every receiver has buffer of received messages.
  * Sender has buffer of messages ready to send.
  * 
- * Mesages in that channel are transmitted *instantly* unless receiver
- * is not ready or its buffer is full. In that case messages are
- * accumulated on sender side until it is possible to transmit them.
+ * Messages are stored only once, in the slots of the channel's store.
+ * Receivers refer to these slots, and slot is released when the last
+ * receiver consumes the message.
+ * 
+ * Mesages in that channel are transmitted *instantly* unless some
+ * receiver has its buffer full. In that case messages are accumulated
+ * on sender side until it is possible to transmit them (for
+ * JET_CHANNEL_QUEUING_SENDER_BLOCK strategy) or are not transmitted
+ * to that receiver at all (for JET_CHANNEL_QUEUING_RECEIVER_DISCARD).
+ * 
+ * Receivers which are not ready (their partition has been restarted
+ * since port creation) simply miss the messages.
  */
 typedef struct {
     /* Maximum size of single message. Set in deployment.c*/
@@ -88,29 +160,56 @@ typedef struct {
     /* Distance between messages in the array. */
     pok_message_size_t message_stride;
 
-    /* Sides of the channel. */
-    struct pok_channel_queuing_side send, recv;
+    /* Sender side of the channel. */
+    struct pok_channel_queuing_side send;
 
-    pok_message_range_t max_nb_message; // Total buffer capasity.
+    /* Array of receiver sides of the channel. Set in deployment.c. */
+    struct pok_channel_queuing_side* recv;
+    /* Number of receivers. Set in deployment.c. */
+    uint8_t recv_n;
 
-    char* messages; // Array of messages
-    pok_message_size_t* message_sizes; // Array of messages sizes.
+    /* Storage kind. Set in deployment.c. */
+    enum jet_channel_queuing_storage storage;
 
-    /* Border between receiver and sender buffers.
+    /*
+     * Total number of message slots. Used only for slots storage.
      * 
-     * When buffer for a channel side is empty, .next_message field
-     * of the side is equal to that border.
+     * Computed as sum of all sides capacities, so there is always
+     * a free slot when sender has a space in its buffer.
      */
-    pok_message_size_t border;
+    pok_message_range_t max_nb_message;
 
-    /* Overflow strategy for given channel. Set in deployment.c. */
-    enum jet_channel_queuing_overflow_strategy overflow_strategy;
+    char* messages; // Array of message slots or the ring of records.
+    pok_message_size_t* message_sizes; // Array of messages sizes.
+    /* For every slot: number of receivers which still refer to it. */
+    uint8_t* message_refs;
+    /* For every free slot: index of the next free slot. */
+    pok_message_range_t* message_next_free;
     /* 
-     * Flag is set when message is discarded.
-     * Flag is cleared after receiver is notified about that.
+     * First free slot.
+     * 
+     * Equal to `max_nb_message` if there are no free slots.
      */
-    pok_bool_t message_discarded;
+    pok_message_range_t free_first;
+
+    /* 
+     * Size of the ring for packed storage. Set in deployment.c.
+     * 
+     * Rounded up on initialization, so ring accomodates at least
+     * one message of maximum size.
+     */
+    uint32_t max_nb_bytes;
+    /* Number of bytes in the ring occupied by records and padding. */
+    uint32_t nb_bytes;
+    /* Offset of the oldest record in the ring. */
+    uint32_t bytes_tail;
+    /* Offset in the ring where next record will be written. */
+    uint32_t bytes_head;
+    /* Offset of the record returned by pok_channel_queuing_s_get_message(). */
+    uint32_t bytes_reserved;
 
+    /* Overflow strategy for given channel. Set in deployment.c. */
+    enum jet_channel_queuing_overflow_strategy overflow_strategy;
 } pok_channel_queuing_t;
 
 /* 
@@ -120,7 +219,8 @@ typedef struct {
  * 
  *   - max_message_size
  *   - send.max_nb_messages
- *   - recv.max_nb_messages
+ *   - recv_n, recv[].max_nb_messages
+ *   - storage (and max_nb_bytes for packed storage)
  */
 void pok_channel_queuing_init(pok_channel_queuing_t* channel);
 
@@ -128,20 +228,26 @@ void pok_channel_queuing_init(pok_channel_queuing_t* channel);
  * (Re)initialize given side of the channel.
  * 
  * Should be called before all other functions for that side.
+ * 
+ * All messages on the side are dropped.
  */
 void pok_channel_queuing_side_init(pok_channel_queuing_t* channel,
     struct pok_channel_queuing_side* side,
     uint16_t handler_id);
 
 
-/**** Operations for receiver. Should be serialized wrt themselves ****/
-/* (Re)initialize receiver connection to the channel. */
-void pok_channel_queuing_r_init(pok_channel_queuing_t* channel);
+/* 
+ * Operations for receiver. Should be serialized wrt themselves.
+ * 
+ * Receiver is given by its index in the `recv` array.
+ */
 
 /*
  * Return number of messages on the receiver side.
  */
-pok_message_range_t pok_channel_queuing_r_n_messages(pok_channel_queuing_t* channel);
+pok_message_range_t pok_channel_queuing_r_n_messages(
+    pok_channel_queuing_t* channel,
+    uint8_t recv_id);
 
 /* 
  * Return pointer to the first message at receiver side.
@@ -153,24 +259,27 @@ pok_message_range_t pok_channel_queuing_r_n_messages(pok_channel_queuing_t* chan
  */
 const char* pok_channel_queuing_r_get_message(
     pok_channel_queuing_t* channel,
+    uint8_t recv_id,
     pok_message_size_t* size,
     pok_bool_t subscribe);
 
 /* 
  * Consume the first message at receiver side.
  * 
- * Set 'message_discarded' parameter to one in the channel field,
+ * Set 'message_discarded' parameter to one in the receiver's field,
  * and reset the field.
  */
 void pok_channel_queuing_r_consume_message(
     pok_channel_queuing_t* channel,
+    uint8_t recv_id,
     pok_bool_t* message_discarded);
 
 /***** Operations for sender. Should be serialized wrt themselves *****/
 /* 
  * Return pointer to the message for being filled at sender side.
  * 
- * Return NULL if no space is left in the sender buffer.
+ * Return NULL if no space is left in the sender buffer
+ * (or in the ring for packed storage).
  * 
  * If there is no space in the sender buffer and @subscribe parameter
  * is TRUE, subscribe to notifications when the space will be released.
@@ -182,9 +291,9 @@ char* pok_channel_queuing_s_get_message(
 /*
  * Mark (already filled) message as produced.
  * 
- * If possible, the message is sent immediately.
+ * If possible, the message is sent immediately to all receivers.
  * Otherwise it will be automatically sent when there will be sufficient
- * space in the receiver buffer.
+ * space in the receivers buffers.
  */
 void pok_channel_queuing_s_produce_message(
     pok_channel_queuing_t* channel,
@@ -193,21 +302,55 @@ void pok_channel_queuing_s_produce_message(
 /*
  * Return number of messages on the sender side.
  * 
- * NOTE: Returning value is always 0 until receiver is not ready or
- * its buffer is full.
+ * NOTE: Returning value is always 0 until some receiver has
+ * its buffer full.
  */
 pok_message_range_t pok_channel_queuing_s_n_messages(pok_channel_queuing_t* channel);
 
+/*
+ * Account completed wait on the side of the channel.
+ *
+ * 'wait_time' is the time between start of the wait and its completion.
+ */
+void pok_channel_queuing_account_wait(struct pok_channel_queuing_side* side,
+    pok_time_t wait_time);
+
 /*********************** Sampling channel *****************************/
 
+/* Receiver side of the sampling channel. */
+struct pok_channel_sampling_receiver
+{
+    /* Slot with (possibly) currently processed message. */
+    uint8_t read_pos;
+    /* Whether message in `read_pos` slot is cleared for this receiver. */
+    pok_bool_t is_cleared;
+
+    /* Partition corresponded for this receiver. Set in deployment.c */
+    pok_partition_t* part;
+    /* Generation of the receiver when its port has been created. */
+    pok_partition_generation_t generation;
+    /* Whether needs to notify this receiver about new message. */
+    pok_bool_t is_notify;
+    /* Identificator for use in notification event. Set on port creation. */
+    uint16_t handler_id;
+
+    /* Traffic statistics for this receiver. */
+    pok_port_stats_t stats;
+};
+
 /* 
  * Sampling channel.
  * 
- * Receiver has one message slot for (possibly) currently processed
- * message, and one message slot for newest message received.
+ * Channel has single sender and one or more receivers.
+ * 
+ * Every receiver has one message slot for (possibly) currently
+ * processed message. There is one message slot for newest message
+ * received, shared by all receivers.
  * 
  * Sender has one message slot for currently formed message.
  * 
+ * So channel with N receivers has N + 2 message slots.
+ * 
  * Mesages in that channel are transmitted *instantly*.
  * 
  * Actually, ARINC distinguish message which is *sent* or *received*:
@@ -218,18 +361,27 @@ typedef struct {
     pok_message_size_t max_message_size;
     /* Distance between messages in the array. */
     pok_message_size_t message_stride;
-    /* Array of 3 messages. */
+
+    /* Array of receivers. Set in deployment.c. */
+    struct pok_channel_sampling_receiver* recv;
+    /* Number of receivers. Set in deployment.c. */
+    uint8_t recv_n;
+
+    /* Number of message slots (recv_n + 2). */
+    uint8_t nb_slots;
+    /* Array of messages. */
     char* messages;
-    /* Array of message sizes.*/
-    pok_message_size_t message_sizes[3];
+    /* Array of message sizes. 0 means empty slot. */
+    pok_message_size_t* message_sizes;
+    /* The simplest implementation: timestamp per message. */
+    pok_time_t* timestamps;
 
-    // Positions in range 0..2
-    uint8_t read_pos;
+    // Positions in range 0..(nb_slots - 1)
     uint8_t read_pos_next;
     uint8_t write_pos;
 
-    /* The simplest implementation: timestamp per message. */
-    pok_time_t timestamps[3];
+    /* Traffic statistics for the sender. */
+    pok_port_stats_t send_stats;
 } pok_channel_sampling_t;
 
 /* 
@@ -238,6 +390,7 @@ typedef struct {
  * Fields should be set before calling this function:
  * 
  *   - max_message_size
+ *   - recv_n, recv
  */
 void pok_channel_sampling_init(pok_channel_sampling_t* channel);
 
@@ -256,20 +409,47 @@ void pok_channel_sampling_init(pok_channel_sampling_t* channel);
  */
 const char* pok_channel_sampling_r_get_message(
     pok_channel_sampling_t* channel,
+    uint8_t recv_id,
     pok_message_size_t* size,
     pok_time_t* timestamp);
 
 /*
  * Clear message received.
  */
-void pok_channel_sampling_r_clear_message(pok_channel_sampling_t* channel);
+void pok_channel_sampling_r_clear_message(pok_channel_sampling_t* channel,
+    uint8_t recv_id);
+
+/*
+ * Initialize receiver when its port is created.
+ *
+ * Message received is cleared.
+ */
+void pok_channel_sampling_r_init(pok_channel_sampling_t* channel,
+    uint8_t recv_id,
+    uint16_t handler_id);
+
+/*
+ * Return TRUE if new (non-empty) message has been sent since the last
+ * read, without marking it as read.
+ *
+ * Otherwise return FALSE. In that case, if 'subscribe' is non-zero,
+ * receiver partition will be notified with
+ * JET_PARTITION_EVENT_TYPE_PORT_SAMPLING_UPDATED event when new
+ * message is sent.
+ */
+pok_bool_t pok_channel_sampling_r_is_updated(
+    pok_channel_sampling_t* channel,
+    uint8_t recv_id,
+    pok_bool_t subscribe);
 
 /*
  * Return POK_ERRNO_OK if new message has been arrive since we check(read).
  * 
  * Return POK_ERRNO_EMPTY otherwise.
  */
-pok_bool_t pok_channel_sampling_r_check_new_message(pok_channel_sampling_t* channel);
+pok_bool_t pok_channel_sampling_r_check_new_message(
+    pok_channel_sampling_t* channel,
+    uint8_t recv_id);
 
 /***** Operations for sender. Should be serialized wrt themselves *****/
 
@@ -304,7 +484,7 @@ extern pok_channel_queuing_t pok_channels_queuing[];
  * 
  * Should be set in deployment.c.
  */
-extern uint8_t pok_channels_queuing_n;
+extern const uint8_t pok_channels_queuing_n;
 
 /* 
  * Array of sampling channels.
@@ -318,8 +498,27 @@ extern pok_channel_sampling_t pok_channels_sampling[];
  * 
  * Should be set in deployment.c.
  */
-extern uint8_t pok_channels_sampling_n;
+extern const uint8_t pok_channels_sampling_n;
 
 void pok_channels_init_all(void);
 
+/*
+ * Print traffic statistics of all channels in human-readable form.
+ *
+ * Side 0 of the channel is its sender, side 'i' is receiver 'i - 1'.
+ */
+void pok_channels_print_stats(void);
+
+/*
+ * Print traffic statistics of all channels as compact binary dump.
+ *
+ * Every line has format '[CHANNELS] <hex bytes>'. The first line is
+ * a header: magic "JCST", version (2 bytes), record size (2 bytes)
+ * and number of records (4 bytes). Every other line is a record for
+ * one side of the channel. All values are little-endian.
+ *
+ * The dump is decoded with misc/channel_stats.py.
+ */
+void pok_channels_dump_stats(void);
+
 #endif /* __POK_KERNEL_CHANNEL_H__ */
@@ -106,7 +106,7 @@ static inline pok_bool_t pok_error_level_select(
  * 
  * Should be defined in deployment.c.
  */
-extern pok_error_level_selector_t pok_hm_module_selector;
+extern const pok_error_level_selector_t pok_hm_module_selector;
 
 
 typedef uint8_t pok_error_module_action_t;
@@ -135,7 +135,7 @@ typedef struct {
 /*
  * Module HM table. Should be defined in deployment.c.
  */
-extern pok_error_module_action_table_t pok_hm_module_table;
+extern const pok_error_module_action_table_t pok_hm_module_table;
 
 /* 
  * Raise error with given identificator.
@@ -33,5 +33,57 @@
 void jet_loader_elf_load   (uint8_t elf_id,
                                  jet_space_id space_id,
                                  void (** entry)(void));
+
+/* Maximum number of loadable segments remembered in the restart image. */
+#define JET_LOADER_IMAGE_MAX_SEGMENTS 8
+
+/* Loadable segment of the elf, already checked against space's layout. */
+struct jet_loader_segment
+{
+    char* kernel_dest;
+    /* Pristine content of the segment, inside elf archive. */
+    const char* src;
+    /* Maximum number of bytes which may be read from 'src'. */
+    size_t src_size;
+    size_t filesz;
+    size_t memsz;
+    /* Whether segment is writable by the partition. */
+    pok_bool_t is_writable;
+    /* Whether 'src' is compressed with LZ4. */
+    pok_bool_t is_compressed;
+};
+
+/*
+ * Restart image: result of elf parsing, which allows to reload
+ * the space without parsing elf again.
+ */
+struct jet_loader_image
+{
+    /* Whether image is filled. Initially FALSE. */
+    pok_bool_t is_valid;
+    void (*entry)(void);
+
+    int nsegments;
+    struct jet_loader_segment segments[JET_LOADER_IMAGE_MAX_SEGMENTS];
+};
+
+/**
+ * Load elf into given space and fill restart image for it.
+ *
+ * If elf has more than JET_LOADER_IMAGE_MAX_SEGMENTS loadable segments,
+ * image is left invalid.
+ */
+void jet_loader_elf_load_image(uint8_t elf_id,
+                               jet_space_id space_id,
+                               struct jet_loader_image* image);
+
+/**
+ * Reload the space from the valid restart image.
+ *
+ * Read-only segments are left in place. Writable segments are copied
+ * (or decompressed) from their pristine content and their
+ * zero-initialized parts are cleared.
+ */
+void jet_loader_image_restore(const struct jet_loader_image* image);
 #endif /* __JET_LOADER_H__ */
 
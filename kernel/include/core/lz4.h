@@ -0,0 +1,32 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __JET_LZ4_H__
+#define __JET_LZ4_H__
+
+#include <types.h>
+
+/*
+ * Decompress LZ4 block 'src' into 'dest'.
+ *
+ * Exactly 'dest_size' bytes are written into 'dest'.
+ * No more than 'src_size' bytes are read from 'src'.
+ *
+ * Returns FALSE if input is malformed.
+ */
+pok_bool_t jet_lz4_decompress(char* dest, size_t dest_size,
+    const char* src, size_t src_size);
+
+#endif /* __JET_LZ4_H__ */
@@ -35,5 +35,5 @@ struct memory_block {
 };
 
 extern struct memory_block jet_memory_blocks[];
-extern size_t jet_memory_blocks_n;
+extern const size_t jet_memory_blocks_n;
 #endif
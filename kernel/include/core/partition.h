@@ -141,6 +141,8 @@ enum jet_partition_event_type
     JET_PARTITION_EVENT_TYPE_PORT_SEND_AVAILABLE,
     /* Message is available for receive it from the queuing port. */
     JET_PARTITION_EVENT_TYPE_PORT_RECEIVE_AVAILABLE,
+    /* New message has been written into the sampling port. */
+    JET_PARTITION_EVENT_TYPE_PORT_SAMPLING_UPDATED,
 };
 
 /* Outer event for partition. */
@@ -19,6 +19,7 @@
 #include <core/partition.h>
 #include <core/error_arinc.h>
 #include <core/port.h>
+#include <core/loader.h>
 
 #include <uapi/partition_arinc_types.h>
 
@@ -56,6 +57,12 @@ typedef struct _pok_patition_arinc
      * Set in deployment.c. (thread needn't to be initialized there).
      */
     pok_thread_t*          threads;
+    /*
+     * Cold parts of the threads, indexed as @threads.
+     *
+     * Set in deployment.c.
+     */
+    pok_thread_cold_t*     threads_cold;
     uint32_t               nthreads_used;   /**< Number of threads which are currently in use (created). */
 
 
@@ -79,6 +86,16 @@ typedef struct _pok_patition_arinc
      */
     struct msection*        waiting_section;
 
+    uint32_t                lock_level;
+    pok_thread_t*           thread_locked; /* Thread which locks preemption. */
+
+    /**
+     * Priority/FIFO ordered queue of eligible threads.
+     * 
+     * Used only in NORMAL mode.
+     */
+    struct list_head       eligible_threads; 
+
     /* Size of the heap to be allocated. Set in the deployment.c */
     size_t heap_size;
 
@@ -88,6 +105,9 @@ typedef struct _pok_patition_arinc
     pok_port_sampling_t*   ports_sampling; /* List of sampling ports. Set in deployment.c. */
     size_t                 nports_sampling;
 
+    /* Threads which wait in jet_wait_any(). */
+    pok_thread_wq_t        wait_any_waiters;
+
 /* Error and main threads are special in sence that they cannot be reffered by ID.*/
 
 #ifdef POK_NEEDS_ERROR_HANDLING
@@ -136,16 +156,27 @@ typedef struct _pok_patition_arinc
     void                    (*main_entry)(void);
     uint32_t                main_user_stack_size;
 
+    /*
+     * Size of the kernel stack for every thread.
+     *
+     * May be set in deployment.c. 0 means KERNEL_STACK_SIZE_DEFAULT.
+     */
+    uint32_t                kernel_stack_size;
 
-    uint32_t		        lock_level;
-    pok_thread_t*           thread_locked; /* Thread which locks preemption. */
-
-    /**
-     * Priority/FIFO ordered queue of eligible threads.
-     * 
-     * Used only in NORMAL mode.
+    /*
+     * Number of threads which have kernel stack.
+     *
+     * Stacks are allocated during partition initialization for
+     * threads [0; kernel_stacks_n), other threads cannot be created.
+     *
+     * May be set in deployment.c. 0 means nthreads.
      */
-    struct list_head       eligible_threads; 
+    uint32_t                kernel_stacks_n;
+
+    /* Parsed elf of the partition. Filled at the first start. */
+    struct jet_loader_image restart_image;
+    /* Time spent for loading the partition's space at the last start. */
+    pok_time_t              load_duration;
 
     /**
      * Queue of all timed events.
@@ -164,6 +195,19 @@ typedef struct _pok_patition_arinc
 #define current_partition_arinc container_of(current_partition, pok_partition_arinc_t, base_part)
 #define current_thread (current_partition_arinc->thread_current)
 
+/* Return cold part of the thread in the partition. */
+static inline pok_thread_cold_t* pok_thread_cold(pok_partition_arinc_t* part,
+    pok_thread_t* t)
+{
+    return &part->threads_cold[t - part->threads];
+}
+
+/* Whether the thread of the current partition is periodic. */
+static inline pok_bool_t pok_thread_is_periodic(pok_thread_t* t)
+{
+    return !pok_time_is_infinity(pok_thread_cold(current_partition_arinc, t)->period);
+}
+
 /* 
  * Array of ARINC partitions.
  * 
@@ -237,6 +281,14 @@ pok_ret_t pok_current_partition_inc_lock_level(int32_t *lock_level);
 
 pok_ret_t pok_current_partition_dec_lock_level(int32_t *lock_level);
 
+/*
+ * Print memory usage of all ARINC partitions and their threads:
+ * heap, intra-partition memory and high-water marks of the stacks.
+ *
+ * Output is processed by misc/footprint.py.
+ */
+void pok_partitions_arinc_dump_memory(void);
+
 
 /*
  * Raise error about inconsistent state of OS.
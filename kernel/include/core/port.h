@@ -54,6 +54,13 @@ typedef struct
      * Set in the deployment.c.
      */
     pok_port_directions_t       direction;
+
+    /*
+     * For IN port, index of the receiver in the channel.
+     * 
+     * Set in the deployment.c.
+     */
+    uint8_t                     receiver_id;
     
     /*
      * Queuing discipline.
@@ -103,12 +110,39 @@ pok_ret_t pok_port_queuing_status(
     pok_port_id_t               id,
     pok_port_queuing_status_t* __user status);
 
+/*
+ * Copy traffic statistics of the port's side of the channel.
+ *
+ * Counters are cumulative since the system start.
+ */
+pok_ret_t pok_port_queuing_stats(
+    pok_port_id_t               id,
+    pok_port_stats_t* __user    stats);
+
 pok_ret_t pok_port_queuing_id(
     const char* __user name,
     pok_port_id_t* __user id);
 
 pok_ret_t pok_port_queuing_clear(pok_port_id_t id);
 
+/*
+ * Check whether queuing port is ready for wait-any: IN port has a
+ * message for receive and OUT port has space for send.
+ *
+ * If port is not ready and 'subscribe' is non-zero, partition will be
+ * notified when port becomes ready.
+ *
+ * Returns:
+ *
+ *     POK_ERRNO_OK: port is ready.
+ *     POK_ERRNO_EMPTY: port is not ready.
+ *     POK_ERRNO_PORT: port is not created.
+ *
+ * Should be called with local preemption disabled.
+ */
+pok_ret_t pok_port_queuing_check_ready(pok_port_id_t id,
+    pok_bool_t subscribe);
+
 /* 
  * Receive message from the port into specified process.
  * 
@@ -171,6 +205,13 @@ typedef struct
      */
     pok_port_directions_t       direction;
 
+    /*
+     * For IN port, index of the receiver in the channel.
+     * 
+     * Should be set initially.
+     */
+    uint8_t                     receiver_id;
+
     /* Whether port has been created (with CREATE_SAMPLING_PORT)*/
     pok_bool_t                  is_created;
 
@@ -215,6 +256,30 @@ pok_ret_t pok_port_sampling_status (
     pok_port_sampling_status_t __user   *status
 );
 
+/* Same as pok_port_queuing_stats(), but for sampling port. */
+pok_ret_t pok_port_sampling_stats(
+    pok_port_id_t               id,
+    pok_port_stats_t* __user    stats);
+
 pok_ret_t pok_port_sampling_check(pok_port_id_t id);
 
+/*
+ * Check whether IN sampling port is ready for wait-any: new message
+ * has been written since the last read.
+ *
+ * If port is not ready and 'subscribe' is non-zero, partition will be
+ * notified when new message is written.
+ *
+ * Returns:
+ *
+ *     POK_ERRNO_OK: port is ready.
+ *     POK_ERRNO_EMPTY: port is not ready.
+ *     POK_ERRNO_PORT: port is not created.
+ *     POK_ERRNO_DIRECTION: port is not IN one.
+ *
+ * Should be called with local preemption disabled.
+ */
+pok_ret_t pok_port_sampling_check_ready(pok_port_id_t id,
+    pok_bool_t subscribe);
+
 #endif /* __POK_KERNEL_PORT_H__ */
@@ -0,0 +1,76 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __JET_PROFILER_H__
+#define __JET_PROFILER_H__
+
+/*
+ * Statistical PC-sampling profiler.
+ *
+ * Every `jet_profiler_period` timer ticks the interrupted PC is added
+ * to the histogram of the current partition, together with the index
+ * of the current thread. Samples taken while non-ARINC partition
+ * (idle, monitor, gdb) is running go to the kernel histogram.
+ *
+ * Histograms are dumped to the console with `profile` monitor command,
+ * and are processed on the host by misc/profile.py.
+ */
+
+#include <types.h>
+
+/* Index of the thread for samples without current thread. */
+#define JET_PROFILER_THREAD_NONE 0xffff
+
+struct jet_profiler_entry
+{
+    uintptr_t pc;
+    uint32_t count; // 0 for unused entry.
+    uint16_t thread_index;
+    pok_bool_t is_kernel;
+};
+
+struct jet_profiler_histogram
+{
+    /* Hash table of entries. Number of entries is power of 2. */
+    struct jet_profiler_entry* entries;
+    uint32_t mask;
+
+    uint32_t nb_samples;
+    /* Samples which have been dropped because hash table is full. */
+    uint32_t nb_dropped;
+};
+
+/* Number of ticks between samples. 0 disables profiler. Set in deployment.c. */
+extern const uint32_t jet_profiler_period;
+/* Number of entries in every histogram. Set in deployment.c. */
+extern const uint32_t jet_profiler_histogram_size;
+
+/* Allocate histograms. Should be called after ARINC partitions are initialized. */
+void jet_profiler_init(void);
+
+/*
+ * Account timer tick, and sample given PC if it is time for that.
+ *
+ * Called from timer interrupt handler.
+ */
+void jet_profiler_tick(uintptr_t pc, pok_bool_t is_kernel);
+
+/* Print all histograms to the console. */
+void jet_profiler_dump(void);
+
+/* Clear all histograms. */
+void jet_profiler_reset(void);
+
+#endif /* __JET_PROFILER_H__ */
@@ -0,0 +1,142 @@
+/*
+ * GENERATED! DO NOT MODIFY!
+ *
+ * Instead of modifying this file, modify the one it generated from (kernel/include/uapi/syscall_map_arinc.h.in).
+ */
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+
+#include <uapi/types.h>
+#include <uapi/thread_types.h>
+#include <uapi/partition_types.h>
+#include <uapi/partition_arinc_types.h>
+#include <uapi/port_types.h>
+#include <uapi/error_arinc_types.h>
+#include <uapi/memblock_types.h>
+#include <uapi/msection.h>
+#include <uapi/wait_any_types.h>
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_CREATE, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+#ifdef POK_NEEDS_THREAD_SLEEP
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SLEEP, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+#endif
+
+#ifdef POK_NEEDS_THREAD_SLEEP_UNTIL
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SLEEP_UNTIL, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+#endif
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_PERIOD, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+#if defined (POK_NEEDS_THREAD_SUSPEND) || defined (POK_NEEDS_ERROR_HANDLING)
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SUSPEND, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+#endif
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_STATUS, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_DELAYED_START, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SET_PRIORITY, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_RESUME, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_SUSPEND_TARGET, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_YIELD, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_REPLENISH, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_STOP, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_STOPSELF, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_THREAD_FIND, JET_SYSCALL_FLAG_READONLY)
+
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_RESCHED, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_ENTER_HELPER, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_WAIT, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_NOTIFY, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_WQ_NOTIFY, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MSECTION_WQ_SIZE, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_WAIT_ANY, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_WAIT_ANY_KICK, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+
+#ifdef POK_NEEDS_PARTITIONS
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_SET_MODE, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_GET_STATUS, JET_SYSCALL_FLAG_READONLY)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_INC_LOCK_LEVEL, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_PARTITION_DEC_LOCK_LEVEL, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+#endif
+
+
+#ifdef POK_NEEDS_ERROR_HANDLING
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_ERROR_HANDLER_CREATE, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_ERROR_RAISE_APPLICATION_ERROR, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_ERROR_GET, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+#endif
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_ERROR_RAISE_OS_ERROR, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+
+   /* Middleware syscalls */
+#ifdef POK_NEEDS_PORTS_SAMPLING
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_CREATE, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_WRITE, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_READ, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_ID, JET_SYSCALL_FLAG_READONLY)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_STATUS, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_CHECK, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_SAMPLING_STATS, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+#endif /* POK_NEEDS_PORTS_SAMPLING */
+
+#ifdef POK_NEEDS_PORTS_QUEUEING
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CREATE, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_SEND, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_RECEIVE, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_ID, JET_SYSCALL_FLAG_READONLY)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_STATUS, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MIDDLEWARE_QUEUEING_STATS, JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER)
+
+#endif /* POK_NEEDS_PORTS_QUEUEING */
+
+
+SYSCALL_TABLE_ENTRY(POK_SYSCALL_MEMORY_BLOCK_GET_STATUS, JET_SYSCALL_FLAG_READONLY)
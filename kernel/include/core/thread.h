@@ -36,6 +36,7 @@
 #include <list.h>
 
 #include <asp/cswitch.h>
+#include <asp/arch.h>
 
 #include <core/space.h>
 
@@ -99,15 +100,21 @@ typedef uint8_t pok_thread_error_bits_t;
 
 #endif /* POK_NEEDS_ERROR_HANDLING */
 
+/*
+ * Thread (ARINC process).
+ *
+ * Fields are ordered by access frequency: fields used on every
+ * scheduling decision and context switch come first, so scanning
+ * 'eligible_threads' or wait queues touches as few cache lines
+ * as possible.
+ *
+ * Attributes and fields which are used only on process creation,
+ * start, periodic release, deadline processing and waiting on ports
+ * are stored separately, see pok_thread_cold_t.
+ */
 typedef struct _pok_thread
 {
-    /*
-     * The priority given at process creation.
-     * 
-     * Final after create_process().
-     */
-    uint8_t             base_priority;
-
+    /* ------------------- Hot fields ---------------------------- */
     /*
      * Current priority (can be adjusted with SET_PRIORITY).
      *
@@ -116,59 +123,36 @@ typedef struct _pok_thread
     uint8_t             priority;
 
     /*
-     * If process is periodic, this is (positive) process's period.
-     * If process aperiodic, this is POK_TIME_INFINITY.
-     * 
-     * Final after create_process().
-     */
-    pok_time_t          period;
-
-    /*
-     * Deadline type (soft or hard).
-     * 
-     * As per ARINC-653, it's only used only by error handling process,
-     * and the interpretation is up to programmer.
-     */
-    pok_deadline_t      deadline;
-
-    /*
-     * If process has time is limited, this is (positive) time capacity.
-     * Otherwise this is POK_TIME_INFINITY.
-     *
-     * Final after create_process().
+     * Process state.
      */
-    pok_time_t          time_capacity;
+    pok_state_t         state;
 
     /*
-     * Deadline event (called DEADLINE_TIME in ARINC-653).
+     * The flag is set if process is suspended.
      *
-     * When this time hits, HM event is generated (error handling),
-     * and process becomes... TODO what it becomes?
+     * It cannot be implemented as a separate state because
+     * process can be suspended in any state, and it must return
+     * to that state when it's resumed.
      *
-     * Empty list if the process (currently) has no deadline.
-     */
-    struct delayed_event thread_deadline_event;
-
-    /* 
-     * Any other event delayed for a time.
-     * 
-     * Empty list if the process currently has no delayed event.
+     * If suspension was implemented with states, it would require
+     * something like "state stack", which would be overkill.
      */
-    struct delayed_event thread_delayed_event;
+    pok_bool_t          suspended;
 
-    /* When process is started in INIT_* mode, it sets this field
-     * to the delay.
+    /**
+     * If wait queue uses priority/FIFO order, this field stores
+     * priority at the moment when thread has been added to the queue.
      * 
-     * TODO: This field can be combined(union) with @thread_delayed_event.
+     * Used only in conjunction with @wait_elem.
      */
-    pok_time_t delayed_time;
+    uint8_t wait_priority;
 
-    /* 
-     * Function, processing delayed event in @thread_deadline_event.
+    /**
+     *  Linkage in the `eligible_threads` in partition.
      * 
-     * Used only in conjunction with that field.
+     * If the process is not eligible, then empty list.
      */
-    void (*thread_delayed_func)(struct _pok_thread* t);
+    struct list_head       eligible_elem;
 
     /**
      * Element in the wait queue on some object.
@@ -177,32 +161,34 @@ typedef struct _pok_thread
      */
     struct list_head       wait_elem;
 
-    /**
-     * If wait queue uses priority/FIFO order, this field stores
-     * priority at the moment when thread has been added to the queue.
-     * 
-     * Used only in conjunction with @wait_elem.
+    /*
+     * Kernel stack address.
+     *
+     * It's used to implement context switch.
+     *
+     * It's initially set in pok_thread_create,
+     * and updated by pok_context_switch.
+     *
      */
-    uint8_t wait_priority;
+    struct jet_context*	        sp;
 
-    /**
-     * If wait on queuing port, this is pointer to the message which
-     * should be sent/received from it.
-     * 
-     * Used only in conjunction with @wait_elem.
+    /*
+     * Pointer to area for save floating point registers for given thread.
+     * It is allocated at partition's initialization.
      */
-    union {
-        const void* src;
-        void* dest;
-    } wait_buffer;
 
-    /**
-     * If wait on port, this is length of the message.
-     * This is OUT parameter for receive port and IN - for send port.
+    struct jet_fp_store*    fp_store;
+
+    /*
+     * If preempted process entering the msection, it is a pointer to it.
      * 
-     * Used only in conjunction with @wait_elem.
+     * Otherwise NULL.
+     * 
+     * When process continues to execute, it enters msection automatically.
+     * 
+     * This field is also set when the process waits via 'msection_wait()'.
      */
-    size_t wait_len;
+    struct msection* __kuser msection_entering;
 
     /**
      * If wait on something, here will be stored result of this wait.
@@ -226,34 +212,6 @@ typedef struct _pok_thread
      */
     uint64_t            next_activation;
 
-    /*
-     * Process state.
-     */
-    pok_state_t         state;
-
-    /*
-     * The flag is set if process is suspended.
-     *
-     * It cannot be implemented as a separate state because
-     * process can be suspended in any state, and it must return
-     * to that state when it's resumed.
-     *
-     * If suspension was implemented with states, it would require
-     * something like "state stack", which would be overkill.
-     */
-    pok_bool_t          suspended;
-
-    /*
-     * If preempted process entering the msection, it is a pointer to it.
-     * 
-     * Otherwise NULL.
-     * 
-     * When process continues to execute, it enters msection automatically.
-     * 
-     * This field is also set when the process waits via 'msection_wait()'.
-     */
-    struct msection* __kuser msection_entering;
-
     /*
      * Relations between callers and targets of STOP() function.
      * 
@@ -311,23 +269,13 @@ typedef struct _pok_thread
         struct _pok_thread* donate_target;
     } relations_stop;
 
+    /* ------------------- Other fields -------------------------- */
     /*
-     * Process entry point.
+     * The priority given at process creation.
      * 
      * Final after create_process().
      */
-    void* __user        entry;
-
-    /*
-     * Kernel stack address.
-     *
-     * It's used to implement context switch.
-     *
-     * It's initially set in pok_thread_create,
-     * and updated by pok_context_switch.
-     *
-     */
-    struct jet_context*	        sp;
+    uint8_t             base_priority;
 
     /*
      * Initial value of kernel stack (when it was allocated).
@@ -338,59 +286,145 @@ typedef struct _pok_thread
      */
     jet_stack_t         initial_sp;
 
+    // Whether thread is in unrecoverable error state.
+    pok_bool_t is_unrecoverable;
+
+#ifdef POK_NEEDS_ERROR_HANDLING
+    struct list_head       error_elem;       /** Linkage for partition's `.error_list`. */
+    pok_thread_error_bits_t error_bits;
+#endif
+
+#ifdef POK_NEEDS_GDB
     /*
-     * Pointer to area for save floating point registers for given thread.
-     * It is allocated at partition's initialization.
+     * Interrupt context where all user space registers have been saved.
+     * 
+     * If user space has never been called yet, this is 0.
      */
+    struct jet_interrupt_context* entry_sp_user;
+#endif /* POK_NEEDS_GDB */
+} pok_thread_t;
 
-    struct jet_fp_store*    fp_store;
+/*
+ * Cold part of the thread: attributes set on process creation and
+ * fields used only on process start, periodic release, deadline
+ * processing and waiting on ports.
+ *
+ * Partition stores these structures in a separate array, with the same
+ * indices as the array of threads. See pok_thread_cold().
+ */
+typedef struct
+{
+    /*
+     * If process is periodic, this is (positive) process's period.
+     * If process aperiodic, this is POK_TIME_INFINITY.
+     * 
+     * Final after create_process().
+     */
+    pok_time_t          period;
 
     /*
-     * ???
-     *
-     * Apparently, it's initial virtual address of user stack.
+     * If process has time is limited, this is (positive) time capacity.
+     * Otherwise this is POK_TIME_INFINITY.
      *
-     * It's supposed to be used when thread is restarted (I think).
-     * 
      * Final after create_process().
      */
-    jet_ustack_t        init_stack_addr;
+    pok_time_t          time_capacity;
 
     /*
-     * Size of the user space stack.
+     * Deadline event (called DEADLINE_TIME in ARINC-653).
+     *
+     * When this time hits, HM event is generated (error handling),
+     * and process becomes... TODO what it becomes?
+     *
+     * Empty list if the process (currently) has no deadline.
      */
-    uint32_t            user_stack_size;
+    struct delayed_event thread_deadline_event;
+
+    /* 
+     * Any other event delayed for a time.
+     * 
+     * Empty list if the process currently has no delayed event.
+     */
+    struct delayed_event thread_delayed_event;
+
+    /* When process is started in INIT_* mode, it sets this field
+     * to the delay.
+     * 
+     * TODO: This field can be combined(union) with @thread_delayed_event.
+     */
+    pok_time_t delayed_time;
+
+    /* 
+     * Function, processing delayed event in @thread_deadline_event.
+     * 
+     * Used only in conjunction with that field.
+     */
+    void (*thread_delayed_func)(struct _pok_thread* t);
 
     /**
-     *  Linkage in the `eligible_threads` in partition.
+     * If wait on queuing port, this is pointer to the message which
+     * should be sent/received from it.
      * 
-     * If the process is not eligible, then empty list.
+     * Used only in conjunction with @wait_elem.
      */
-    struct list_head       eligible_elem;
+    union {
+        const void* src;
+        void* dest;
+    } wait_buffer;
 
-#ifdef POK_NEEDS_ERROR_HANDLING
-    struct list_head       error_elem;       /** Linkage for partition's `.error_list`. */
-    pok_thread_error_bits_t error_bits;
-#endif
+    /**
+     * If wait on port, this is length of the message.
+     * This is OUT parameter for receive port and IN - for send port.
+     * 
+     * Used only in conjunction with @wait_elem.
+     */
+    size_t wait_len;
 
-    // Whether thread is in unrecoverable error state.
-    pok_bool_t is_unrecoverable;
+    /**
+     * If wait on port, this is the time when waiting has been started.
+     *
+     * Used only in conjunction with @wait_elem.
+     */
+    pok_time_t wait_start;
 
-#ifdef POK_NEEDS_GDB
     /*
-     * Interrupt context where all user space registers have been saved.
+     * Deadline type (soft or hard).
      * 
-     * If user space has never been called yet, this is 0.
+     * As per ARINC-653, it's only used only by error handling process,
+     * and the interpretation is up to programmer.
      */
-    struct jet_interrupt_context* entry_sp_user;
-#endif /* POK_NEEDS_GDB */
+    pok_deadline_t      deadline;
+
+    /*
+     * Process entry point.
+     * 
+     * Final after create_process().
+     */
+    void* __user        entry;
+
+    /*
+     * ???
+     *
+     * Apparently, it's initial virtual address of user stack.
+     *
+     * It's supposed to be used when thread is restarted (I think).
+     * 
+     * Final after create_process().
+     */
+    jet_ustack_t        init_stack_addr;
+
+    /*
+     * Size of the user space stack.
+     */
+    uint32_t            user_stack_size;
+
     /* 
      * Name of the process.
      * 
      * Empty ("") name means that process is not created.
      */
     char 		    name [MAX_NAME_LENGTH];
-} pok_thread_t;
+} pok_thread_cold_t;
 
 /**
  * Queue of threads, waited for specific event.
@@ -461,12 +495,6 @@ int pok_thread_wq_get_nwaits(pok_thread_wq_t* wq);
 pok_bool_t pok_thread_wq_is_empty(pok_thread_wq_t* wq);
 
 // macro-like utitility functions
-static inline
-pok_bool_t pok_thread_is_periodic(const pok_thread_t *thread)
-{
-    return !pok_time_is_infinity(thread->period);
-}
-
 static inline
 pok_bool_t pok_thread_is_runnable(const pok_thread_t *thread)
 {
@@ -25,6 +25,7 @@
 
 #include <uapi/time.h>
 #include <asp/time.h>
+#include <asp/space.h>
 
 /**
  * The rate of the clock in POK
@@ -41,4 +42,11 @@ pok_ret_t pok_clock_gettime (clockid_t clk_id, pok_time_t* __user val);
 
 pok_ret_t jet_time(time_t* __user val);
 
+/*
+ * Update time page in the kernel shared data of given space.
+ *
+ * Should be called with local preemption disabled.
+ */
+void jet_time_publish(jet_space_id space_id);
+
 #endif  /* __POK_TIME_H__ */
@@ -0,0 +1,49 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __JET_KERNEL_CORE_WAIT_ANY_H__
+#define __JET_KERNEL_CORE_WAIT_ANY_H__
+
+/*
+ * Waiting on the set of objects (wait-any).
+ *
+ * Thread calls jet_wait_any() with array of objects and waits until
+ * any of them becomes ready. Objects are not consumed: after the
+ * call returns, the thread should perform normal operation
+ * (receive from the port, wait on the event, etc.) with zero timeout.
+ *
+ * Waiting threads are stored in partition's 'wait_any_waiters' queue.
+ * For every waiting thread:
+ *
+ *  - t->wait_buffer.src points to the array of objects (kernel address),
+ *  - t->wait_len is number of objects; after the thread is awoken it
+ *    is an index of the ready object.
+ */
+
+#include <types.h>
+#include <errno.h>
+
+/*
+ * Recheck objects waited by the partition's threads, and awoke threads
+ * for which some object is ready.
+ *
+ * Called when partition receives notification about port, or when
+ * user space requests that with jet_wait_any_kick().
+ *
+ * Should be called with local preemption disabled.
+ */
+void jet_wait_any_recheck(void);
+
+#endif /* __JET_KERNEL_CORE_WAIT_ANY_H__ */
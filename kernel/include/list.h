@@ -192,6 +192,19 @@ static inline int list_empty(const struct list_head *head)
              &pos->member != (head);                                    \
              pos = list_next_entry(pos, member))
 
+/**
+ * list_for_each_entry_safe - iterate over list of given type safe against removal of list entry
+ * @pos:        the type * to use as a loop cursor.
+ * @n:          another type * to use as temporary storage
+ * @head:       the head for your list.
+ * @member:     the name of the list_head within the struct.
+ */
+#define list_for_each_entry_safe(pos, n, head, member)                  \
+        for (pos = list_first_entry(head, typeof(*pos), member),        \
+                n = list_next_entry(pos, member);                       \
+             &pos->member != (head);                                    \
+             pos = n, n = list_next_entry(n, member))
+
 /*
  * There are more macros in Linux kernel sources `include/linux/list.h`.
  * If some missed macro is needed, feel free to copy it from there.
@@ -27,6 +27,7 @@
 #include <uapi/error_arinc_types.h>
 #include <uapi/memblock_types.h>
 #include <uapi/msection.h>
+#include <uapi/wait_any_types.h>
 
 pok_ret_t pok_thread_create(const char* __user name,
     void* __user entry,
@@ -207,6 +208,25 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MSECTION_WQ_SIZE(const p
         (size_t* __user)args->arg3);
 }
 
+pok_ret_t jet_wait_any(const jet_wait_any_object_t* __user objects,
+    size_t n,
+    const pok_time_t* __user timeout,
+    size_t* __user ready_index);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_WAIT_ANY(const pok_syscall_args_t* args)
+{
+    return jet_wait_any(
+        (const jet_wait_any_object_t* __user)args->arg1,
+        (size_t)args->arg2,
+        (const pok_time_t* __user)args->arg3,
+        (size_t* __user)args->arg4);
+}
+
+pok_ret_t jet_wait_any_kick(void);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_WAIT_ANY_KICK(const pok_syscall_args_t* args)
+{
+    return jet_wait_any_kick();
+}
+
 
 #ifdef POK_NEEDS_PARTITIONS
 pok_ret_t pok_partition_set_mode_current(pok_partition_mode_t mode);
@@ -343,6 +363,15 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_CHEC
     return pok_port_sampling_check(
         (pok_port_id_t)args->arg1);
 }
+
+pok_ret_t pok_port_sampling_stats(pok_port_id_t id,
+    pok_port_stats_t* __user stats);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_SAMPLING_STATS(const pok_syscall_args_t* args)
+{
+    return pok_port_sampling_stats(
+        (pok_port_id_t)args->arg1,
+        (pok_port_stats_t* __user)args->arg2);
+}
 #endif /* POK_NEEDS_PORTS_SAMPLING */
 
 #ifdef POK_NEEDS_PORTS_QUEUEING
@@ -408,6 +437,15 @@ static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEA
         (pok_port_id_t)args->arg1);
 }
 
+pok_ret_t pok_port_queuing_stats(pok_port_id_t id,
+    pok_port_stats_t* __user stats);
+static inline pok_ret_t pok_syscall_wrapper_POK_SYSCALL_MIDDLEWARE_QUEUEING_STATS(const pok_syscall_args_t* args)
+{
+    return pok_port_queuing_stats(
+        (pok_port_id_t)args->arg1,
+        (pok_port_stats_t* __user)args->arg2);
+}
+
 #endif /* POK_NEEDS_PORTS_QUEUEING */
 
 
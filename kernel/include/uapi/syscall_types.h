@@ -55,6 +55,8 @@ typedef enum
      POK_SYSCALL_MSECTION_NOTIFY                     =  83,
      POK_SYSCALL_MSECTION_WQ_NOTIFY                  =  84,
      POK_SYSCALL_MSECTION_WQ_SIZE                    =  85,
+     POK_SYSCALL_WAIT_ANY                            =  86,
+     POK_SYSCALL_WAIT_ANY_KICK                       =  87,
 
 #ifdef POK_NEEDS_PORTS_SAMPLING
      POK_SYSCALL_MIDDLEWARE_SAMPLING_ID              = 101,
@@ -63,6 +65,7 @@ typedef enum
      POK_SYSCALL_MIDDLEWARE_SAMPLING_WRITE           = 104,
      POK_SYSCALL_MIDDLEWARE_SAMPLING_CREATE          = 105,
      POK_SYSCALL_MIDDLEWARE_SAMPLING_CHECK           = 106,
+     POK_SYSCALL_MIDDLEWARE_SAMPLING_STATS           = 107,
 #endif
 #ifdef POK_NEEDS_PORTS_QUEUEING
      POK_SYSCALL_MIDDLEWARE_QUEUEING_CREATE          = 110,
@@ -71,6 +74,7 @@ typedef enum
      POK_SYSCALL_MIDDLEWARE_QUEUEING_ID              = 113,
      POK_SYSCALL_MIDDLEWARE_QUEUEING_STATUS          = 114,
      POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR           = 115,
+     POK_SYSCALL_MIDDLEWARE_QUEUEING_STATS           = 116,
 #endif
 
 #ifdef POK_NEEDS_ERROR_HANDLING
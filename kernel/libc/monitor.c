@@ -18,7 +18,10 @@
 
 #include <libc.h>
 #include <asp/arch.h>
+#include <asp/space.h>
 #include <core/partition_arinc.h>
+#include <core/profiler.h>
+#include <core/channel.h>
 #include <cons.h>
 
 
@@ -98,6 +101,18 @@ int cpu_reset(int argc, char **argv); //cpu reset
 
 int info_partition(int argc,char ** argv);
 
+int profile(int argc, char **argv); // dump profiler histograms
+
+int profile_reset(int argc, char **argv); // clear profiler histograms
+
+int channels(int argc, char **argv); // print channels statistics
+
+int channels_dump(int argc, char **argv); // dump channels statistics
+
+int memory(int argc, char **argv); // dump memory footprint
+
+int spaces(int argc, char **argv); // print address translation statistics
+
 struct Command {
     const char *name;
     const char *argc;
@@ -114,6 +129,12 @@ static struct Command commands[] = {
     {"resume", "/N/" ,"Continue partition N",resume_N},
     {"restart", "/N/" ,"Restart partition N",restart_N},
     {"reset", "" ,"reset cpu", cpu_reset},
+    {"profile", "" ,"Dump profiler histograms",profile},
+    {"profile_reset", "" ,"Clear profiler histograms",profile_reset},
+    {"channels", "" ,"Display traffic statistics of channels",channels},
+    {"channels_dump", "" ,"Dump traffic statistics of channels",channels_dump},
+    {"memory", "" ,"Dump memory usage of partitions",memory},
+    {"spaces", "" ,"Display TLB statistics of memory spaces",spaces},
     {"exit", "" ,"Exit from console",exit_from_monitor},
 };
 
@@ -217,6 +238,8 @@ int info_partition(int argc,char **argv){
     printf("prev_thread = %u\n", part->lock_level ? (unsigned)(part->thread_locked - part->threads) : (unsigned)-1);
     printf("current_thread = %u\n", (unsigned)(part->thread_current - part->threads));
     printf("thread_main = %u\n", POK_PARTITION_ARINC_MAIN_THREAD_ID);
+    printf("load_duration = %lu us\n", (unsigned long)(part->load_duration / 1000));
+    printf("restart_image = %s\n", part->restart_image.is_valid ? "valid" : "none");
 #ifdef POK_NEEDS_IO
     //printf("io_min = %d\n",pok_partitions[number].io_min);        
     //printf("io_max = %d\n",pok_partitions[number].io_max);        
@@ -320,6 +343,60 @@ int cpu_reset(int argc, char **argv)
     return 0;
 }
 
+int profile(int argc, char **argv)
+{
+    (void) argc;
+    (void) argv;
+    jet_profiler_dump();
+
+    return 0;
+}
+
+int profile_reset(int argc, char **argv)
+{
+    (void) argc;
+    (void) argv;
+    jet_profiler_reset();
+
+    return 0;
+}
+
+int channels(int argc, char **argv)
+{
+    (void) argc;
+    (void) argv;
+    pok_channels_print_stats();
+
+    return 0;
+}
+
+int channels_dump(int argc, char **argv)
+{
+    (void) argc;
+    (void) argv;
+    pok_channels_dump_stats();
+
+    return 0;
+}
+
+int spaces(int argc, char **argv)
+{
+    (void) argc;
+    (void) argv;
+    ja_space_print_stats();
+
+    return 0;
+}
+
+int memory(int argc, char **argv)
+{
+    (void) argc;
+    (void) argv;
+    pok_partitions_arinc_dump_memory();
+
+    return 0;
+}
+
 
 
 /*
@@ -0,0 +1,40 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <asp/time.h>
+
+/* Timebase registers, which are readable in user mode. */
+#define SPRN_TBRL 268
+#define SPRN_TBRU 269
+
+#define __stringify_1(x) #x
+#define __stringify(x) __stringify_1(x)
+
+#define mfspr(rn) ({unsigned long rval; \
+    asm volatile("mfspr %0," __stringify(rn) \
+        : "=r" (rval)); rval;})
+
+uint64_t lja_timebase(void)
+{
+    while (1) {
+        uint32_t upper = mfspr(SPRN_TBRU);
+        uint32_t lower = mfspr(SPRN_TBRL);
+
+        // Lower part may overflow between reads.
+        if (upper == mfspr(SPRN_TBRU)) {
+            return (((uint64_t) upper) << 32) | lower;
+        }
+    }
+}
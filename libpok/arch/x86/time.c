@@ -0,0 +1,29 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <asp/time.h>
+
+/*
+ * Kernel doesn't publish timebase parameters on x86, so this
+ * function is never called for computing system time.
+ */
+uint64_t lja_timebase(void)
+{
+    uint32_t lower, upper;
+
+    asm volatile("rdtsc" : "=a" (lower), "=d" (upper));
+
+    return (((uint64_t) upper) << 32) | lower;
+}
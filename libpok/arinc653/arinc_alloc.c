@@ -17,6 +17,7 @@
 #if defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD)
 
 #include <arinc_config.h>
+#include <kernel_shared_data.h>
 #include <utils.h>
 
 size_t arinc_intra_heap_size_current = 0;
@@ -35,6 +36,8 @@ void* arinc_alloc(size_t size, size_t alignment)
     if(size_end > arinc_config_messages_memory_size) return NULL;
 
     arinc_intra_heap_size_current = size_end;
+    // Allocations may be reverted, so the peak usage is reported.
+    if(kshd.intra_used < size_end) kshd.intra_used = size_end;
 
     return arinc_intra_heap + size_start;
 }
@@ -0,0 +1,52 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBJET_ARINC_WAIT_ANY_H__
+#define __LIBJET_ARINC_WAIT_ANY_H__
+
+#include <config.h>
+#include <arinc653/types.h>
+#include <kernel_shared_data.h>
+#include <core/syscall.h>
+
+/*
+ * Intra-partition objects are waited by the kernel via counters:
+ * object is ready when its counter is positive.
+ */
+
+/*
+ * Should be called after counter of some object becomes positive
+ * (outside of the object's msection).
+ */
+static inline void arinc_wait_any_notify(void)
+{
+    if(kshd.wait_any_pending)
+        jet_wait_any_kick();
+}
+
+/* Return counter for the object or NULL if identificator is incorrect. */
+#ifdef POK_NEEDS_ARINC653_BUFFER
+const int32_t* arinc_buffer_wait_any_counter(APEX_INTEGER buffer_id);
+#endif
+
+#ifdef POK_NEEDS_ARINC653_EVENT
+const int32_t* arinc_event_wait_any_counter(APEX_INTEGER event_id);
+#endif
+
+#ifdef POK_NEEDS_ARINC653_SEMAPHORE
+const int32_t* arinc_semaphore_wait_any_counter(APEX_INTEGER semaphore_id);
+#endif
+
+#endif /* __LIBJET_ARINC_WAIT_ANY_H__ */
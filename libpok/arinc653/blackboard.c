@@ -27,6 +27,7 @@
 #include <core/assert_os.h>
 
 #include <string.h>
+#include <seqcell.h>
 #include "arinc_alloc.h"
 #include <arinc_config.h>
 #include "arinc_process_queue.h"
@@ -46,6 +47,48 @@ static struct arinc_blackboard* find_blackboard(const char* name)
    return NULL;
 }
 
+/*
+ * Publish new version of the blackboard's message.
+ *
+ * LENGTH 0 clears the blackboard.
+ *
+ * Should be called with the section taken.
+ */
+static void blackboard_publish(struct arinc_blackboard* blackboard,
+   MESSAGE_ADDR_TYPE MESSAGE_ADDR, MESSAGE_SIZE_TYPE LENGTH)
+{
+   uint32_t n = seqcell_write_begin(&blackboard->version, &blackboard->started);
+
+   if(LENGTH > 0)
+      memcpy(blackboard->message[n & 1], MESSAGE_ADDR, LENGTH);
+   blackboard->message_size[n & 1] = LENGTH;
+
+   seqcell_write_end(&blackboard->version, n);
+}
+
+/*
+ * Copy current message from the blackboard without taking the section.
+ *
+ * Return length of the message, or 0 if the blackboard is empty.
+ */
+static MESSAGE_SIZE_TYPE blackboard_read(struct arinc_blackboard* blackboard,
+   MESSAGE_ADDR_TYPE MESSAGE_ADDR)
+{
+   uint32_t n;
+   MESSAGE_SIZE_TYPE len;
+
+   do {
+      n = seqcell_read_begin(&blackboard->version);
+
+      len = blackboard->message_size[n & 1];
+      // Size may be torn by the writer; it is checked by seqcell_read_retry().
+      if(len > 0 && len <= blackboard->max_message_size)
+         memcpy(MESSAGE_ADDR, blackboard->message[n & 1], len);
+   } while(seqcell_read_retry(&blackboard->started, n));
+
+   return len;
+}
+
 
 void CREATE_BLACKBOARD (
        /*in */ BLACKBOARD_NAME_TYPE     BLACKBOARD_NAME,
@@ -81,18 +124,25 @@ void CREATE_BLACKBOARD (
 
    blackboard->max_message_size = MAX_MESSAGE_SIZE;
 
+   arinc_allocator_state astate = arinc_allocator_get_state();
+
    // Optimize message for copiing.
-   blackboard->message = arinc_alloc(blackboard->max_message_size, __alignof__(int));
+   blackboard->message[0] = arinc_alloc(blackboard->max_message_size, __alignof__(int));
+   blackboard->message[1] = arinc_alloc(blackboard->max_message_size, __alignof__(int));
 
-   if(blackboard->message == NULL)
+   if(blackboard->message[0] == NULL || blackboard->message[1] == NULL)
    {
       // Failed to allocate message.
+      arinc_allocator_reset_state(astate);
       *RETURN_CODE = INVALID_CONFIG;
       return;
    }
 
    memcpy(blackboard->blackboard_name, BLACKBOARD_NAME, MAX_NAME_LENGTH);
-   blackboard->message_size = 0;
+   blackboard->message_size[0] = 0;
+   blackboard->message_size[1] = 0;
+   blackboard->version = 0;
+   blackboard->started = 0;
    msection_init(&blackboard->section);
    msection_wq_init(&blackboard->process_queue);
 
@@ -125,8 +175,7 @@ void DISPLAY_BLACKBOARD (
 
    msection_enter(&blackboard->section);
 
-   memcpy(blackboard->message, MESSAGE_ADDR, LENGTH);
-   blackboard->message_size = LENGTH;
+   blackboard_publish(blackboard, MESSAGE_ADDR, LENGTH);
 
    if(msection_wq_notify(&blackboard->section, &blackboard->process_queue, TRUE)
       == POK_ERRNO_OK) {
@@ -136,8 +185,8 @@ void DISPLAY_BLACKBOARD (
 
       do {
          char* w_dest = kshd.tshd[t].wq_buffer.dst;
-         memcpy(w_dest, blackboard->message, blackboard->message_size);
-         kshd.tshd[t].wq_len = blackboard->message_size;
+         memcpy(w_dest, MESSAGE_ADDR, LENGTH);
+         kshd.tshd[t].wq_len = LENGTH;
 
          msection_wq_del(&blackboard->process_queue, t);
 
@@ -163,20 +212,34 @@ void READ_BLACKBOARD (
    }
 
    struct arinc_blackboard* blackboard = &arinc_blackboards[BLACKBOARD_ID - 1];
+   MESSAGE_SIZE_TYPE len;
 
-   msection_enter(&blackboard->section);
-
-   if(blackboard->message_size > 0) {
-      // There is a message in the blackboard.
-      memcpy(MESSAGE_ADDR, blackboard->message, blackboard->message_size);
-      *LENGTH = blackboard->message_size;
+   // Fast path: there is a message in the blackboard.
+   len = blackboard_read(blackboard, MESSAGE_ADDR);
+   if(len > 0) {
+      *LENGTH = len;
       *RETURN_CODE = NO_ERROR;
+      return;
    }
-   else if(TIME_OUT == 0)
+
+   if(TIME_OUT == 0)
    {
       // There is no message in blackboard but waiting is not requested.
       *LENGTH = 0;
       *RETURN_CODE = NOT_AVAILABLE;
+      return;
+   }
+
+   msection_enter(&blackboard->section);
+
+   // Message could be displayed before we have entered the section.
+   len = blackboard->message_size[blackboard->version & 1];
+
+   if(len > 0) {
+      // There is a message in the blackboard.
+      memcpy(MESSAGE_ADDR, blackboard->message[blackboard->version & 1], len);
+      *LENGTH = len;
+      *RETURN_CODE = NO_ERROR;
    }
    else {
       // Blackboard is empty and waiting is *requested* by the caller.
@@ -234,7 +297,8 @@ void CLEAR_BLACKBOARD (
    struct arinc_blackboard* blackboard = &arinc_blackboards[BLACKBOARD_ID - 1];
 
    msection_enter(&blackboard->section);
-   blackboard->message_size = 0;
+   if(blackboard->message_size[blackboard->version & 1] != 0)
+      blackboard_publish(blackboard, NULL, 0);
    msection_leave(&blackboard->section);
 
    *RETURN_CODE = NO_ERROR;
@@ -272,7 +336,8 @@ void GET_BLACKBOARD_STATUS (
    BLACKBOARD_STATUS->MAX_MESSAGE_SIZE = blackboard->max_message_size;
 
    msection_enter(&blackboard->section);
-   BLACKBOARD_STATUS->EMPTY_INDICATOR = (blackboard->message_size == 0)
+   BLACKBOARD_STATUS->EMPTY_INDICATOR =
+      (blackboard->message_size[blackboard->version & 1] == 0)
       ? EMPTY: OCCUPIED;
    BLACKBOARD_STATUS->WAITING_PROCESSES =
       msection_wq_size(&blackboard->section, &blackboard->process_queue);
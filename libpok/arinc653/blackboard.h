@@ -24,14 +24,24 @@
 #include <msection.h>
 #include <types.h>
 
+/* 
+ * Blackboard is double-buffered, so readers do not take the section.
+ * 
+ * Message is protected by double-buffered sequence lock (see seqcell.h):
+ * version 'n' of the blackboard is stored in the slot 'n & 1'. Writer
+ * updates the blackboard with the section taken.
+ */
 struct arinc_blackboard
 {
     BLACKBOARD_NAME_TYPE blackboard_name;
     
     MESSAGE_SIZE_TYPE max_message_size;
     
-    char* message;
-    MESSAGE_SIZE_TYPE message_size; // 0 means absent of the message.
+    char* message[2];
+    MESSAGE_SIZE_TYPE message_size[2]; // 0 means absent of the message.
+    
+    uint32_t version; // Number of finished updates.
+    uint32_t started; // Number of started updates.
     
     struct msection section;
     struct msection_wq process_queue;
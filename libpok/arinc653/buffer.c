@@ -31,6 +31,7 @@
 #include "arinc_alloc.h"
 #include <arinc_config.h>
 #include "arinc_process_queue.h"
+#include "arinc_wait_any.h"
 
 static size_t nbuffers_used = 0;
 
@@ -65,6 +66,171 @@ message_at(struct arinc_buffer* buffer, MESSAGE_RANGE_TYPE index)
    return buffer->messages + buffer->message_stride * index;
 }
 
+/* Return number of bytes occupied by the message in the packed buffer. */
+static size_t packed_record_len(MESSAGE_SIZE_TYPE length)
+{
+   return sizeof(MESSAGE_SIZE_TYPE) + ALIGN(length, __alignof__(int));
+}
+
+/* Return pointer to the record in the packed buffer at given offset. */
+static MESSAGE_SIZE_TYPE* packed_record_at(struct arinc_buffer* buffer, size_t offset)
+{
+   return (MESSAGE_SIZE_TYPE*)(buffer->messages + offset);
+}
+
+/*
+ * Find place in the packed buffer for the message of given length.
+ *
+ * Message is never wrapped: if it doesn't fit at the end of the ring,
+ * it is placed at the beginning.
+ *
+ * Returns FALSE if there is no space for the message.
+ */
+static pok_bool_t packed_find_space(struct arinc_buffer* buffer,
+   MESSAGE_SIZE_TYPE length, size_t* offset)
+{
+   size_t len = packed_record_len(length);
+   size_t head, tail;
+
+   if(buffer->nb_bytes == 0) {
+      // Buffer is empty, start from the beginning.
+      buffer->bytes_head = 0;
+      buffer->bytes_tail = 0;
+   }
+
+   head = buffer->bytes_head;
+   tail = buffer->bytes_tail;
+
+   if(head >= tail && buffer->nb_bytes < buffer->max_nb_bytes) {
+      // Free space is [head, end) and [0, tail).
+      if(buffer->max_nb_bytes - head >= len) {
+         *offset = head;
+         return TRUE;
+      }
+      else if(tail >= len) {
+         *offset = 0;
+         return TRUE;
+      }
+   }
+   else if(tail - head >= len) {
+      // Free space is [head, tail).
+      *offset = head;
+      return TRUE;
+   }
+
+   return FALSE;
+}
+
+/* Whether buffer has a space for the message of given length. */
+static pok_bool_t buffer_has_space(struct arinc_buffer* buffer,
+   MESSAGE_SIZE_TYPE length)
+{
+   size_t offset;
+
+   if(buffer->nb_message == buffer->max_nb_message) return FALSE;
+
+   return !buffer->is_packed || packed_find_space(buffer, length, &offset);
+}
+
+/* Store message into the buffer. There should be a space for it. */
+static void buffer_store(struct arinc_buffer* buffer,
+   const void* src, MESSAGE_SIZE_TYPE length)
+{
+   if(buffer->is_packed) {
+      size_t offset;
+      size_t len = packed_record_len(length);
+      pok_bool_t has_space = packed_find_space(buffer, length, &offset);
+
+      assert_os(has_space);
+
+      if(offset != buffer->bytes_head) {
+         // Zero length marks padding up to the end of the ring.
+         *packed_record_at(buffer, buffer->bytes_head) = 0;
+         buffer->nb_bytes += buffer->max_nb_bytes - buffer->bytes_head;
+      }
+
+      *packed_record_at(buffer, offset) = length;
+      memcpy(packed_record_at(buffer, offset) + 1, src, length);
+
+      buffer->nb_bytes += len;
+      buffer->bytes_head = (offset + len == buffer->max_nb_bytes) ? 0 : offset + len;
+   }
+   else {
+      MESSAGE_RANGE_TYPE index = message_index(buffer, buffer->nb_message);
+
+      memcpy(message_at(buffer, index), src, length);
+      buffer->messages_size[index] = length;
+   }
+
+   buffer->nb_message++;
+   buffer->wait_any_counter = buffer->nb_message;
+}
+
+/* Extract the first message from the buffer and return its length. */
+static MESSAGE_SIZE_TYPE buffer_fetch(struct arinc_buffer* buffer, void* dst)
+{
+   MESSAGE_SIZE_TYPE length;
+
+   if(buffer->is_packed) {
+      if(*packed_record_at(buffer, buffer->bytes_tail) == 0) {
+         // Skip padding.
+         buffer->nb_bytes -= buffer->max_nb_bytes - buffer->bytes_tail;
+         buffer->bytes_tail = 0;
+      }
+
+      length = *packed_record_at(buffer, buffer->bytes_tail);
+      memcpy(dst, packed_record_at(buffer, buffer->bytes_tail) + 1, length);
+
+      size_t tail = buffer->bytes_tail + packed_record_len(length);
+
+      buffer->nb_bytes -= packed_record_len(length);
+      buffer->bytes_tail = (tail == buffer->max_nb_bytes) ? 0 : tail;
+   }
+   else {
+      MESSAGE_RANGE_TYPE index = message_index(buffer, 0);
+
+      length = buffer->messages_size[index];
+      memcpy(dst, message_at(buffer, index), length);
+
+      buffer->base_offset = message_index(buffer, 1);
+   }
+
+   buffer->nb_message--;
+   buffer->wait_any_counter = buffer->nb_message;
+
+   return length;
+}
+
+/*
+ * Whether new message cannot be stored into the buffer immediately.
+ *
+ * In packed buffer senders may wait while the buffer is non-empty.
+ * New message shouldn't overtake messages of such senders.
+ */
+static pok_bool_t buffer_is_full(struct arinc_buffer* buffer,
+   MESSAGE_SIZE_TYPE length)
+{
+   if(buffer->nb_message == 0) return FALSE;
+
+   if(buffer->is_packed && msection_wq_size(&buffer->section,
+      &buffer->process_queue) > 0) return TRUE;
+
+   return !buffer_has_space(buffer, length);
+}
+
+/* Return config for the buffer with packed storage, or NULL. */
+static const struct arinc_config_buffer_packed* find_buffer_packed(const char* name)
+{
+   for(size_t i = 0; i < arinc_config_nbuffers_packed; i++)
+   {
+      const struct arinc_config_buffer_packed* config = &arinc_config_buffers_packed[i];
+      if(strncasecmp(config->name, name, MAX_NAME_LENGTH) == 0)
+         return config;
+   }
+
+   return NULL;
+}
+
 void CREATE_BUFFER (
        /*in */ BUFFER_NAME_TYPE         BUFFER_NAME,
        /*in */ MESSAGE_SIZE_TYPE        MAX_MESSAGE_SIZE,
@@ -112,6 +278,7 @@ void CREATE_BUFFER (
 
 
    struct arinc_buffer* buffer = &arinc_buffers[nbuffers_used];
+   const struct arinc_config_buffer_packed* config_packed = find_buffer_packed(BUFFER_NAME);
 
    buffer->max_message_size = MAX_MESSAGE_SIZE;
    // Optimize messages for copiing.
@@ -120,11 +287,30 @@ void CREATE_BUFFER (
 
    arinc_allocator_state astate = arinc_allocator_get_state();
 
-   buffer->messages = arinc_alloc(buffer->message_stride * buffer->max_nb_message, __alignof__(int));
-   buffer->messages_size = arinc_alloc(buffer->max_nb_message * sizeof(*buffer->messages_size),
-      __alignof__(*buffer->messages_size));
+   if(config_packed != NULL)
+   {
+      buffer->is_packed = TRUE;
+      // Ring should accomodate at least one message of maximum size.
+      buffer->max_nb_bytes = ALIGN(config_packed->max_nb_bytes, __alignof__(int));
+      if(buffer->max_nb_bytes < packed_record_len(MAX_MESSAGE_SIZE))
+         buffer->max_nb_bytes = packed_record_len(MAX_MESSAGE_SIZE);
+      buffer->nb_bytes = 0;
+      buffer->bytes_head = 0;
+      buffer->bytes_tail = 0;
+
+      buffer->messages = arinc_alloc(buffer->max_nb_bytes, __alignof__(int));
+      buffer->messages_size = NULL;
+   }
+   else
+   {
+      buffer->is_packed = FALSE;
 
-   if(buffer->messages == NULL || buffer->messages_size == NULL)
+      buffer->messages = arinc_alloc(buffer->message_stride * buffer->max_nb_message, __alignof__(int));
+      buffer->messages_size = arinc_alloc(buffer->max_nb_message * sizeof(*buffer->messages_size),
+         __alignof__(*buffer->messages_size));
+   }
+
+   if(buffer->messages == NULL || (!buffer->is_packed && buffer->messages_size == NULL))
    {
       // Failed to allocate message queue.
       arinc_allocator_reset_state(astate);
@@ -166,9 +352,11 @@ void SEND_BUFFER (
       return;
    }
 
+   pok_bool_t is_stored = FALSE;
+
    msection_enter(&buffer->section);
 
-   if(buffer->nb_message < buffer->max_nb_message)
+   if(!buffer_is_full(buffer, LENGTH))
    {
       // Buffer is not full.
       if(msection_wq_notify(&buffer->section,
@@ -185,15 +373,8 @@ void SEND_BUFFER (
       }
       else {
          // No processes are waiting on buffer.
-         MESSAGE_RANGE_TYPE index = message_index(buffer,
-            buffer->nb_message);
-
-         char* message_dest = message_at(buffer, index);
-
-         memcpy(message_dest, MESSAGE_ADDR, LENGTH);
-         buffer->messages_size[index] = LENGTH;
-
-         buffer->nb_message++;
+         buffer_store(buffer, MESSAGE_ADDR, LENGTH);
+         is_stored = TRUE;
       }
 
       *RETURN_CODE = NO_ERROR;
@@ -234,6 +415,8 @@ void SEND_BUFFER (
    }
 
    msection_leave(&buffer->section);
+
+   if(is_stored) arinc_wait_any_notify();
 }
 
 void RECEIVE_BUFFER (
@@ -256,33 +439,25 @@ void RECEIVE_BUFFER (
    if(buffer->nb_message > 0)
    {
       // Buffer is not empty.
-      MESSAGE_RANGE_TYPE index = message_index(buffer, 0);
-      const char* src = message_at(buffer, index);
-      MESSAGE_SIZE_TYPE len = buffer->messages_size[index];
-
-      memcpy(MESSAGE_ADDR, src, len);
-
-      buffer->base_offset = message_index(buffer, 1);
-      buffer->nb_message--;
-
+      *LENGTH = buffer_fetch(buffer, MESSAGE_ADDR);
       *RETURN_CODE = NO_ERROR;
-      *LENGTH = len;
 
-      if(msection_wq_notify(&buffer->section,
-         &buffer->process_queue, FALSE) == POK_ERRNO_OK) {
+      /*
+       * Move messages of waiting senders into the buffer.
+       *
+       * Sender's message is not known before it is awoken, so the space
+       * is checked for the message of maximum size.
+       */
+      while(buffer_has_space(buffer, buffer->max_message_size)
+         && msection_wq_notify(&buffer->section,
+            &buffer->process_queue, FALSE) == POK_ERRNO_OK) {
          // There are waiters on buffer. We have already awoken the first of them.
          pok_thread_id_t t_awoken = buffer->process_queue.first;
 
-         MESSAGE_RANGE_TYPE w_index = message_index(buffer, buffer->nb_message);
-         char* w_dest = message_at(buffer, w_index);
-
          const char* w_src = kshd.tshd[t_awoken].wq_buffer.src;
          MESSAGE_SIZE_TYPE w_len = kshd.tshd[t_awoken].wq_len;
 
-         memcpy(w_dest, w_src, w_len);
-         buffer->messages_size[w_index] = w_len;
-
-         buffer->nb_message++;
+         buffer_store(buffer, w_src, w_len);
 
          msection_wq_del(&buffer->process_queue, t_awoken);
       }
@@ -370,4 +545,11 @@ void GET_BUFFER_STATUS (
    *RETURN_CODE = NO_ERROR;
 }
 
+const int32_t* arinc_buffer_wait_any_counter(APEX_INTEGER buffer_id)
+{
+   if (buffer_id <= 0 || buffer_id > nbuffers_used) return NULL;
+
+   return &arinc_buffers[buffer_id - 1].wait_any_counter;
+}
+
 #endif
@@ -31,6 +31,8 @@ struct arinc_buffer
     MESSAGE_SIZE_TYPE max_message_size;
     MESSAGE_RANGE_TYPE max_nb_message;
     MESSAGE_RANGE_TYPE nb_message;
+    /* Copy of nb_message. Used for waiting any object. */
+    int32_t wait_any_counter;
     
     MESSAGE_SIZE_TYPE message_stride;
     
@@ -39,6 +41,18 @@ struct arinc_buffer
     
     MESSAGE_RANGE_TYPE base_offset;
     
+    /* 
+     * Whether messages are packed into the ring of `max_nb_bytes` bytes.
+     * 
+     * Every message in the ring is prepended with its size.
+     * `messages_size` is not used in that case.
+     */
+    pok_bool_t is_packed;
+    size_t max_nb_bytes;
+    size_t nb_bytes; // Bytes occupied by messages and padding.
+    size_t bytes_head; // Offset where next message will be written.
+    size_t bytes_tail; // Offset of the first message.
+    
     QUEUING_DISCIPLINE_TYPE discipline;
     
     struct msection section;
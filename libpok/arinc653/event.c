@@ -30,6 +30,7 @@
 #include <string.h>
 #include <arinc_config.h>
 #include "arinc_process_queue.h"
+#include "arinc_wait_any.h"
 
 static size_t nevents_used = 0;
 
@@ -75,6 +76,7 @@ void CREATE_EVENT (EVENT_NAME_TYPE EVENT_NAME,
    msection_init(&event->section);
    msection_wq_init(&event->process_queue);
    event->event_state = DOWN;
+   event->up_counter = 0;
 
    *EVENT_ID = nevents_used + 1;// Avoid 0 value.
 
@@ -97,6 +99,7 @@ void SET_EVENT (EVENT_ID_TYPE EVENT_ID,
    msection_enter(&event->section);
 
    event->event_state = UP;
+   event->up_counter = 1;
 
    if(msection_wq_notify(&event->section, &event->process_queue, TRUE)
       == POK_ERRNO_OK) {
@@ -112,6 +115,9 @@ void SET_EVENT (EVENT_ID_TYPE EVENT_ID,
    }
 
    msection_leave(&event->section);
+
+   arinc_wait_any_notify();
+
    *RETURN_CODE = NO_ERROR;
 }
 
@@ -128,6 +134,7 @@ void RESET_EVENT (EVENT_ID_TYPE EVENT_ID,
 
    msection_enter(&event->section);
    event->event_state = DOWN;
+   event->up_counter = 0;
    msection_leave(&event->section);
 
    *RETURN_CODE = NO_ERROR;
@@ -231,4 +238,11 @@ void GET_EVENT_STATUS (EVENT_ID_TYPE EVENT_ID,
    *RETURN_CODE = NO_ERROR;
 }
 
+const int32_t* arinc_event_wait_any_counter(APEX_INTEGER event_id)
+{
+   if (event_id <= 0 || event_id > nevents_used) return NULL;
+
+   return &arinc_events[event_id - 1].up_counter;
+}
+
 #endif
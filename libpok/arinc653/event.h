@@ -29,6 +29,8 @@ struct arinc_event
     EVENT_NAME_TYPE event_name;
     
     EVENT_STATE_TYPE event_state;
+    /* 1 while event is UP, 0 while DOWN. Used for waiting any object. */
+    int32_t up_counter;
     
     struct msection section;
     struct msection_wq process_queue;
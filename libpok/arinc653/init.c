@@ -18,6 +18,7 @@
 #include <arinc_config.h>
 
 #include <smalloc.h>
+#include <kernel_shared_data.h>
 
 #include "buffer.h"
 #include "blackboard.h"
@@ -66,5 +67,6 @@ void libjet_arinc_init(void)
 
 #if defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD)
     arinc_intra_heap = smalloc(arinc_config_messages_memory_size);
+    kshd.intra_size = arinc_config_messages_memory_size;
 #endif /* defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD) */
 }
@@ -25,6 +25,7 @@
 
 #include <errno.h>
 #include <utils.h>
+#include <stdio.h>
 
 #define MAP_ERROR(from, to) case (from): *return_code = (to); break
 #define MAP_ERROR_DEFAULT(to) default: *return_code = (to); break
@@ -84,6 +85,9 @@ void SET_PARTITION_MODE (OPERATING_MODE_TYPE operating_mode,
          return;
    }
 
+   // Current process is stopped on success.
+   fflush(stdout);
+
    core_ret = pok_partition_set_mode (core_mode);
 
    switch (core_ret) {
@@ -43,6 +43,8 @@
 #include <arinc653/types.h>
 #include <arinc653/process.h>
 #include <string.h>
+#include <stdio.h>
+#include <init_stdio.h>
 #include <utils.h>
 #include <core/partition.h>
 
@@ -183,6 +185,7 @@ void CREATE_PROCESS (
 
 void STOP_SELF ()
 {
+    fflush(stdout);
     pok_thread_stop ();
 }
 
@@ -265,6 +268,9 @@ void STOP(
     CHECK_PROCESS_ID();
 
     pok_ret_t core_ret = pok_thread_stop_target(process_id - 1);
+    // Stopped process cannot flush its output itself.
+    if (core_ret == POK_ERRNO_OK) libjet_stdio_flush_thread(process_id - 1);
+
     switch (core_ret) {
         MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
         MAP_ERROR(POK_ERRNO_UNAVAILABLE, NO_ACTION);
@@ -272,6 +278,17 @@ void STOP(
     }
 }
 
+/* Whether process with given (kernel) id is DORMANT. */
+static pok_bool_t process_is_dormant(pok_thread_id_t thread_id)
+{
+    PROCESS_NAME_TYPE name;
+    void* entry;
+    pok_thread_status_t status;
+
+    return pok_thread_get_status(thread_id, name, &entry, &status) == POK_ERRNO_OK
+        && status.state == POK_STATE_STOPPED;
+}
+
 void DELAYED_START(
     PROCESS_ID_TYPE   process_id,
     SYSTEM_TIME_TYPE  delay_time,
@@ -279,6 +296,13 @@ void DELAYED_START(
 {
     CHECK_PROCESS_ID();
 
+    /*
+     * Process stopped by the kernel (e.g., by HM action) may leave
+     * a partial line in its buffer. Print it before the new run.
+     */
+    if (process_is_dormant(process_id - 1))
+        libjet_stdio_flush_thread(process_id - 1);
+
     pok_ret_t core_ret = pok_thread_delayed_start(process_id - 1, &delay_time);
     switch (core_ret) {
         MAP_ERROR(POK_ERRNO_OK, NO_ERROR);
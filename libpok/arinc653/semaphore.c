@@ -34,6 +34,7 @@
 #include <string.h>
 #include <arinc_config.h>
 #include "arinc_process_queue.h"
+#include "arinc_wait_any.h"
 
 static size_t nsemaphores_used = 0;
 
@@ -99,6 +100,7 @@ void CREATE_SEMAPHORE (SEMAPHORE_NAME_TYPE SEMAPHORE_NAME,
    memcpy(semaphore->semaphore_name, SEMAPHORE_NAME, MAX_NAME_LENGTH);
    semaphore->maximum_value = MAXIMUM_VALUE;
    semaphore->current_value = CURRENT_VALUE;
+   semaphore->wait_any_counter = CURRENT_VALUE;
    semaphore->discipline = QUEUING_DISCIPLINE;
 
    msection_init(&semaphore->section);
@@ -128,6 +130,7 @@ void WAIT_SEMAPHORE (SEMAPHORE_ID_TYPE SEMAPHORE_ID,
    if(semaphore->current_value > 0) {
       // Current value is positive.
       semaphore->current_value--;
+      semaphore->wait_any_counter = semaphore->current_value;
       *RETURN_CODE = NO_ERROR;
    }
 
@@ -201,10 +204,13 @@ void SIGNAL_SEMAPHORE (SEMAPHORE_ID_TYPE SEMAPHORE_ID,
    else {
       // No one waits on semaphore. Just increment its current value.
       semaphore->current_value ++;
+      semaphore->wait_any_counter = semaphore->current_value;
       *RETURN_CODE = NO_ERROR;
    }
 
    msection_leave(&semaphore->section);
+
+   if(*RETURN_CODE == NO_ERROR) arinc_wait_any_notify();
 }
 
 void GET_SEMAPHORE_ID (SEMAPHORE_NAME_TYPE SEMAPHORE_NAME,
@@ -247,4 +253,11 @@ void GET_SEMAPHORE_STATUS (SEMAPHORE_ID_TYPE SEMAPHORE_ID,
    *RETURN_CODE = NO_ERROR;
 }
 
+const int32_t* arinc_semaphore_wait_any_counter(APEX_INTEGER semaphore_id)
+{
+   if (semaphore_id <= 0 || semaphore_id > nsemaphores_used) return NULL;
+
+   return &arinc_semaphores[semaphore_id - 1].wait_any_counter;
+}
+
 #endif
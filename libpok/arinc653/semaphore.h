@@ -30,6 +30,8 @@ struct arinc_semaphore
     
     SEMAPHORE_VALUE_TYPE current_value;
     SEMAPHORE_VALUE_TYPE maximum_value;
+    /* Copy of current_value. Used for waiting any object. */
+    int32_t wait_any_counter;
 
     QUEUING_DISCIPLINE_TYPE discipline;
     
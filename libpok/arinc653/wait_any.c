@@ -0,0 +1,106 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#include <arinc653/types.h>
+#include <arinc653/wait_any.h>
+#include <core/syscall.h>
+#include <uapi/wait_any_types.h>
+#include "arinc_wait_any.h"
+
+void WAIT_ANY (
+        /*in */ const WAIT_ANY_OBJECT_TYPE *OBJECTS,
+        /*in */ APEX_INTEGER               NB_OBJECTS,
+        /*in */ SYSTEM_TIME_TYPE           TIME_OUT,
+        /*out*/ APEX_INTEGER               *READY_INDEX,
+        /*out*/ RETURN_CODE_TYPE           *RETURN_CODE)
+{
+   jet_wait_any_object_t objects[MAX_NUMBER_OF_WAIT_ANY_OBJECTS];
+   size_t ready_index;
+   pok_ret_t core_ret;
+
+   if(NB_OBJECTS <= 0 || NB_OBJECTS > MAX_NUMBER_OF_WAIT_ANY_OBJECTS) {
+      *RETURN_CODE = INVALID_PARAM;
+      return;
+   }
+
+   for(int i = 0; i < NB_OBJECTS; i++) {
+      const WAIT_ANY_OBJECT_TYPE* object = &OBJECTS[i];
+      const int32_t* counter = NULL;
+
+      switch(object->KIND) {
+      case WAIT_ANY_QUEUING_PORT:
+      case WAIT_ANY_SAMPLING_PORT:
+         if(object->ID <= 0) {
+            *RETURN_CODE = INVALID_PARAM;
+            return;
+         }
+         objects[i].kind = (object->KIND == WAIT_ANY_QUEUING_PORT)
+            ? JET_WAIT_ANY_QUEUING_PORT : JET_WAIT_ANY_SAMPLING_PORT;
+         objects[i].port_id = object->ID - 1;
+         continue;
+#ifdef POK_NEEDS_ARINC653_BUFFER
+      case WAIT_ANY_BUFFER:
+         counter = arinc_buffer_wait_any_counter(object->ID);
+         break;
+#endif
+#ifdef POK_NEEDS_ARINC653_EVENT
+      case WAIT_ANY_EVENT:
+         counter = arinc_event_wait_any_counter(object->ID);
+         break;
+#endif
+#ifdef POK_NEEDS_ARINC653_SEMAPHORE
+      case WAIT_ANY_SEMAPHORE:
+         counter = arinc_semaphore_wait_any_counter(object->ID);
+         break;
+#endif
+      default:
+         break;
+      }
+
+      if(counter == NULL) {
+         // Incorrect identificator or kind.
+         *RETURN_CODE = INVALID_PARAM;
+         return;
+      }
+
+      objects[i].kind = JET_WAIT_ANY_COUNTER;
+      objects[i].counter = counter;
+   }
+
+   core_ret = jet_wait_any(objects, NB_OBJECTS, &TIME_OUT, &ready_index);
+
+   switch(core_ret) {
+   case POK_ERRNO_OK:
+      *READY_INDEX = ready_index;
+      *RETURN_CODE = NO_ERROR;
+      break;
+   case POK_ERRNO_EMPTY:
+      *RETURN_CODE = NOT_AVAILABLE;
+      break;
+   case POK_ERRNO_TIMEOUT:
+      *RETURN_CODE = TIMED_OUT;
+      break;
+   case POK_ERRNO_MODE:
+   case POK_ERRNO_CANCELLED:
+      *RETURN_CODE = INVALID_MODE;
+      break;
+   default:
+      // Port is not created or has wrong direction.
+      *RETURN_CODE = INVALID_PARAM;
+      break;
+   }
+}
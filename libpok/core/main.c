@@ -15,7 +15,9 @@
 
 #include <kernel_shared_data.h>
 #include <init_arinc.h>
+#include <init_stdio.h>
 #include <smalloc.h>
+#include <slab.h>
 
 int main();
 
@@ -28,6 +30,9 @@ int __pok_partition_start (void)
    kshd.error_thread_id = JET_THREAD_ID_NONE;
 
    heap_current = kshd.heap_start;
+   slab_init();
+
+   libjet_stdio_init();
 
    libjet_arinc_init();
 
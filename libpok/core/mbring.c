@@ -0,0 +1,327 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Layout of the memory block:
+ *
+ *   [header][head][tail][element 0]...[element capacity-1]
+ *
+ * Indices 'head' and 'tail' are free-running counters; element
+ * for index 'i' is 'i & mask'.
+ *
+ * MPSC ring prepends every element with sequence number (Vyukov's
+ * bounded queue): element is ready for writing with index 'i' when its
+ * sequence is 'i', and is ready for reading when its sequence is 'i + 1'.
+ *
+ * Cell is a double-buffered sequence lock (see seqcell.h) with 'head'
+ * as number of committed writes and 'tail' as number of started writes.
+ */
+
+#include <mbring.h>
+#include <seqcell.h>
+#include <core/syscall.h>
+#include <uapi/memblock_types.h>
+#include <string.h>
+#include <utils.h>
+
+#define MBRING_MAGIC 0x4d42524eu /* "MBRN" */
+
+/* Offset of element's data for MPSC ring. Keeps data 8-byte aligned. */
+#define MBRING_MPSC_DATA_OFFSET 8
+
+#define mbring_barrier() __sync_synchronize()
+
+#define MBRING_ACCESS(var) (*(volatile uint32_t*)&(var))
+
+static uint32_t round_up_pow2(uint32_t val)
+{
+    uint32_t res = 1;
+    while(res < val) res <<= 1;
+    return res;
+}
+
+static pok_bool_t kind_is_ring(mbring_kind_t kind)
+{
+    return kind == MBRING_KIND_SPSC || kind == MBRING_KIND_MPSC;
+}
+
+static void mbring_fill(struct mbring* ring, char* addr)
+{
+    struct mbring_header* header = (struct mbring_header*)addr;
+
+    ring->header = header;
+    ring->head = (struct mbring_index*)(addr + sizeof(struct mbring_header));
+    ring->tail = ring->head + 1;
+    ring->elements = (char*)(ring->tail + 1);
+
+    ring->mask = header->capacity - 1;
+    ring->element_size = header->element_size;
+    ring->stride = header->stride;
+
+    ring->head_snapshot = MBRING_ACCESS(ring->head->value);
+    ring->tail_snapshot = MBRING_ACCESS(ring->tail->value);
+}
+
+static inline char* mbring_element(const struct mbring* ring, uint32_t index)
+{
+    return ring->elements + (index & ring->mask) * ring->stride;
+}
+
+static inline uint32_t* mbring_mpsc_seq(const struct mbring* ring, uint32_t index)
+{
+    return (uint32_t*)mbring_element(ring, index);
+}
+
+static inline char* mbring_mpsc_data(const struct mbring* ring, uint32_t index)
+{
+    return mbring_element(ring, index) + MBRING_MPSC_DATA_OFFSET;
+}
+
+pok_ret_t mbring_create(const char* name, mbring_kind_t kind,
+    size_t element_size, size_t capacity, struct mbring* ring)
+{
+    jet_memory_block_status_t status;
+    pok_ret_t ret;
+    uint32_t stride;
+    size_t size;
+    uint32_t i;
+    struct mbring_header* header;
+
+    ret = pok_memory_block_get_status(name, &status);
+    if(ret != POK_ERRNO_OK) return ret;
+
+    if(status.mode != JET_MEMORY_BLOCK_READ_WRITE) return POK_ERRNO_EPERM;
+
+    if(element_size == 0) return POK_ERRNO_PARAM;
+
+    switch(kind) {
+    case MBRING_KIND_SPSC:
+        if(capacity == 0) return POK_ERRNO_PARAM;
+        stride = ALIGN(element_size, 8);
+        capacity = round_up_pow2(capacity);
+    break;
+    case MBRING_KIND_MPSC:
+        if(capacity == 0) return POK_ERRNO_PARAM;
+        stride = ALIGN(MBRING_MPSC_DATA_OFFSET + element_size, 8);
+        capacity = round_up_pow2(capacity);
+    break;
+    case MBRING_KIND_CELL:
+        stride = ALIGN(element_size, 8);
+        capacity = 2;
+    break;
+    default:
+        return POK_ERRNO_PARAM;
+    }
+
+    size = sizeof(struct mbring_header) + 2 * sizeof(struct mbring_index)
+        + capacity * stride;
+    if(size > status.size) return POK_ERRNO_SIZE;
+
+    header = (struct mbring_header*)status.addr;
+
+    // Invalidate object while it is formatted.
+    MBRING_ACCESS(header->magic) = 0;
+    mbring_barrier();
+
+    header->kind = kind;
+    header->element_size = element_size;
+    header->capacity = capacity;
+    header->stride = stride;
+
+    mbring_fill(ring, (char*)status.addr);
+
+    ring->head->value = 0;
+    ring->tail->value = 0;
+
+    if(kind == MBRING_KIND_MPSC) {
+        for(i = 0; i < capacity; i++) {
+            *mbring_mpsc_seq(ring, i) = i;
+        }
+    }
+
+    ring->head_snapshot = 0;
+    ring->tail_snapshot = 0;
+
+    mbring_barrier();
+    MBRING_ACCESS(header->magic) = MBRING_MAGIC;
+
+    return POK_ERRNO_OK;
+}
+
+pok_ret_t mbring_attach(const char* name, mbring_kind_t kind,
+    struct mbring* ring)
+{
+    jet_memory_block_status_t status;
+    pok_ret_t ret;
+    struct mbring_header* header;
+
+    ret = pok_memory_block_get_status(name, &status);
+    if(ret != POK_ERRNO_OK) return ret;
+
+    if(kind_is_ring(kind) && status.mode != JET_MEMORY_BLOCK_READ_WRITE)
+        return POK_ERRNO_EPERM;
+
+    if(status.size < sizeof(struct mbring_header)) return POK_ERRNO_NOTFOUND;
+
+    header = (struct mbring_header*)status.addr;
+
+    if(MBRING_ACCESS(header->magic) != MBRING_MAGIC) return POK_ERRNO_NOTFOUND;
+    mbring_barrier();
+
+    if(header->kind != (uint32_t)kind) return POK_ERRNO_KIND;
+
+    mbring_fill(ring, (char*)status.addr);
+
+    return POK_ERRNO_OK;
+}
+
+void* mbring_spsc_reserve(struct mbring* ring)
+{
+    uint32_t head = ring->head->value;
+
+    if(head - ring->tail_snapshot > ring->mask) {
+        ring->tail_snapshot = MBRING_ACCESS(ring->tail->value);
+        if(head - ring->tail_snapshot > ring->mask) return NULL;
+        // Consumer should finish reading before we overwrite the element.
+        mbring_barrier();
+    }
+
+    return mbring_element(ring, head);
+}
+
+void mbring_spsc_commit(struct mbring* ring)
+{
+    mbring_barrier();
+    MBRING_ACCESS(ring->head->value) = ring->head->value + 1;
+}
+
+pok_bool_t mbring_spsc_push(struct mbring* ring, const void* element)
+{
+    void* dest = mbring_spsc_reserve(ring);
+
+    if(dest == NULL) return FALSE;
+
+    memcpy(dest, element, ring->element_size);
+    mbring_spsc_commit(ring);
+
+    return TRUE;
+}
+
+pok_bool_t mbring_mpsc_push(struct mbring* ring, const void* element)
+{
+    uint32_t head = MBRING_ACCESS(ring->head->value);
+
+    while(1) {
+        uint32_t seq = MBRING_ACCESS(*mbring_mpsc_seq(ring, head));
+        int32_t diff = (int32_t)(seq - head);
+
+        if(diff == 0) {
+            uint32_t old = __sync_val_compare_and_swap(&ring->head->value,
+                head, head + 1);
+            if(old == head) break;
+            head = old;
+        }
+        else if(diff < 0) {
+            return FALSE; // Element is still used by the consumer.
+        }
+        else {
+            // Other producer has taken this index.
+            head = MBRING_ACCESS(ring->head->value);
+        }
+    }
+
+    memcpy(mbring_mpsc_data(ring, head), element, ring->element_size);
+    mbring_barrier();
+    MBRING_ACCESS(*mbring_mpsc_seq(ring, head)) = head + 1;
+
+    return TRUE;
+}
+
+const void* mbring_peek(struct mbring* ring)
+{
+    uint32_t tail = ring->tail->value;
+
+    if(ring->header->kind == MBRING_KIND_MPSC) {
+        if(MBRING_ACCESS(*mbring_mpsc_seq(ring, tail)) != tail + 1)
+            return NULL;
+        mbring_barrier();
+        return mbring_mpsc_data(ring, tail);
+    }
+
+    if(ring->head_snapshot == tail) {
+        ring->head_snapshot = MBRING_ACCESS(ring->head->value);
+        if(ring->head_snapshot == tail) return NULL;
+        mbring_barrier();
+    }
+
+    return mbring_element(ring, tail);
+}
+
+void mbring_release(struct mbring* ring)
+{
+    uint32_t tail = ring->tail->value;
+
+    mbring_barrier();
+
+    if(ring->header->kind == MBRING_KIND_MPSC) {
+        // Element may be reused on the next round.
+        MBRING_ACCESS(*mbring_mpsc_seq(ring, tail)) = tail + ring->mask + 1;
+    }
+
+    MBRING_ACCESS(ring->tail->value) = tail + 1;
+}
+
+pok_bool_t mbring_pop(struct mbring* ring, void* element)
+{
+    const void* src = mbring_peek(ring);
+
+    if(src == NULL) return FALSE;
+
+    memcpy(element, src, ring->element_size);
+    mbring_release(ring);
+
+    return TRUE;
+}
+
+size_t mbring_count(const struct mbring* ring)
+{
+    uint32_t tail = MBRING_ACCESS(ring->tail->value);
+    uint32_t head = MBRING_ACCESS(ring->head->value);
+
+    return head - tail;
+}
+
+void mbring_cell_write(struct mbring* ring, const void* value)
+{
+    uint32_t n = seqcell_write_begin(&ring->head->value, &ring->tail->value);
+
+    memcpy(mbring_element(ring, n), value, ring->element_size);
+
+    seqcell_write_end(&ring->head->value, n);
+}
+
+pok_bool_t mbring_cell_read(const struct mbring* ring, void* value)
+{
+    uint32_t n;
+
+    do {
+        n = seqcell_read_begin(&ring->head->value);
+        if(n == 0) return FALSE;
+
+        memcpy(value, mbring_element(ring, n), ring->element_size);
+    } while(seqcell_read_retry(&ring->tail->value, n));
+
+    return TRUE;
+}
@@ -0,0 +1,229 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <slab.h>
+#include <smalloc.h>
+#include <core/assert_os.h>
+#include <utils.h>
+
+/*
+ * Every object is prepended with a header, which refers to the cache.
+ *
+ * While object is free, the header also links it into the free list.
+ * While object is allocated, 'next_free' is SLAB_OBJECT_ALLOCATED,
+ * so repeated free is detected.
+ */
+struct slab_object
+{
+    struct slab_cache* cache;
+    struct slab_object* next_free;
+} __attribute__((aligned(SLAB_OBJECT_ALIGNMENT)));
+
+#define SLAB_OBJECT_ALLOCATED ((struct slab_object*)1)
+
+/* Size classes. Cache with 'object_size' 0 is not configured. */
+static struct slab_cache slab_classes[SLAB_NB_CLASSES];
+
+static inline struct slab_object* slab_object_at(struct slab_cache* cache,
+    size_t index)
+{
+    return (struct slab_object*)(cache->objects + index * cache->stride);
+}
+
+void slab_cache_init(struct slab_cache* cache, size_t object_size,
+    size_t nb_objects, void (*ctor)(void* object, size_t index))
+{
+    size_t i;
+
+    assert_os(object_size > 0);
+
+    msection_init(&cache->section);
+
+    cache->object_size = object_size;
+    cache->stride = sizeof(struct slab_object)
+        + ALIGN(object_size, SLAB_OBJECT_ALIGNMENT);
+    cache->objects = nb_objects
+        ? smalloc_aligned(cache->stride * nb_objects, SLAB_OBJECT_ALIGNMENT)
+        : NULL;
+    cache->free_list = NULL;
+
+    // Link objects in order of increasing addresses.
+    for(i = nb_objects; i > 0; i--)
+    {
+        struct slab_object* obj = slab_object_at(cache, i - 1);
+
+        obj->cache = cache;
+        obj->next_free = cache->free_list;
+        cache->free_list = obj;
+
+        if(ctor) ctor(obj + 1, i - 1);
+    }
+
+    cache->stats.nb_objects = nb_objects;
+    cache->stats.nb_in_use = 0;
+    cache->stats.nb_peak = 0;
+    cache->stats.nb_failures = 0;
+}
+
+/* Try to allocate object. Doesn't account failure. */
+static void* slab_cache_try_alloc(struct slab_cache* cache)
+{
+    struct slab_object* obj;
+
+    msection_enter(&cache->section);
+
+    obj = cache->free_list;
+    if(obj)
+    {
+        cache->free_list = obj->next_free;
+        obj->next_free = SLAB_OBJECT_ALLOCATED;
+
+        cache->stats.nb_in_use++;
+        if(cache->stats.nb_in_use > cache->stats.nb_peak)
+            cache->stats.nb_peak = cache->stats.nb_in_use;
+    }
+
+    msection_leave(&cache->section);
+
+    return obj ? obj + 1 : NULL;
+}
+
+static void slab_cache_account_failure(struct slab_cache* cache)
+{
+    msection_enter(&cache->section);
+    cache->stats.nb_failures++;
+    msection_leave(&cache->section);
+}
+
+void* slab_cache_alloc(struct slab_cache* cache)
+{
+    void* object = slab_cache_try_alloc(cache);
+
+    if(!object) slab_cache_account_failure(cache);
+
+    return object;
+}
+
+/* Whether 'obj' is a header of some object in the cache. */
+static pok_bool_t slab_cache_owns(struct slab_cache* cache,
+    struct slab_object* obj)
+{
+    size_t offset = (char*)obj - cache->objects;
+
+    return (char*)obj >= cache->objects
+        && offset < cache->stride * cache->stats.nb_objects
+        && offset % cache->stride == 0;
+}
+
+void slab_cache_free(void* object)
+{
+    struct slab_object* obj = (struct slab_object*)object - 1;
+    struct slab_cache* cache = obj->cache;
+
+    // Object should be allocated from the cache and not freed yet.
+    assert_os(cache != NULL && slab_cache_owns(cache, obj));
+
+    msection_enter(&cache->section);
+
+    assert_os(obj->next_free == SLAB_OBJECT_ALLOCATED);
+    assert_os(cache->stats.nb_in_use > 0);
+
+    obj->next_free = cache->free_list;
+    cache->free_list = obj;
+    cache->stats.nb_in_use--;
+
+    msection_leave(&cache->section);
+}
+
+void slab_cache_get_stats(struct slab_cache* cache, struct slab_stats* stats)
+{
+    msection_enter(&cache->section);
+    *stats = cache->stats;
+    msection_leave(&cache->section);
+}
+
+/* Return index of the smallest size class for given size. */
+static int slab_class_index(size_t size)
+{
+    int index = 0;
+
+    while(index < SLAB_NB_CLASSES && ((size_t)1 << (index + SLAB_MIN_SHIFT)) < size)
+        index++;
+
+    return index;
+}
+
+void slab_init(void)
+{
+    int i;
+
+    for(i = 0; i < SLAB_NB_CLASSES; i++)
+        slab_classes[i].object_size = 0;
+}
+
+void slab_add_class(size_t size, size_t nb_objects)
+{
+    int index = slab_class_index(size);
+
+    assert_os(index < SLAB_NB_CLASSES);
+    assert_os(slab_classes[index].object_size == 0);
+
+    slab_cache_init(&slab_classes[index],
+        (size_t)1 << (index + SLAB_MIN_SHIFT), nb_objects, NULL);
+}
+
+void* slab_alloc(size_t size)
+{
+    int index = slab_class_index(size);
+    int i;
+
+    for(i = index; i < SLAB_NB_CLASSES; i++)
+    {
+        void* object;
+
+        if(slab_classes[i].object_size == 0) continue;
+
+        object = slab_cache_try_alloc(&slab_classes[i]);
+        if(object) return object;
+    }
+
+    // Failure is accounted for the class which should satisfy the request.
+    for(i = index; i < SLAB_NB_CLASSES; i++)
+    {
+        if(slab_classes[i].object_size == 0) continue;
+
+        slab_cache_account_failure(&slab_classes[i]);
+        break;
+    }
+
+    return NULL;
+}
+
+void slab_free(void* object)
+{
+    if(object) slab_cache_free(object);
+}
+
+pok_bool_t slab_get_stats(size_t size, struct slab_stats* stats)
+{
+    int index = slab_class_index(size);
+
+    if(index == SLAB_NB_CLASSES || slab_classes[index].object_size == 0)
+        return FALSE;
+
+    slab_cache_get_stats(&slab_classes[index], stats);
+
+    return TRUE;
+}
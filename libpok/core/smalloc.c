@@ -37,6 +37,7 @@ void* smalloc_aligned(size_t size, size_t alignment)
     }
 
     heap_current = obj_end;
+    kshd.heap_used = heap_current - kshd.heap_start;
 
     return obj_start;
 }
@@ -66,6 +67,7 @@ void* scalloc(size_t nmemb, size_t size)
     }
 
     heap_current = mem_end;
+    kshd.heap_used = heap_current - kshd.heap_start;
 
     return mem_start;
 }
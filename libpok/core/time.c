@@ -0,0 +1,85 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <core/time.h>
+#include <kernel_shared_data.h>
+#include <asp/time.h>
+
+#define time_barrier() __sync_synchronize()
+
+/*
+ * Read system time and calendar base from the kernel's time page.
+ *
+ * Returns FALSE if kernel doesn't publish time.
+ */
+static pok_bool_t time_page_read(pok_time_t* system_time, time_t* calendar_base)
+{
+    const struct jet_kernel_time* kt = &kshd.time;
+
+    while(1) {
+        uint32_t seq = kt->seq;
+        pok_time_t t;
+
+        if(seq & 1) continue; // Kernel updates the page.
+
+        time_barrier();
+
+        switch(kt->source) {
+        case JET_KERNEL_TIME_SOURCE_VALUE:
+            t = kt->value;
+        break;
+        case JET_KERNEL_TIME_SOURCE_TIMEBASE:
+            t = kt->value + (pok_time_t)((lja_timebase() - kt->tb_offset)
+                / kt->tb_divider) * kt->tb_multiplier;
+        break;
+        default:
+            return FALSE;
+        }
+
+        *calendar_base = kt->calendar_base;
+
+        time_barrier();
+
+        if(kt->seq == seq) {
+            *system_time = t;
+            return TRUE;
+        }
+    }
+}
+
+pok_time_t pok_time_get(void)
+{
+    pok_time_t res;
+    time_t calendar_base;
+
+    if(time_page_read(&res, &calendar_base)) return res;
+
+    pok_syscall2(POK_SYSCALL_CLOCK_GETTIME, (unsigned long)CLOCK_REALTIME, (unsigned long)&res);
+
+    return res;
+}
+
+time_t pok_calendar_time_get(void)
+{
+    pok_time_t system_time;
+    time_t res;
+
+    if(time_page_read(&system_time, &res))
+        return res + (time_t)(system_time / 1000000000);
+
+    pok_syscall1(POK_SYSCALL_TIME, (unsigned long)&res);
+
+    return res;
+}
@@ -0,0 +1,75 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <config.h>
+
+#ifndef JET_ARINC653_WAIT_ANY
+#define JET_ARINC653_WAIT_ANY
+
+/*
+ * Extension of APEX: waiting on any object from the set.
+ *
+ * WAIT_ANY() doesn't consume the object. After it returns NO_ERROR,
+ * the process should perform corresponded operation (RECEIVE_QUEUING_MESSAGE,
+ * READ_SAMPLING_MESSAGE, RECEIVE_BUFFER, WAIT_EVENT, WAIT_SEMAPHORE, ...)
+ * with zero timeout. If several processes wait on the same object,
+ * that operation may return NOT_AVAILABLE.
+ */
+
+#include <arinc653/types.h>
+
+/* Maximum number of objects in one WAIT_ANY call. */
+#define MAX_NUMBER_OF_WAIT_ANY_OBJECTS 64
+
+typedef enum {
+    /* Destination port has a message, source port has a room for it. */
+    WAIT_ANY_QUEUING_PORT = 0,
+    /* New message has been written into destination port since the last read. */
+    WAIT_ANY_SAMPLING_PORT = 1,
+    /* Buffer is not empty. */
+    WAIT_ANY_BUFFER = 2,
+    /* Event is UP. */
+    WAIT_ANY_EVENT = 3,
+    /* Semaphore has positive value. */
+    WAIT_ANY_SEMAPHORE = 4,
+} WAIT_ANY_KIND_TYPE;
+
+typedef struct {
+    WAIT_ANY_KIND_TYPE KIND;
+    /* Identificator of the object of given kind. */
+    APEX_INTEGER       ID;
+} WAIT_ANY_OBJECT_TYPE;
+
+/*
+ * Wait until any object in the set becomes ready.
+ *
+ * On NO_ERROR, READY_INDEX is index of the ready object in OBJECTS.
+ *
+ * Return codes:
+ *
+ *   - NO_ERROR: some object is ready.
+ *   - NOT_AVAILABLE: TIME_OUT is 0 and no object is ready.
+ *   - TIMED_OUT: timeout has expired.
+ *   - INVALID_PARAM: incorrect number of objects, kind or identificator.
+ *   - INVALID_MODE: waiting is needed but is not allowed.
+ */
+void WAIT_ANY (
+        /*in */ const WAIT_ANY_OBJECT_TYPE *OBJECTS,
+        /*in */ APEX_INTEGER               NB_OBJECTS,
+        /*in */ SYSTEM_TIME_TYPE           TIME_OUT,
+        /*out*/ APEX_INTEGER               *READY_INDEX,
+        /*out*/ RETURN_CODE_TYPE           *RETURN_CODE);
+
+#endif
@@ -23,27 +23,39 @@
 
 #ifdef POK_NEEDS_ARINC653_BUFFER
 // Maximum number of buffers. Set in deployment.c
-extern size_t arinc_config_nbuffers;
+extern const size_t arinc_config_nbuffers;
+
+/* Buffer which stores messages packed into the ring of bytes. */
+struct arinc_config_buffer_packed
+{
+    const char* name;
+    /* Size of the ring. */
+    size_t max_nb_bytes;
+};
+
+// Buffers with packed storage. Set in deployment.c
+extern const struct arinc_config_buffer_packed arinc_config_buffers_packed[];
+extern const size_t arinc_config_nbuffers_packed;
 #endif /* POK_NEEDS_ARINC653_BUFFER */
 
 #ifdef POK_NEEDS_ARINC653_BLACKBOARD
 // Maximum number of blackboards. Set in deployment.c
-extern size_t arinc_config_nblackboards;
+extern const size_t arinc_config_nblackboards;
 #endif /* POK_NEEDS_ARINC653_BLACKBOARD */
 
 #ifdef POK_NEEDS_ARINC653_SEMAPHORE
 // Maximum number of semaphores. Set in deployment.c
-extern size_t arinc_config_nsemaphores;
+extern const size_t arinc_config_nsemaphores;
 #endif /* POK_NEEDS_ARINC653_SEMAPHORE */
 
 #ifdef POK_NEEDS_ARINC653_EVENT
 // Maximum number of events. Set in deployment.c
-extern size_t arinc_config_nevents;
+extern const size_t arinc_config_nevents;
 #endif /* POK_NEEDS_ARINC653_EVENT */
 
 #if defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD)
 // Memory for messages, used by buffers and blackboards. Set in deployment.c.
-extern size_t arinc_config_messages_memory_size;
+extern const size_t arinc_config_messages_memory_size;
 #endif /* defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD) */
 
 
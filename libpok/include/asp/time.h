@@ -0,0 +1,29 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBJET_ASP_TIME_H__
+#define __LIBJET_ASP_TIME_H__
+
+#include <types.h>
+
+/*
+ * Return current value of the hardware timebase counter.
+ *
+ * Used for computing system time when the kernel publishes
+ * JET_KERNEL_TIME_SOURCE_TIMEBASE time source.
+ */
+uint64_t lja_timebase(void);
+
+#endif /* __LIBJET_ASP_TIME_H__ */
@@ -31,6 +31,18 @@
 
 #include <uapi/thread_types.h>
 #include <core/syscall.h>
+#include <kernel_shared_data.h>
+
+/*
+ * Return deadline time of the current thread, or POK_TIME_INFINITY
+ * if thread has no deadline.
+ *
+ * Deadline is read from the kernel shared data, without syscall.
+ */
+static inline pok_time_t pok_thread_get_my_deadline(void)
+{
+    return kshd.tshd[kshd.current_thread_id].deadline_time;
+}
 
 // Renames for system calls
 #define pok_thread_period pok_sched_end_period
@@ -33,15 +33,17 @@ pok_ret_t pok_time_compute_deadline (const pok_time_t relative, pok_time_t* abso
 
 /*
  * Get number of nanoseconds that passed since the system starts.
+ *
+ * If kernel publishes time in the shared data, no syscall is performed.
  */
-static inline pok_time_t pok_time_get(void)
-{
-    pok_time_t res;
-
-    pok_syscall2(POK_SYSCALL_CLOCK_GETTIME, (unsigned long)CLOCK_REALTIME, (unsigned long)&res);
+pok_time_t pok_time_get(void);
 
-    return res;
-}
+/*
+ * Get calendar time, in seconds since Epoch.
+ *
+ * If kernel publishes time in the shared data, no syscall is performed.
+ */
+time_t pok_calendar_time_get(void);
 
 #define pok_thread_replenish pok_sched_replenish
 
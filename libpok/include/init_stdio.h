@@ -0,0 +1,39 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBJET_STDIO_INIT_H__
+#define __LIBJET_STDIO_INIT_H__
+
+#include <types.h>
+
+/*
+ * Initialization function for stdio.
+ *
+ * Allocates per-thread buffers for stdout and makes it line-buffered.
+ *
+ * Called by libjet when it is initialized.
+ */
+void libjet_stdio_init(void);
+
+/*
+ * Flush stdout buffer of the given thread.
+ *
+ * Called when the thread is stopped by another one and before the
+ * stopped thread is started again. The thread shouldn't be able to
+ * run at that moment.
+ */
+void libjet_stdio_flush_thread(pok_thread_id_t thread_id);
+
+#endif /* __LIBJET_STDIO_INIT_H__ */
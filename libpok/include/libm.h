@@ -168,6 +168,27 @@ float    tanhf(float x);
 double   trunc(double x);
 float    truncf(float x);
 
+/*
+ * Batch functions: y[i] = f(x[i]) for 0 <= i < n.
+ *
+ * Intended for arrays of samples, processed every period. Output may
+ * be the same array as input. Special cases (Inf, NaN, zeroes) give
+ * the same results as the scalar functions.
+ *
+ * Maximum errors, in float ulps:
+ *
+ *   vsinf, vcosf  - 0.51 for |x| < 2^19, as sinf/cosf otherwise;
+ *   vatan2f       - 0.51;
+ *   vexpf         - 0.51;
+ *   vsqrtf        - 0.5 (correctly rounded).
+ */
+void     vsinf(float* y, const float* x, size_t n);
+void     vcosf(float* y, const float* x, size_t n);
+void     vexpf(float* y, const float* x, size_t n);
+void     vsqrtf(float* y, const float* x, size_t n);
+/* z[i] = atan2f(y[i], x[i]) */
+void     vatan2f(float* z, const float* y, const float* x, size_t n);
+
 #endif
 
 #endif /* POK_NEEDS_LIBMATH */
@@ -0,0 +1,191 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBJET_MBRING_H__
+#define __LIBJET_MBRING_H__
+
+/*
+ * Lock-free communication objects over memory blocks.
+ *
+ * Memory block shared between partitions is formatted as either
+ *
+ *  - ring of fixed-size elements with single producer and single
+ *    consumer (SPSC), or
+ *  - ring of fixed-size elements with multiple producers and single
+ *    consumer (MPSC), or
+ *  - double-buffered cell, which holds the latest written value.
+ *
+ * No syscalls are used for transfer: data are copied directly into
+ * (and from) memory block. Consumer should poll the ring (e.g., once
+ * per its period).
+ *
+ * Rings require READ_WRITE access to the memory block for all sides.
+ * Cell requires READ_WRITE access for the writer only.
+ */
+
+#include <types.h>
+#include <errno.h>
+
+/* Size of the cache line, to which producer and consumer indices are padded. */
+#define MBRING_CACHE_LINE 64
+
+typedef enum {
+    MBRING_KIND_SPSC = 1,
+    MBRING_KIND_MPSC = 2,
+    MBRING_KIND_CELL = 3,
+} mbring_kind_t;
+
+/* Header of the object, placed at the beginning of the memory block. */
+struct mbring_header
+{
+    uint32_t magic;
+    uint32_t kind;
+    uint32_t element_size;
+    /* Number of elements in the ring. Always power of 2. */
+    uint32_t capacity;
+    /* Distance between elements, includes per-element header. */
+    uint32_t stride;
+} __attribute__((aligned(MBRING_CACHE_LINE)));
+
+/* Index, modified by one side only. Occupies whole cache line. */
+struct mbring_index
+{
+    uint32_t value;
+} __attribute__((aligned(MBRING_CACHE_LINE)));
+
+/*
+ * Local (per-partition) descriptor of the object.
+ *
+ * All fields are private and shouldn't be accessed directly.
+ *
+ * Snapshots of the other side's index are kept here, so shared
+ * cache lines are touched only when the ring looks full (for
+ * producer) or empty (for consumer).
+ */
+struct mbring
+{
+    struct mbring_header* header;
+    struct mbring_index* head; // Written by producer(s).
+    struct mbring_index* tail; // Written by consumer.
+    char* elements;
+    /* Cached copies of the shared header's fields. */
+    uint32_t mask;
+    uint32_t element_size;
+    uint32_t stride;
+    uint32_t head_snapshot; // Used by consumer.
+    uint32_t tail_snapshot; // Used by SPSC producer.
+};
+
+/*
+ * Format memory block with given name for the object of given kind.
+ *
+ * For rings, 'capacity' is a maximum number of elements in the ring.
+ * It is rounded up to the power of 2. For cell, 'capacity' is ignored.
+ *
+ * Should be called by exactly one side (normally, by the consumer)
+ * before other sides call mbring_attach(). Previous content of the
+ * memory block is lost.
+ *
+ * Returns:
+ *
+ *     POK_ERRNO_OK: Object is formatted and 'ring' is filled.
+ *     POK_ERRNO_EINVAL: There is no memory block with given name.
+ *     POK_ERRNO_PARAM: Element size (or capacity for rings) is 0.
+ *     POK_ERRNO_EPERM: Memory block is not accessible for writing.
+ *     POK_ERRNO_SIZE: Memory block is too small for given parameters.
+ */
+pok_ret_t mbring_create(const char* name, mbring_kind_t kind,
+    size_t element_size, size_t capacity, struct mbring* ring);
+
+/*
+ * Attach to the object, formatted by other side with mbring_create().
+ *
+ * Returns:
+ *
+ *     POK_ERRNO_OK: 'ring' is filled.
+ *     POK_ERRNO_EINVAL: There is no memory block with given name.
+ *     POK_ERRNO_EPERM: Memory block is not accessible for writing,
+ *         but object's kind requires that.
+ *     POK_ERRNO_NOTFOUND: Memory block is not formatted yet.
+ *     POK_ERRNO_KIND: Object has kind other than requested one.
+ */
+pok_ret_t mbring_attach(const char* name, mbring_kind_t kind,
+    struct mbring* ring);
+
+/* Return size of the element in the object. */
+static inline size_t mbring_element_size(const struct mbring* ring)
+{
+    return ring->element_size;
+}
+
+/*
+ * Put element into SPSC ring.
+ *
+ * Returns FALSE if ring is full.
+ */
+pok_bool_t mbring_spsc_push(struct mbring* ring, const void* element);
+
+/*
+ * Zero-copy variant of mbring_spsc_push().
+ *
+ * Return pointer to the space for the next element, or NULL if ring is full.
+ * Element becomes visible for the consumer after mbring_spsc_commit().
+ */
+void* mbring_spsc_reserve(struct mbring* ring);
+void mbring_spsc_commit(struct mbring* ring);
+
+/*
+ * Put element into MPSC ring.
+ *
+ * Can be called concurrently by the producers in different partitions
+ * (and by the different threads of the same partition).
+ *
+ * Returns FALSE if ring is full.
+ */
+pok_bool_t mbring_mpsc_push(struct mbring* ring, const void* element);
+
+/*
+ * Extract element from the ring (either SPSC or MPSC).
+ *
+ * Returns FALSE if ring is empty.
+ */
+pok_bool_t mbring_pop(struct mbring* ring, void* element);
+
+/*
+ * Zero-copy variant of mbring_pop().
+ *
+ * Return pointer to the first element in the ring, or NULL if ring is empty.
+ * Element is kept in the ring until mbring_release() is called.
+ */
+const void* mbring_peek(struct mbring* ring);
+void mbring_release(struct mbring* ring);
+
+/* Return number of elements in the ring. Result may be outdated. */
+size_t mbring_count(const struct mbring* ring);
+
+/* Write new value into the cell. There should be only one writer. */
+void mbring_cell_write(struct mbring* ring, const void* value);
+
+/*
+ * Read the latest value from the cell.
+ *
+ * Never blocks the writer. Reading is repeated only if the writer
+ * has written two values while we copy.
+ *
+ * Returns FALSE if nothing has been written into the cell yet.
+ */
+pok_bool_t mbring_cell_read(const struct mbring* ring, void* value);
+
+#endif /* __LIBJET_MBRING_H__ */
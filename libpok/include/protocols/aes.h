@@ -0,0 +1,103 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBPOK_PROTOCOLS_AES_H__
+#define __LIBPOK_PROTOCOLS_AES_H__
+
+/*
+ * AES block cipher (FIPS-197) with CTR and CBC modes (SP 800-38A).
+ *
+ * Block function uses 32-bit lookup tables: a round is 16 table
+ * lookups and 16 XORs, independent of the endianness of the CPU.
+ *
+ * Mode functions process a whole message in one call, so the cost
+ * of the call and of the loading the key is paid once per message
+ * rather than once per block.
+ *
+ * Key schedule may be shared between threads: it isn't modified
+ * after aes_set_*_key().
+ */
+
+#include <types.h>
+#include <errno.h>
+
+#define AES_BLOCK_SIZE 16
+
+#define AES_MAX_ROUNDS 14
+
+struct aes_key
+{
+    uint32_t rk[4 * (AES_MAX_ROUNDS + 1)];
+    int rounds;
+};
+
+/*
+ * Expand key for encryption (and for CTR mode in both directions).
+ *
+ * 'key_bits' is 128, 192 or 256.
+ *
+ * Returns:
+ *
+ *     POK_ERRNO_OK: Key is expanded.
+ *     POK_ERRNO_PARAM: Unsupported key length.
+ */
+pok_ret_t aes_set_encrypt_key(struct aes_key *key, const uint8_t *user_key,
+    size_t key_bits);
+
+/* Same as aes_set_encrypt_key(), but for decryption in CBC mode. */
+pok_ret_t aes_set_decrypt_key(struct aes_key *key, const uint8_t *user_key,
+    size_t key_bits);
+
+/* Process single block. 'in' and 'out' may be equal. */
+void aes_encrypt_block(const struct aes_key *key,
+    const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE]);
+void aes_decrypt_block(const struct aes_key *key,
+    const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE]);
+
+/*
+ * Encrypt or decrypt (it is the same operation) 'len' bytes in CTR mode.
+ *
+ * 'counter' is the initial counter block. It is incremented (as 128-bit
+ * big-endian number) for every block, including the last partial one,
+ * so on return it may be used for the next message of the same stream.
+ *
+ * The same counter value should never be used twice with the same key.
+ *
+ * 'in' and 'out' may be equal.
+ */
+void aes_ctr_crypt(const struct aes_key *key, uint8_t counter[AES_BLOCK_SIZE],
+    const void *in, void *out, size_t len);
+
+/*
+ * Encrypt or decrypt 'len' bytes in CBC mode.
+ *
+ * 'iv' is updated to the last ciphertext block, so on return it may be
+ * used for the next message of the same stream.
+ *
+ * Decryption requires the key expanded by aes_set_decrypt_key().
+ *
+ * 'in' and 'out' may be equal.
+ *
+ * Returns:
+ *
+ *     POK_ERRNO_OK: Data are processed.
+ *     POK_ERRNO_SIZE: 'len' isn't a multiple of AES_BLOCK_SIZE.
+ */
+pok_ret_t aes_cbc_encrypt(const struct aes_key *key, uint8_t iv[AES_BLOCK_SIZE],
+    const void *in, void *out, size_t len);
+pok_ret_t aes_cbc_decrypt(const struct aes_key *key, uint8_t iv[AES_BLOCK_SIZE],
+    const void *in, void *out, size_t len);
+
+#endif
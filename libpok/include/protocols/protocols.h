@@ -51,6 +51,11 @@
  */
 #include <protocols/blowfish.h>
 
+/*
+ * The AES block cipher with CTR and CBC modes
+ */
+#include <protocols/aes.h>
+
 /*
  * The Ceasar crypto protocol
  */
@@ -0,0 +1,96 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBJET_SEQCELL_H__
+#define __LIBJET_SEQCELL_H__
+
+/*
+ * Double-buffered sequence lock.
+ *
+ * Protects a value, which is stored in two buffers, with two counters:
+ *
+ *  - 'committed' is the number of finished writes,
+ *  - 'started' is the number of started writes.
+ *
+ * Write 'n' stores value into the buffer 'n & 1'. There should be only
+ * one writer at a time; readers never block it.
+ *
+ * Writer:
+ *
+ *     n = seqcell_write_begin(&committed, &started);
+ *     <store value into buffer 'n & 1'>
+ *     seqcell_write_end(&committed, n);
+ *
+ * Reader:
+ *
+ *     do {
+ *         n = seqcell_read_begin(&committed);
+ *         <copy value from buffer 'n & 1'>
+ *     } while(seqcell_read_retry(&started, n));
+ *
+ * Counters may be placed anywhere (e.g., in different cache lines).
+ */
+
+#include <types.h>
+
+#define seqcell_barrier() __sync_synchronize()
+
+#define SEQCELL_ACCESS(var) (*(volatile uint32_t*)&(var))
+
+/* Start new write. Return its number. */
+static inline uint32_t seqcell_write_begin(uint32_t* committed,
+    uint32_t* started)
+{
+    uint32_t n = SEQCELL_ACCESS(*committed) + 1;
+
+    // Readers of the buffer 'n & 1' will notice its overwriting.
+    SEQCELL_ACCESS(*started) = n;
+    seqcell_barrier();
+
+    return n;
+}
+
+/* Make value, stored by write 'n', visible for readers. */
+static inline void seqcell_write_end(uint32_t* committed, uint32_t n)
+{
+    seqcell_barrier();
+    SEQCELL_ACCESS(*committed) = n;
+}
+
+/* Return number of the latest finished write (0 if none). */
+static inline uint32_t seqcell_read_begin(const uint32_t* committed)
+{
+    uint32_t n = SEQCELL_ACCESS(*committed);
+
+    seqcell_barrier();
+
+    return n;
+}
+
+/*
+ * Check whether the value copied for write 'n' may be torn.
+ *
+ * Return TRUE if reading should be repeated.
+ */
+static inline pok_bool_t seqcell_read_retry(const uint32_t* started,
+    uint32_t n)
+{
+    seqcell_barrier();
+
+    // Buffer 'n & 1' is overwritten only by write 'n + 2'.
+    return SEQCELL_ACCESS(*started) - n >= 2;
+}
+
+#endif /* __LIBJET_SEQCELL_H__ */
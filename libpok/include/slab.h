@@ -0,0 +1,135 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBJET_SLAB_H__
+#define __LIBJET_SLAB_H__
+
+/*
+ * Slab allocator for objects allocated and freed at runtime.
+ *
+ * Memory for the objects is carved from the partition's heap in init
+ * mode. After that objects may be allocated and freed in O(1) time by
+ * any process: every cache has its own free list, protected by msection.
+ *
+ * There are two levels of API:
+ *
+ *  - slab_cache_* functions operate on the cache of fixed-size objects.
+ *  - slab_alloc() and slab_free() select cache by the requested size
+ *    among power-of-two size classes, configured with slab_add_class().
+ */
+
+#include <types.h>
+#include <msection.h>
+
+/* Size of the smallest size class is (1 << SLAB_MIN_SHIFT). */
+#define SLAB_MIN_SHIFT 4
+/* Number of size classes: 16 bytes .. 512 Kbytes. */
+#define SLAB_NB_CLASSES 16
+
+/* Alignment of the objects returned by the allocator. */
+#define SLAB_OBJECT_ALIGNMENT 8
+
+struct slab_object;
+
+struct slab_stats
+{
+    /* Total number of objects in the cache. */
+    size_t nb_objects;
+    /* Number of objects which are currently allocated. */
+    size_t nb_in_use;
+    /* Maximum value of 'nb_in_use'. */
+    size_t nb_peak;
+    /* Number of allocation requests failed because cache is empty. */
+    size_t nb_failures;
+};
+
+/*
+ * Cache of fixed-size objects.
+ *
+ * All fields are private and shouldn't be accessed directly.
+ */
+struct slab_cache
+{
+    struct msection section;
+    struct slab_object* free_list;
+    size_t object_size;
+    /* Distance between objects, includes per-object header. */
+    size_t stride;
+    char* objects;
+    struct slab_stats stats;
+};
+
+/*
+ * Create cache with 'nb_objects' objects of size 'object_size'.
+ *
+ * If 'ctor' is not NULL, it is called once for every object with
+ * index of the object in the cache.
+ *
+ * May be used only in init mode.
+ */
+void slab_cache_init(struct slab_cache* cache, size_t object_size,
+    size_t nb_objects, void (*ctor)(void* object, size_t index));
+
+/* Allocate object from the cache. Return NULL if cache is empty. */
+void* slab_cache_alloc(struct slab_cache* cache);
+
+/*
+ * Return object to the cache it has been allocated from.
+ *
+ * Freeing an object twice or freeing a pointer which hasn't been
+ * allocated from a cache triggers assert_os().
+ */
+void slab_cache_free(void* object);
+
+/* Copy statistics of the cache. */
+void slab_cache_get_stats(struct slab_cache* cache, struct slab_stats* stats);
+
+/*
+ * Reset configuration of size classes.
+ *
+ * Called on partition's start.
+ */
+void slab_init(void);
+
+/*
+ * Add 'nb_objects' objects into size class suitable for objects
+ * of given size. Size is rounded up to the power of 2.
+ *
+ * Every size class may be added only once.
+ *
+ * May be used only in init mode.
+ */
+void slab_add_class(size_t size, size_t nb_objects);
+
+/*
+ * Allocate object of given size.
+ *
+ * If the smallest suitable size class is empty, larger classes are tried.
+ *
+ * Return NULL if there is no free object.
+ */
+void* slab_alloc(size_t size);
+
+/* Free object allocated with slab_alloc(). NULL is ignored. */
+void slab_free(void* object);
+
+/*
+ * Copy statistics of the size class suitable for objects of given size.
+ *
+ * Return FALSE if there is no such class.
+ */
+pok_bool_t slab_get_stats(size_t size, struct slab_stats* stats);
+
+#endif /* __LIBJET_SLAB_H__ */
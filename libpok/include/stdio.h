@@ -52,4 +52,13 @@ int vsnprintf(char * restrict s, size_t n, const char * restrict format, va_list
 int putchar(int c);
 int puts(const char *s);
 
+/*
+ * Write buffered data of the stream.
+ *
+ * stdout is line-buffered per process, so output without trailing
+ * newline may need explicit flushing. Buffer of the process is
+ * flushed automatically when the process stops itself.
+ */
+int fflush(FILE* stream);
+
 #endif /* __LIBJET_STDIO_H_ */
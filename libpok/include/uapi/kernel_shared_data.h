@@ -24,8 +24,15 @@
 #include <types.h>
 #include <uapi/partition_arinc_types.h>
 #include <uapi/msection.h>
+#include <uapi/time.h>
 
-/* Data about the thread, shared between kernel and user spaces. */
+/*
+ * Data about the thread, shared between kernel and user spaces.
+ *
+ * Byte-sized fields are grouped together for minimize padding.
+ * The structure occupies 32 bytes and is aligned to that size, so data
+ * of the thread never cross cache line boundary.
+ */
 struct jet_thread_shared_data
 {
     /* 
@@ -35,6 +42,16 @@ struct jet_thread_shared_data
      */
     volatile uint8_t priority;
 
+    /* User space may "signal" kernel by setting these flags. */
+    volatile uint8_t thread_kernel_flags;
+
+    /* 
+     * Priority of the waited thread for ARINC purposes.
+     * 
+     * Used only by user space.
+     */
+    volatile uint8_t wq_priority;
+
     /* 
      * Count of currently entered msections.
      * 
@@ -54,9 +71,6 @@ struct jet_thread_shared_data
      */
     struct msection* volatile msection_entering;
 
-    /* User space may "signal" kernel by setting these flags. */
-    volatile uint8_t thread_kernel_flags;
-
     /* 
      * Next and previous threads in the waitqueue protected by msection
      * ('struct msection_wq').
@@ -91,18 +105,61 @@ struct jet_thread_shared_data
      */
     size_t wq_len;
 
-    /* 
-     * Priority of the waited thread for ARINC purposes.
-     * 
-     * Used only by user space.
+    /*
+     * Deadline time of the thread, POK_TIME_INFINITY if thread has
+     * no deadline.
+     *
+     * Set by the kernel when deadline is changed. The thread reads
+     * it for itself without syscall.
      */
-    volatile uint8_t wq_priority;
-
-};
+    volatile pok_time_t deadline_time;
+} __attribute__((aligned(32)));
 
 /* Thread is killed. When last msection is leaved, jet_sched() should be called. */
 #define THREAD_KERNEL_FLAG_KILLED 1
 
+/*
+ * Source of the system time for user space.
+ *
+ * With JET_KERNEL_TIME_SOURCE_SYSCALL user should use syscall for
+ * obtain time.
+ */
+#define JET_KERNEL_TIME_SOURCE_SYSCALL  0
+/* 'value' is the current system time. */
+#define JET_KERNEL_TIME_SOURCE_VALUE    1
+/*
+ * System time is
+ *
+ *     value + ((timebase - tb_offset) / tb_divider) * tb_multiplier
+ *
+ * where 'timebase' is the value of the hardware counter, readable
+ * from the user space.
+ */
+#define JET_KERNEL_TIME_SOURCE_TIMEBASE 2
+
+/*
+ * Time page: parameters for computing the system time in user space.
+ *
+ * Updated by the kernel only. Before update 'seq' is incremented
+ * (and becomes odd), after update it is incremented again.
+ * User should re-read fields if 'seq' is odd or has been changed
+ * while the fields are read.
+ */
+struct jet_kernel_time
+{
+    volatile uint32_t seq;
+    uint32_t source;
+
+    uint32_t tb_divider;
+    uint32_t tb_multiplier;
+    uint64_t tb_offset;
+
+    pok_time_t value;
+
+    /* Calendar time (seconds since Epoch) at the system time 0. */
+    time_t calendar_base;
+};
+
 /* Instance of this struct will be shared between kernel and user spaces. */
 struct jet_kernel_shared_data
 {
@@ -170,6 +227,39 @@ struct jet_kernel_shared_data
      */
     char* heap_end;
 
+    /*
+     * Set by the user, read by the kernel for the memory footprint report.
+     *
+     * Number of bytes of the heap allocated with smalloc(), and
+     * the peak usage and capacity of ARINC intra-partition memory
+     * (buffers and blackboards).
+     *
+     * Reset by the kernel when partition is started.
+     */
+    size_t heap_used;
+    size_t intra_used;
+    size_t intra_size;
+
+    /*
+     * Set by the kernel when some thread waits in jet_wait_any().
+     *
+     * Read by the user after making wait-any counter positive: if flag
+     * is set, jet_wait_any_kick() should be called.
+     *
+     * Flag may be set when there are no waiters anymore. This only
+     * costs unneeded syscall.
+     */
+    volatile pok_bool_t wait_any_pending;
+
+    /*
+     * Set by the kernel, read by the user.
+     *
+     * Updated when partition is started, on every timer tick
+     * (if time source is JET_KERNEL_TIME_SOURCE_VALUE) and when
+     * partition's space is switched to.
+     */
+    struct jet_kernel_time time;
+
     /* Open-bounds array of thread shared data. */
     struct jet_thread_shared_data tshd[];
 };
@@ -60,4 +60,31 @@ typedef struct
    pok_bool_t           validity;
 }pok_port_sampling_status_t;
 
+/* 
+ * Traffic statistics of the port (side of the channel).
+ * 
+ * Counters are cumulative since the module start, they are kept
+ * over partition restarts.
+ */
+typedef struct
+{
+   /* Messages sent (for source port) or received (for destination port). */
+   uint32_t             nb_messages;
+   /* 
+    * Queuing: messages discarded because receiver's buffer was full.
+    * Sampling: messages overwritten before receiver has read them.
+    * 
+    * For source port, sum over all destinations.
+    */
+   uint32_t             nb_discarded;
+   uint64_t             nb_bytes;
+   /* Maximum number of messages in the port's buffer. Queuing only. */
+   pok_port_size_t      nb_message_max;
+   /* Number of completed waits on the port. Queuing only. */
+   uint32_t             nb_waits;
+   /* Total and maximum time of the completed waits. Queuing only. */
+   pok_time_t           wait_time_total;
+   pok_time_t           wait_time_max;
+} pok_port_stats_t;
+
 #endif /* __JET_UAPI_PORT_TYPES_H__ */
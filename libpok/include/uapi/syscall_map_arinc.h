@@ -27,6 +27,7 @@
 #include <uapi/error_arinc_types.h>
 #include <uapi/memblock_types.h>
 #include <uapi/msection.h>
+#include <uapi/wait_any_types.h>
 
 static inline pok_ret_t pok_thread_create(const char* name,
     void* entry,
@@ -228,6 +229,27 @@ static inline pok_ret_t jet_msection_wq_size(struct msection* section,
 // Syscall should be accessed only by function
 #undef POK_SYSCALL_MSECTION_WQ_SIZE
 
+static inline pok_ret_t jet_wait_any(const jet_wait_any_object_t* objects,
+    size_t n,
+    const pok_time_t* timeout,
+    size_t* ready_index)
+{
+    return pok_syscall4(POK_SYSCALL_WAIT_ANY,
+        (uint32_t)objects,
+        (uint32_t)n,
+        (uint32_t)timeout,
+        (uint32_t)ready_index);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_WAIT_ANY
+
+static inline pok_ret_t jet_wait_any_kick(void)
+{
+    return pok_syscall0(POK_SYSCALL_WAIT_ANY_KICK);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_WAIT_ANY_KICK
+
 
 #ifdef POK_NEEDS_PARTITIONS
 static inline pok_ret_t pok_partition_set_mode_current(pok_partition_mode_t mode)
@@ -378,6 +400,16 @@ static inline pok_ret_t pok_port_sampling_check(pok_port_id_t id)
 }
 // Syscall should be accessed only by function
 #undef POK_SYSCALL_MIDDLEWARE_SAMPLING_CHECK
+
+static inline pok_ret_t pok_port_sampling_stats(pok_port_id_t id,
+    pok_port_stats_t* stats)
+{
+    return pok_syscall2(POK_SYSCALL_MIDDLEWARE_SAMPLING_STATS,
+        (uint32_t)id,
+        (uint32_t)stats);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_MIDDLEWARE_SAMPLING_STATS
 #endif /* POK_NEEDS_PORTS_SAMPLING */
 
 #ifdef POK_NEEDS_PORTS_QUEUEING
@@ -449,6 +481,16 @@ static inline pok_ret_t pok_port_queuing_clear(pok_port_id_t id)
 // Syscall should be accessed only by function
 #undef POK_SYSCALL_MIDDLEWARE_QUEUEING_CLEAR
 
+static inline pok_ret_t pok_port_queuing_stats(pok_port_id_t id,
+    pok_port_stats_t* stats)
+{
+    return pok_syscall2(POK_SYSCALL_MIDDLEWARE_QUEUEING_STATS,
+        (uint32_t)id,
+        (uint32_t)stats);
+}
+// Syscall should be accessed only by function
+#undef POK_SYSCALL_MIDDLEWARE_QUEUEING_STATS
+
 #endif /* POK_NEEDS_PORTS_QUEUEING */
 
 
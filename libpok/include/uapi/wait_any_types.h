@@ -0,0 +1,65 @@
+/*
+ * COPIED! DO NOT MODIFY!
+ *
+ * Instead of modifying this file, modify original one (kernel/include/uapi/wait_any_types.h).
+ */
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+#ifndef __JET_UAPI_WAIT_ANY_TYPES_H__
+#define __JET_UAPI_WAIT_ANY_TYPES_H__
+
+#include <uapi/types.h>
+
+/* Kind of the object, which may be waited with jet_wait_any(). */
+typedef enum
+{
+    /*
+     * Queuing port, identified by 'port_id'.
+     *
+     * IN port is ready when message can be received from it.
+     * OUT port is ready when message can be sent into it.
+     */
+    JET_WAIT_ANY_QUEUING_PORT = 1,
+    /*
+     * IN sampling port, identified by 'port_id'.
+     *
+     * Port is ready when new message has been written into it since
+     * the last read.
+     */
+    JET_WAIT_ANY_SAMPLING_PORT = 2,
+    /*
+     * Counter in the partition's memory, pointed by 'counter'.
+     *
+     * Object is ready when counter is positive. Used for intra-partition
+     * objects (buffers, events, semaphores), which are implemented in
+     * user space. Whoever makes counter positive should call
+     * jet_wait_any_kick() if 'wait_any_pending' flag is set in
+     * kernel shared data.
+     */
+    JET_WAIT_ANY_COUNTER = 3,
+} jet_wait_any_kind_t;
+
+/* Maximum number of objects in single jet_wait_any() call. */
+#define JET_WAIT_ANY_MAX_OBJECTS 256
+
+/* Object for waiting with jet_wait_any(). */
+typedef struct
+{
+    jet_wait_any_kind_t kind;
+    pok_port_id_t port_id;
+    const int32_t* counter;
+} jet_wait_any_object_t;
+
+#endif /* __JET_UAPI_WAIT_ANY_TYPES_H__ */
@@ -17,15 +17,21 @@
 #include "printf_emitter.h"
 #include "stream.h"
 
+static const struct printf_emitter_ops stream_emitter_ops = {
+    .emit_character = &stdio_stream_emit_character,
+    .emit_string = &stdio_stream_emit_string,
+};
+
 /* This function is part of C99, but we don't expose it to the user. */
 static int vfprintf(FILE * restrict stream, const char * restrict format, va_list arg)
 {
-    stream->bytes_written = 0;
+    struct stdio_stream_operation op;
 
-    printf_emitter(stdio_stream_emit_character, stream, format, arg);
-    stdio_stream_complete_operation(stream);
+    stdio_stream_begin_operation(&op, stream);
+    printf_emitter(&stream_emitter_ops, &op, format, arg);
+    stdio_stream_complete_operation(&op);
 
-    return stream->bytes_written;
+    return op.bytes_written;
 }
 
 int vprintf(const char * restrict format, va_list arg)
@@ -20,13 +20,122 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <types.h>
 
 static const char digits[] = "0123456789abcdef";
 
-#define PUTC(c) emit_character(c, private_data)
+/* Decimal representations of numbers 0..99, two characters for each. */
+static const char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
 
-/* Emit characters, produced by a number with given modificators.*/
-static void print_num(emit_character_t emit_character,
+#define PUTC(c) ops->emit_character(c, private_data)
+#define PUTS(s, size) ops->emit_string(s, size, private_data)
+
+/*
+ * Write decimal digits of 32-bit value before 'end'.
+ *
+ * At least 'min_digits' digits are written (with leading zeros).
+ *
+ * Return pointer to the first digit.
+ */
+static char* format_dec32(char* end, uint32_t value, int min_digits)
+{
+    char* p = end;
+
+    // Two digits per division.
+    while (value >= 100) {
+        unsigned pair = (value % 100) * 2;
+        value /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+
+    if (value >= 10) {
+        *--p = digit_pairs[value * 2 + 1];
+        *--p = digit_pairs[value * 2];
+    }
+    else
+        *--p = '0' + value;
+
+    while (end - p < min_digits)
+        *--p = '0';
+
+    return p;
+}
+
+/*
+ * Write decimal digits of the value before 'end'.
+ *
+ * Return pointer to the first digit.
+ */
+static char* format_dec(char* end, unsigned long long value)
+{
+    /*
+     * 64-bit division is a library call on 32-bit targets,
+     * so it is used only for splitting value into 9-digit chunks.
+     */
+    while (value > 0xffffffffULL) {
+        uint32_t chunk = value % 1000000000;
+        value /= 1000000000;
+        end = format_dec32(end, chunk, 9);
+    }
+
+    return format_dec32(end, (uint32_t)value, 1);
+}
+
+/*
+ * Write hexadecimal digits of the value before 'end'.
+ *
+ * Return pointer to the first digit.
+ */
+static char* format_hex(char* end, unsigned long long value)
+{
+    char* p = end;
+
+    do {
+        *--p = digits[value & 0xf];
+        value >>= 4;
+    } while (value);
+
+    return p;
+}
+
+/* Emit 'count' copies of character 'c'. */
+static void emit_fill(const struct printf_emitter_ops* ops,
+                      void *private_data,
+                      char c,
+                      int count)
+{
+    char fill[16];
+
+    if (count <= 0)
+        return;
+
+    memset(fill, c, count < (int)sizeof(fill) ? count : (int)sizeof(fill));
+
+    while (count > 0) {
+        int n = count < (int)sizeof(fill) ? count : (int)sizeof(fill);
+        PUTS(fill, n);
+        count -= n;
+    }
+}
+
+/*
+ * Emit characters, produced by a number with given modificators.
+ *
+ * Number with its sign and padding is formed in the local buffer
+ * and emitted at once.
+ */
+static void print_num(const struct printf_emitter_ops* ops,
                       void *private_data,
                       unsigned long long value,
                       unsigned base,
@@ -34,41 +143,40 @@ static void print_num(emit_character_t emit_character,
                       int neg,
                       int pad_with_zero)
 {
-    unsigned char digit_str[32]; //64-bit number in octal base is 32 digits long
-    int size = 0;
-    do {
-        unsigned mod = value%base;
-        value /= base;
-        digit_str[size] = digits[mod];
-        size++;
-
-    } while (value);
+    char buf[32]; // 64-bit number is 20 decimal digits long, plus sign and padding
+    char* end = buf + sizeof(buf);
+    char* p = (base == 16) ? format_hex(end, value) : format_dec(end, value);
+    int fill = pad - (end - p) - neg;
 
     if (pad_with_zero) {
-        if (neg) {
-            PUTC('-');
-            pad--;
+        // Leave room for the sign.
+        while (fill > 0 && p > buf + 1) {
+            *--p = '0';
+            fill--;
         }
-        while (size < pad--)
-            PUTC('0');
-
+        if (fill > 0) {
+            // Too long padding: rest of zeros are emitted separately.
+            if (neg)
+                PUTC('-');
+            emit_fill(ops, private_data, '0', fill);
+        }
+        else if (neg)
+            *--p = '-';
     } else {
         if (neg)
-            pad--;
-
-        while (size < pad--)
-            PUTC(' ');
-
-        if (neg)
-            PUTC('-');
+            *--p = '-';
+        while (fill > 0 && p > buf) {
+            *--p = ' ';
+            fill--;
+        }
+        emit_fill(ops, private_data, ' ', fill);
     }
 
-    while (size--)
-        PUTC(digit_str[size]);
+    PUTS(p, end - p);
 }
 
 /* Emit characters, produced by a floating number with given modificators.*/
-static void print_float(emit_character_t emit_character,
+static void print_float(const struct printf_emitter_ops* ops,
                         void *private_data,
                         long double value,
                         int pad,
@@ -79,14 +187,14 @@ static void print_float(emit_character_t emit_character,
     long long floor = value;
     long double fractional = 0;
 
-    print_num(emit_character, private_data, floor, 10, pad-(precision+1), neg, pad_with_zero);
+    print_num(ops, private_data, floor, 10, pad-(precision+1), neg, pad_with_zero);
 
     PUTC('.');
 
     fractional = (value - floor);
     for (int i=0; i<precision; i++)
         fractional *= 10;
-    print_num(emit_character, private_data, fractional, 10, precision, 0, 1);
+    print_num(ops, private_data, fractional, 10, precision, 0, 1);
 }
 
 /*
@@ -97,7 +205,7 @@ static void print_float(emit_character_t emit_character,
  */
 //XXX for now precision is used only for floating points
 static const char * handle_fmt(
-    emit_character_t emit_character, void *private_data,
+    const struct printf_emitter_ops* ops, void *private_data,
     const char* format, va_list* parg)
 {
     unsigned l = 0;
@@ -146,15 +254,12 @@ static const char * handle_fmt(
                     if (precision != 0 && precision<len)
                         len = precision;
 
-                    while (len < pad--)
-                        PUTC(' ');
-                    while (*s && len-- )
-                        PUTC(*s++);
+                    emit_fill(ops, private_data, ' ', pad - len);
+                    PUTS(s, len);
                     return ++format;
                 }
            case 'p':
-                PUTC('0');
-                PUTC('x');
+                PUTS("0x", 2);
            case 'x':
                 {
                     long long value;
@@ -166,7 +271,7 @@ static const char * handle_fmt(
                     else
                         value = va_arg(*parg, unsigned );
 
-                    print_num(emit_character, private_data,
+                    print_num(ops, private_data,
                         value, 16, pad, 0, pad_with_zero);
                     return ++format;
                 }
@@ -183,7 +288,7 @@ static const char * handle_fmt(
                     int neg = value < 0;
                     if (neg)
                         value = -value;
-                    print_num(emit_character, private_data,
+                    print_num(ops, private_data,
                         value, 10, pad, neg, pad_with_zero);
                     return ++format;
                 }
@@ -197,7 +302,7 @@ static const char * handle_fmt(
                     else
                         value = va_arg(*parg, unsigned );
 
-                    print_num(emit_character, private_data,
+                    print_num(ops, private_data,
                         value, 10, pad, 0, pad_with_zero);
                     return ++format;
                 }
@@ -213,7 +318,7 @@ static const char * handle_fmt(
                         value = -value;
                     if (precision == 0)
                         precision = 6;
-                    print_float(emit_character, private_data,
+                    print_float(ops, private_data,
                         value, pad, precision, neg, pad_with_zero);
                     return ++format;
                 }
@@ -235,7 +340,7 @@ static const char * handle_fmt(
     return format;
 }
 
-void printf_emitter(emit_character_t emit_character, void *private_data,
+void printf_emitter(const struct printf_emitter_ops* ops, void *private_data,
     const char* format, va_list arg)
 {
     /* 
@@ -259,10 +364,16 @@ void printf_emitter(emit_character_t emit_character, void *private_data,
     while(*format) {
         if (*format == '%') {
             format++;
-            format = handle_fmt(emit_character, private_data, format, &arg1);
+            format = handle_fmt(ops, private_data, format, &arg1);
+        }
+        else {
+            // Emit literal part of the format at once.
+            const char* literal = format;
+
+            while (*format && *format != '%')
+                format++;
+            PUTS(literal, format - literal);
         }
-        else
-            PUTC(*format++);
     }
 
     va_end(arg1);
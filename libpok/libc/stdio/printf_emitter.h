@@ -19,12 +19,27 @@
 #define __LIBJET_STDIO_PRINTF_EMITTER_H__
 
 #include <stdarg.h>
+#include <stddef.h>
 
 /* Emit single character. */
 typedef void (*emit_character_t)(int c, void *private_data);
 
-/* For each character, determined by format and args, call emit_character().*/
-void printf_emitter(emit_character_t emit_character, void *private_data,
+/* Emit 'size' characters at once. */
+typedef void (*emit_string_t)(const char* s, size_t size, void *private_data);
+
+struct printf_emitter_ops
+{
+    emit_character_t emit_character;
+    emit_string_t emit_string;
+};
+
+/*
+ * Emit characters, determined by format and args.
+ *
+ * Literal parts of the format and converted arguments are emitted
+ * with single emit_string() call whenever possible.
+ */
+void printf_emitter(const struct printf_emitter_ops* ops, void *private_data,
     const char* format, va_list arg);
 
 #endif /* __LIBJET_STDIO_PRINTF_EMITTER_H_ */
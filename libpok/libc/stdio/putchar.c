@@ -18,9 +18,11 @@
 
 int putchar(int c)
 {
-    stdout->bytes_written = 0; // Just for the case.
-    stdio_stream_emit_character(c, stdout);
-    stdio_stream_complete_operation(stdout);
+    struct stdio_stream_operation op;
+
+    stdio_stream_begin_operation(&op, stdout);
+    stdio_stream_emit_character(c, &op);
+    stdio_stream_complete_operation(&op);
 
     return c;
 }
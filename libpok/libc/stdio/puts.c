@@ -14,15 +14,17 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "stream.h"
 
 int puts(const char *s)
 {
-    stdout->bytes_written = 0; // Just for the case.
-    for(; *s; s++)
-        stdio_stream_emit_character(*s, stdout);
-    stdio_stream_emit_character('\n', stdout);
-    stdio_stream_complete_operation(stdout);
+    struct stdio_stream_operation op;
+
+    stdio_stream_begin_operation(&op, stdout);
+    stdio_stream_emit_string(s, strlen(s), &op);
+    stdio_stream_emit_character('\n', &op);
+    stdio_stream_complete_operation(&op);
 
     return 0;
 }
@@ -14,6 +14,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "printf_emitter.h"
 
 struct string_stream
@@ -34,6 +35,24 @@ static void string_stream_emit_character(int c, void *_sstream)
     sstream->bytes_written++;
 }
 
+static void string_stream_emit_string(const char* s, size_t size, void *_sstream)
+{
+    struct string_stream* sstream = _sstream;
+
+    if(sstream->bytes_written < sstream->bytes_max) {
+        size_t n = sstream->bytes_max - sstream->bytes_written;
+        if(n > size) n = size;
+        memcpy(sstream->str + sstream->bytes_written, s, n);
+    }
+
+    sstream->bytes_written += size;
+}
+
+static const struct printf_emitter_ops string_stream_emitter_ops = {
+    .emit_character = &string_stream_emit_character,
+    .emit_string = &string_stream_emit_string,
+};
+
 int vsnprintf(char * restrict s, size_t n, const char * restrict format, va_list arg)
 {
     int bytes_max = n > 0 ? (n - 1): 0;
@@ -44,7 +63,7 @@ int vsnprintf(char * restrict s, size_t n, const char * restrict format, va_list
         .bytes_max = bytes_max
     };
 
-    printf_emitter(&string_stream_emit_character, &sstream, format, arg);
+    printf_emitter(&string_stream_emitter_ops, &sstream, format, arg);
 
     int res = sstream.bytes_written;
 
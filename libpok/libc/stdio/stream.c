@@ -15,57 +15,114 @@
 
 #include "stream.h"
 #include <core/syscall.h>
+#include <kernel_shared_data.h>
+#include <init_stdio.h>
+#include <smalloc.h>
+#include <string.h>
 #include <assert.h>
 
-// Flush stream with *non-empty* buffer.
-void stream_flush(struct stdio_stream* stream)
+// Flush *non-empty* buffer of the stream.
+static void stream_flush(struct stdio_stream* stream,
+    const char* buffer, size_t* buffer_pos)
 {
-    assert(stream->buffer_pos > 0);
+    assert(*buffer_pos > 0);
 
-    stream->s_ops->write_bytes(stream, stream->buffer,
-        stream->buffer_pos);
+    stream->s_ops->write_bytes(stream, buffer, *buffer_pos);
     // TODO: check errors
-    stream->buffer_pos = 0;
+    *buffer_pos = 0;
 }
 
-void stdio_stream_emit_character(int c, void* _stream)
+void stdio_stream_begin_operation(struct stdio_stream_operation* op,
+    struct stdio_stream* stream)
 {
-    struct stdio_stream* stream = _stream;
-    // Unconditionally convert character into 'char'.
-    char c_real = (char)c;
+    op->stream = stream;
+    op->bytes_written = 0;
+
+    if(stream->thread_buffers) {
+        struct stdio_thread_buffer* tb =
+            &stream->thread_buffers[kshd.current_thread_id];
+
+        op->buffer = tb->data;
+        op->buffer_size = sizeof(tb->data);
+        op->buffer_pos = &tb->pos;
+    }
+    else {
+        op->buffer = stream->buffer;
+        op->buffer_size = stream->buffer_size;
+        op->buffer_pos = &stream->buffer_pos;
+    }
+}
+
+void stdio_stream_emit_string(const char* s, size_t size, void* _op)
+{
+    struct stdio_stream_operation* op = _op;
+    struct stdio_stream* stream = op->stream;
+
+    op->bytes_written += size;
+
+    if(op->buffer_size == 0) {
+        // Buffer doesn't exist. Unconditionally use non-buffered mode.
+        stream->s_ops->write_bytes(stream, s, size);
+        // TODO: check errors
+        return;
+    }
 
-    if(stream->buffer_pos == stream->buffer_size) {
-        // Buffer is full or doesn't exist.
-        if(stream->buffer_pos) {
+    while(size > 0) {
+        size_t n = op->buffer_size - *op->buffer_pos;
+        pok_bool_t has_newline;
+
+        if(n == 0) {
             // Buffer is full. Need to flush it before continue.
-            stream_flush(stream);
+            stream_flush(stream, op->buffer, op->buffer_pos);
+            n = op->buffer_size;
         }
-        else {
-            // Buffer doesn't exist. Unconditionally use non-buffered mode.
-            stream->s_ops->write_bytes(stream, &c_real, 1);
-            stream->bytes_written++;
-            // TODO: check errors
-            return;
+        if(n > size) n = size;
+
+        memcpy(op->buffer + *op->buffer_pos, s, n);
+        *op->buffer_pos += n;
+
+        has_newline = stream->buffer_mode == _IOLBF && memchr(s, '\n', n);
+
+        s += n;
+        size -= n;
+
+        if(has_newline) {
+            /*
+             * In per-line mode, flush buffer after newline. Characters
+             * after the newline are flushed too: this is one syscall
+             * instead of two.
+             */
+            stream_flush(stream, op->buffer, op->buffer_pos);
         }
     }
+}
 
-    // Buffer is available. Use it.
-    stream->buffer[stream->buffer_pos++] = c_real;
-    stream->bytes_written++;
-    if(c_real == '\n' && stream->buffer_mode == _IOLBF) {
-        // In case of newline and per-line mode, flush buffer immediately.
-        stream_flush(stream);
-    }
+void stdio_stream_emit_character(int c, void* _op)
+{
+    // Unconditionally convert character into 'char'.
+    char c_real = (char)c;
+
+    stdio_stream_emit_string(&c_real, 1, _op);
 }
 
-void stdio_stream_complete_operation(struct stdio_stream* stream)
+void stdio_stream_complete_operation(struct stdio_stream_operation* op)
 {
-    if(stream->buffer_pos > 0 && stream->buffer_mode == _IONBF) {
+    if(*op->buffer_pos > 0 && op->stream->buffer_mode == _IONBF) {
         // Flush buffer in non-buffered mode.
-        stream_flush(stream);
+        stream_flush(op->stream, op->buffer, op->buffer_pos);
     }
 }
 
+int fflush(FILE* stream)
+{
+    struct stdio_stream_operation op;
+
+    stdio_stream_begin_operation(&op, stream);
+    if(*op.buffer_pos > 0) stream_flush(stream, op.buffer, op.buffer_pos);
+
+    return 0;
+}
+
 /*
  * Write bytes into the console.
  * 
@@ -86,15 +143,55 @@ static const struct stdio_stream_ops console_stream_ops = {
 };
 
 static char console_buffer[BUFSIZ];
-/* Stream, which is connected to (output) console. */
+/*
+ * Stream, which is connected to (output) console.
+ *
+ * Until libjet_stdio_init() is called, it is non-buffered.
+ */
 static struct stdio_stream console_stream = {
     .buffer = console_buffer,
     .buffer_size = BUFSIZ,
     .buffer_mode = _IONBF,
     .s_ops = &console_stream_ops,
     .buffer_pos = 0,
-    .bytes_written = 0,
+    .thread_buffers = NULL,
+};
+
+static char console_error_buffer[BUFSIZ];
+/* Stream for errors, which is connected to console too. Never buffered. */
+static struct stdio_stream console_error_stream = {
+    .buffer = console_error_buffer,
+    .buffer_size = BUFSIZ,
+    .buffer_mode = _IONBF,
+    .s_ops = &console_stream_ops,
+    .buffer_pos = 0,
+    .thread_buffers = NULL,
 };
 
-FILE* stderr = &console_stream;
+FILE* stderr = &console_error_stream;
 FILE* stdout = &console_stream;
+
+void libjet_stdio_init(void)
+{
+    struct stdio_thread_buffer* thread_buffers;
+    pok_thread_id_t i;
+
+    thread_buffers = scalloc(kshd.max_n_threads, sizeof(*thread_buffers));
+    if(thread_buffers == NULL) return;
+
+    for(i = 0; i < kshd.max_n_threads; i++)
+        thread_buffers[i].pos = 0;
+
+    console_stream.thread_buffers = thread_buffers;
+    console_stream.buffer_mode = _IOLBF;
+}
+
+void libjet_stdio_flush_thread(pok_thread_id_t thread_id)
+{
+    struct stdio_thread_buffer* tb;
+
+    if(console_stream.thread_buffers == NULL) return;
+
+    tb = &console_stream.thread_buffers[thread_id];
+    if(tb->pos > 0) stream_flush(&console_stream, tb->data, &tb->pos);
+}
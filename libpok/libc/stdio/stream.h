@@ -24,6 +24,14 @@
 
 struct stdio_stream_ops;
 
+/* Buffer of the single thread for the stream with per-thread buffers. */
+struct stdio_thread_buffer
+{
+    /* Current position in the buffer. */
+    size_t pos;
+    char data[BUFSIZ];
+};
+
 struct stdio_stream
 {
     /* Pointer to the buffer used by the stream. May be NULL. */
@@ -36,12 +44,14 @@ struct stdio_stream
     const struct stdio_stream_ops* s_ops;
     /* Current position in the buffer. */
     size_t buffer_pos;
-    /* 
-     * Number of bytes written into the stream.
-     * 
-     * This counter may be reseted manually when needed.
+    /*
+     * Per-thread buffers, indexed by thread id. May be NULL.
+     *
+     * If set, 'buffer' and 'buffer_pos' are not used: every thread
+     * writes into its own buffer, so output of concurrent processes
+     * isn't mixed within a line.
      */
-    size_t bytes_written;
+    struct stdio_thread_buffer* thread_buffers;
     /* 
      * TODO: there is should be a msection,
      * which protect stream from concurrent accesses.
@@ -61,14 +71,31 @@ struct stdio_stream_ops
     // Reading streams are currently unsupported.
 };
 
+/* Single output operation (printf(), puts(), etc.) on the stream. */
+struct stdio_stream_operation
+{
+    struct stdio_stream* stream;
+    /* Buffer used by the operation: stream's one or thread's one. */
+    char* buffer;
+    size_t buffer_size;
+    size_t* buffer_pos;
+    /* Number of bytes written into the stream by the operation. */
+    size_t bytes_written;
+};
+
+/* Start operation for the stream. */
+void stdio_stream_begin_operation(struct stdio_stream_operation* op,
+    struct stdio_stream* stream);
 /* Callback of type 'emit_character_t' for emit characters into stream.*/
-void stdio_stream_emit_character(int c, void* _stream);
+void stdio_stream_emit_character(int c, void* _op);
+/* Callback of type 'emit_string_t' for emit strings into stream.*/
+void stdio_stream_emit_string(const char* s, size_t size, void* _op);
 /* 
  * Complete operation for the stream.
  * 
  * Buffer may be used by 'stdio_stream_emit_character' even in _IONBF mode;
  * this function flushes the buffer.
  */
-void stdio_stream_complete_operation(struct stdio_stream* stream);
+void stdio_stream_complete_operation(struct stdio_stream_operation* op);
 
 #endif /* __LIBJET_STDIO_STREAM_H_ */
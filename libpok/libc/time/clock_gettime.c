@@ -14,16 +14,12 @@
  */
 
 #include <time.h>
-#include <core/syscall.h>
+#include <core/time.h>
 
 int clock_gettime(clockid_t clock_id, struct timespec* tp)
 {
-    pok_time_t t;
-    
-    pok_ret_t ret = pok_syscall2(POK_SYSCALL_CLOCK_GETTIME, (unsigned long)CLOCK_REALTIME, (unsigned long)&t);
-    
-    if(ret) return -1; // TODO: set errno.
-    
+    pok_time_t t = pok_time_get();
+
     tp->tv_sec = t / 1000000000;
     tp->tv_nsec = t % 1000000000;
     
@@ -14,14 +14,12 @@
  */
 
 #include <time.h>
-#include <core/syscall.h>
+#include <core/time.h>
 
 time_t time(time_t *timer)
 {
-    time_t ret;
-    
-    pok_syscall1(POK_SYSCALL_TIME, (unsigned long)&ret);
-    
+    time_t ret = pok_calendar_time_get();
+
     if(timer)
         *timer = ret;
     
@@ -101,6 +101,16 @@
 #include <types.h>
 #include "math_private.h"
 
+#ifdef LIBM_HAS_HW_SQRT
+
+double
+__ieee754_sqrt(double x)
+{
+	return __hw_sqrt(x);
+}
+
+#else
+
 static	const double	one	= 1.0, tiny=1.0e-300;
 
 double
@@ -200,6 +210,8 @@ __ieee754_sqrt(double x)
 	return z;
 }
 
+#endif /* LIBM_HAS_HW_SQRT */
+
 /*
 Other methods  (use floating-point arithmetic)
 -------------
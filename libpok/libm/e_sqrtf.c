@@ -33,6 +33,16 @@
 #include <types.h>
 #include "math_private.h"
 
+#ifdef LIBM_HAS_HW_SQRT
+
+float
+__ieee754_sqrtf(float x)
+{
+	return __hw_sqrtf(x);
+}
+
+#else
+
 static	const float	one	= 1.0, tiny=1.0e-30;
 
 float
@@ -100,5 +110,7 @@ __ieee754_sqrtf(float x)
 	SET_FLOAT_WORD(z,ix);
 	return z;
 }
+
+#endif /* LIBM_HAS_HW_SQRT */
 #endif
 
@@ -37,7 +37,7 @@
 #include <libc/stdio.h>
 #define	WRITE2(u,v)	printf (u)
 #else
-#define	WRITE2(u,v)
+#define	WRITE2(u,v)	0
 #endif /* POK_NEEDS_STDIO */
 #else	/* !defined(_USE_WRITE) */
 #include <unistd.h>			/* write */
@@ -254,6 +254,57 @@ extern float __kernel_cosf __P((float,float));
 extern float __kernel_tanf __P((float,float,int));
 extern int   __kernel_rem_pio2f __P((float*,float*,int,int,int,const int*));
 
+/*
+ * Square root with the FPU instruction, where the FPU has one.
+ *
+ * x87 rounds the result to the precision from its control word, which
+ * is extended by default. For double result precision is lowered to
+ * 53 bits for the instruction, so the result is correctly rounded.
+ * For float result extended precision is enough: rounding it to float
+ * later never differs from the correct rounding.
+ *
+ * On PowerPC fsqrt is optional (e.g., e500mc has no one); compiler
+ * defines _ARCH_PPCSQ when it is available.
+ */
+#if defined(__i386__)
+#define LIBM_HAS_HW_SQRT 1
+
+static inline double __hw_sqrt(double x)
+{
+	uint16_t cw, cw_double;
+
+	__asm__ __volatile__ ("fnstcw %0" : "=m" (cw));
+	cw_double = (cw & ~0x300) | 0x200;
+	__asm__ __volatile__ ("fldcw %0" : : "m" (cw_double));
+	__asm__ __volatile__ ("fsqrt" : "=t" (x) : "0" (x));
+	__asm__ __volatile__ ("fldcw %0" : : "m" (cw));
+
+	return x;
+}
+
+static inline float __hw_sqrtf(float x)
+{
+	__asm__ ("fsqrt" : "=t" (x) : "0" (x));
+	return x;
+}
+#elif defined(_ARCH_PPCSQ)
+#define LIBM_HAS_HW_SQRT 1
+
+static inline double __hw_sqrt(double x)
+{
+	double z;
+	__asm__ ("fsqrt %0,%1" : "=f" (z) : "f" (x));
+	return z;
+}
+
+static inline float __hw_sqrtf(float x)
+{
+	float z;
+	__asm__ ("fsqrts %0,%1" : "=f" (z) : "f" (x));
+	return z;
+}
+#endif
+
 
 #endif /* _MATH_PRIVATE_H_ */
 
@@ -0,0 +1,112 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifdef POK_NEEDS_LIBMATH
+
+#include <libm.h>
+#include "vmath_private.h"
+
+/*
+ * Polynomial for atan(u), |u| <= tan(pi/8): atan(u) = u - u*p(u^2).
+ *
+ * Coefficients are from fdlibm's atan.c, where they are used for
+ * |u| < 7/16 with double precision.
+ */
+static const double aT[] = {
+  3.33333333333329318027e-01, /* 0x3FD55555, 0x5555550D */
+ -1.99999999998764832476e-01, /* 0xBFC99999, 0x9998EBC4 */
+  1.42857142725034663711e-01, /* 0x3FC24924, 0x920083FF */
+ -1.11111104054623557880e-01, /* 0xBFBC71C6, 0xFE231671 */
+  9.09088713343650656196e-02, /* 0x3FB745CD, 0xC54C206E */
+ -7.69187620504482999495e-02, /* 0xBFB3B0F2, 0xAF749A6D */
+  6.66107313738753120669e-02, /* 0x3FB10D66, 0xA0D03D51 */
+ -5.83357013379057348645e-02, /* 0xBFADDE2D, 0x52DEFD9A */
+  4.97687799461593236017e-02, /* 0x3FA97B4B, 0x24760DEB */
+ -3.65315727442169155270e-02, /* 0xBFA2B444, 0x2C6A6C2F */
+  1.62858201153657823623e-02, /* 0x3F90AD3A, 0xE322DA11 */
+};
+
+static const double
+tan_pio8 = 4.14213562373095048802e-01, /* sqrt(2) - 1 */
+pi_o_4   = 7.85398163397448278999e-01, /* 0x3FE921FB, 0x54442D18 */
+pi_o_2   = 1.57079632679489655800e+00, /* 0x3FF921FB, 0x54442D18 */
+pi       = 3.14159265358979311600e+00; /* 0x400921FB, 0x54442D18 */
+
+static inline double atan_poly(double u)
+{
+	double z = u*u;
+	double w = z*z;
+	double s1 = z*(aT[0]+w*(aT[2]+w*(aT[4]+w*(aT[6]+w*(aT[8]+w*aT[10])))));
+	double s2 = w*(aT[1]+w*(aT[3]+w*(aT[5]+w*(aT[7]+w*aT[9]))));
+
+	return u - u*(s1+s2);
+}
+
+/*
+ * atan2(y, x) for finite arguments.
+ *
+ * With a = min(|x|, |y|) and b = max(|x|, |y|), angle atan(a/b) is
+ * in [0, pi/4]. When a/b > tan(pi/8) it is computed as
+ * pi/4 + atan((a-b)/(a+b)). Then the angle is mirrored according to
+ * the octant of (x, y).
+ */
+static inline float vatan2f_finite(int32_t hy, int32_t hx)
+{
+	float fx, fy;
+	double ax, ay, a, b, num, den, r;
+	int swap, big;
+
+	SET_FLOAT_WORD(fx, hx & 0x7fffffff);
+	SET_FLOAT_WORD(fy, hy & 0x7fffffff);
+	ax = fx;
+	ay = fy;
+
+	swap = ay > ax;
+	a = swap ? ax : ay;
+	b = swap ? ay : ax;
+
+	big = a > b * tan_pio8;
+	num = big ? a - b : a;
+	den = big ? a + b : b;
+	/* atan2(+-0, +-0): both a and b are 0. */
+	den = (den == 0.0) ? 1.0 : den;
+
+	r = atan_poly(num / den) + (big ? pi_o_4 : 0.0);
+	r = swap ? pi_o_2 - r : r;
+	r = (hx < 0) ? pi - r : r;
+
+	return (hy < 0) ? -r : r;
+}
+
+void vatan2f(float* z, const float* y, const float* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		float vy = y[i];
+		float vx = x[i];
+		int32_t hy, hx;
+
+		GET_FLOAT_WORD(hy, vy);
+		GET_FLOAT_WORD(hx, vx);
+
+		if ((hy & 0x7fffffff) < 0x7f800000 && (hx & 0x7fffffff) < 0x7f800000)
+			z[i] = vatan2f_finite(hy, hx);
+		else
+			z[i] = atan2f(vy, vx);
+	}
+}
+
+#endif /* POK_NEEDS_LIBMATH */
@@ -0,0 +1,39 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifdef POK_NEEDS_LIBMATH
+
+#include <libm.h>
+#include "vmath_private.h"
+
+void vcosf(float* y, const float* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		float v = x[i];
+		int32_t ix;
+
+		GET_FLOAT_WORD(ix, v);
+		ix &= 0x7fffffff;
+
+		if (ix < VM_TRIG_LIMIT)
+			y[i] = __vsincosf(v, 1);
+		else
+			y[i] = cosf(v);
+	}
+}
+
+#endif /* POK_NEEDS_LIBMATH */
@@ -0,0 +1,81 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifdef POK_NEEDS_LIBMATH
+
+#include <libm.h>
+#include "vmath_private.h"
+
+/*
+ * x = k*ln2 + r, |r| <= ln2/2; exp(x) = 2^k * exp(r).
+ *
+ * exp(r) is Taylor polynomial of degree 8, its error is less than
+ * |r|^9/9! < 2^-32.
+ */
+static const double
+invln2 = 1.44269504088896338700e+00, /* 0x3FF71547, 0x652B82FE */
+ln2    = 6.93147180559945286227e-01, /* 0x3FE62E42, 0xFEFA39EF */
+E2 = 1.0 / 2,
+E3 = 1.0 / 6,
+E4 = 1.0 / 24,
+E5 = 1.0 / 120,
+E6 = 1.0 / 720,
+E7 = 1.0 / 5040,
+E8 = 1.0 / 40320;
+
+/*
+ * Outside of these bounds float result is Inf or 0 correspondingly.
+ * Clamping keeps 2^k in the range of double.
+ */
+static const double
+x_max = 89.0,
+x_min = -104.0;
+
+static inline float vexpf_finite(float x)
+{
+	double t = x;
+	int32_t k;
+	double r, z, p;
+
+	t = (t > x_max) ? x_max : t;
+	t = (t < x_min) ? x_min : t;
+
+	k = __vround(t * invln2);
+	r = t - k*ln2;
+	z = r*r;
+
+	p = 1.0 + r + z*((E2 + r*E3) + z*((E4 + r*E5) + z*((E6 + r*E7) + z*E8)));
+
+	return p * __vscale(k);
+}
+
+void vexpf(float* y, const float* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		float v = x[i];
+		int32_t ix;
+
+		GET_FLOAT_WORD(ix, v);
+
+		if ((ix & 0x7fffffff) < 0x7f800000)
+			y[i] = vexpf_finite(v);
+		else
+			y[i] = expf(v);
+	}
+}
+
+#endif /* POK_NEEDS_LIBMATH */
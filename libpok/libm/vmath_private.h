@@ -0,0 +1,117 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * Helpers for the batch functions (vsinf() and others).
+ *
+ * Every element is computed in double precision by straight-line code
+ * with selects instead of branches, so the loops over arrays may be
+ * vectorized by the compiler when the target has SIMD unit, and
+ * pipelined well by the FPU otherwise. Only rare arguments (huge, Inf,
+ * NaN) are passed to the scalar functions.
+ */
+
+#ifdef POK_NEEDS_LIBMATH
+
+#ifndef _VMATH_PRIVATE_H_
+#define _VMATH_PRIVATE_H_
+
+#include <types.h>
+#include "math_private.h"
+
+/* Round to the nearest integer, halfway cases away from zero. */
+static inline int32_t __vround(double x)
+{
+	return (int32_t)(x < 0 ? x - 0.5 : x + 0.5);
+}
+
+/* Return 2^k for -1022 <= k <= 1023. */
+static inline double __vscale(int32_t k)
+{
+	double d;
+	INSERT_WORDS(d, (uint32_t)(k + 1023) << 20, 0);
+	return d;
+}
+
+/*
+ * Reduction of trigonometric arguments: x = n*(pi/2) + r, |r| <= pi/4.
+ *
+ * PIO2_1 has 33 bits, so n*PIO2_1 is exact while |n| < 2^20.
+ */
+#define VM_INVPIO2	6.36619772367581382433e-01 /* 0x3FE45F30, 0x6DC9C883 */
+#define VM_PIO2_1	1.57079632673412561417e+00 /* 0x3FF921FB, 0x54400000 */
+#define VM_PIO2_1T	6.07710050650619224932e-11 /* 0x3DD0B461, 0x1A626331 */
+
+/* Bits of the float 2^19: |x| below it is reduced without __ieee754_rem_pio2f(). */
+#define VM_TRIG_LIMIT	0x49000000
+/* Bits of the float 2^-12: sin(x) rounds to x below it. */
+#define VM_SIN_TINY	0x39800000
+
+/*
+ * Polynomials for sin(r) and cos(r), |r| <= pi/4:
+ *
+ *     |sin(r)/r - s(r)| < 2^-37.5,  |cos(r) - c(r)| < 2^-34.1
+ *
+ * (coefficients are from FreeBSD's k_sinf.c and k_cosf.c).
+ */
+#define VM_S1	-0x15555554cbac77.0p-55	/* -0.166666666416265235595 */
+#define VM_S2	 0x111110896efbb2.0p-59	/*  0.0083333293858894631756 */
+#define VM_S3	-0x1a00f9e2cae774.0p-65	/* -0.000198393348360966317347 */
+#define VM_S4	 0x16cd878c3b46a7.0p-71	/*  0.0000027183114939898219064 */
+
+#define VM_C0	-0x1ffffffd0c5e81.0p-54	/* -0.499999997251031003120 */
+#define VM_C1	 0x155553e1053a42.0p-57	/*  0.0416666233237390631894 */
+#define VM_C2	-0x16c087e80f1e27.0p-62	/* -0.00138867637746099294692 */
+#define VM_C3	 0x199342e0ee5069.0p-68	/*  0.0000243904487962774090654 */
+
+static inline double __vsin_poly(double r)
+{
+	double z = r*r;
+	double w = z*z;
+	double s = z*r;
+
+	return (r + s*(VM_S1 + z*VM_S2)) + s*w*(VM_S3 + z*VM_S4);
+}
+
+static inline double __vcos_poly(double r)
+{
+	double z = r*r;
+	double w = z*z;
+
+	return ((1.0 + z*VM_C0) + w*VM_C1) + (w*z)*(VM_C2 + z*VM_C3);
+}
+
+/*
+ * Return sin(x + quadrant*pi/2) for |x| < 2^19.
+ *
+ * quadrant is 0 for sin(x) and 1 for cos(x).
+ */
+static inline float __vsincosf(float x, int32_t quadrant)
+{
+	double t = x;
+	int32_t n = __vround(t * VM_INVPIO2);
+	double r = (t - n*VM_PIO2_1) - n*VM_PIO2_1T;
+	double s = __vsin_poly(r);
+	double c = __vcos_poly(r);
+	double v;
+
+	n += quadrant;
+	v = (n & 1) ? c : s;
+	return (n & 2) ? -v : v;
+}
+
+#endif /* _VMATH_PRIVATE_H_ */
+
+#endif /* POK_NEEDS_LIBMATH */
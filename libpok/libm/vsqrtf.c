@@ -0,0 +1,90 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifdef POK_NEEDS_LIBMATH
+
+#include <libm.h>
+#include "vmath_private.h"
+
+#ifdef LIBM_HAS_HW_SQRT
+
+void vsqrtf(float* y, const float* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		y[i] = __hw_sqrtf(x[i]);
+}
+
+#else
+
+/*
+ * sqrt(x) for positive normal x.
+ *
+ * Estimate of 1/sqrt(x) from the bits of x (relative error < 2^-8) is
+ * refined by three Newton iterations in double, which gives sqrt(x)
+ * with relative error about 2^-50. Rounded to float, it may be off by
+ * one ulp; that is corrected by comparing x with squares of the
+ * midpoints between neighbour floats, which are exact in double.
+ */
+static inline float vsqrtf_normal(float x, int32_t ix)
+{
+	double d = x;
+	float g, f, f_up, f_down;
+	double e, s, m_up, m_down;
+	int32_t iv;
+
+	SET_FLOAT_WORD(g, 0x5f375a86 - (ix >> 1));
+	e = g;
+	e = e * (1.5 - 0.5 * d * e * e);
+	e = e * (1.5 - 0.5 * d * e * e);
+	e = e * (1.5 - 0.5 * d * e * e);
+	s = d * e;
+
+	f = (float)s;
+	GET_FLOAT_WORD(iv, f);
+	SET_FLOAT_WORD(f_up, iv + 1);
+	SET_FLOAT_WORD(f_down, iv - 1);
+
+	m_up = ((double)f + f_up) * 0.5;
+	m_down = ((double)f + f_down) * 0.5;
+
+	f = (m_up * m_up < d) ? f_up : f;
+	f = (m_down * m_down > d) ? f_down : f;
+
+	return f;
+}
+
+void vsqrtf(float* y, const float* x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		float v = x[i];
+		int32_t ix;
+
+		GET_FLOAT_WORD(ix, v);
+
+		/* Zeroes, negatives, subnormals, Inf and NaN are rare. */
+		if (ix >= 0x00800000 && ix < 0x7f800000)
+			y[i] = vsqrtf_normal(v, ix);
+		else
+			y[i] = __ieee754_sqrtf(v);
+	}
+}
+
+#endif /* LIBM_HAS_HW_SQRT */
+
+#endif /* POK_NEEDS_LIBMATH */
@@ -0,0 +1,215 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+/*
+ * State is kept as four big-endian columns, so the same code works
+ * on both x86 and PowerPC.
+ *
+ * Hardware AES (AES-NI) isn't used: the kernel neither enables SSE
+ * nor saves XMM registers on context switch.
+ */
+
+#include <protocols/aes.h>
+#include "aes_local.h"
+#include "aes_tables.h"
+
+static const uint32_t aes_rcon[10] = {
+    0x01000000u, 0x02000000u, 0x04000000u, 0x08000000u, 0x10000000u,
+    0x20000000u, 0x40000000u, 0x80000000u, 0x1b000000u, 0x36000000u,
+};
+
+#define ROR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+#define TE0(x) aes_te0[(x) >> 24]
+#define TE1(x) ROR(aes_te0[((x) >> 16) & 0xff], 8)
+#define TE2(x) ROR(aes_te0[((x) >> 8) & 0xff], 16)
+#define TE3(x) ROR(aes_te0[(x) & 0xff], 24)
+
+#define TD0(x) aes_td0[(x) >> 24]
+#define TD1(x) ROR(aes_td0[((x) >> 16) & 0xff], 8)
+#define TD2(x) ROR(aes_td0[((x) >> 8) & 0xff], 16)
+#define TD3(x) ROR(aes_td0[(x) & 0xff], 24)
+
+static uint32_t sub_word(uint32_t w)
+{
+    return ((uint32_t)aes_sbox[w >> 24] << 24)
+        | ((uint32_t)aes_sbox[(w >> 16) & 0xff] << 16)
+        | ((uint32_t)aes_sbox[(w >> 8) & 0xff] << 8)
+        | aes_sbox[w & 0xff];
+}
+
+pok_ret_t aes_set_encrypt_key(struct aes_key *key, const uint8_t *user_key,
+    size_t key_bits)
+{
+    uint32_t *rk = key->rk;
+    int nk, total, i;
+
+    switch (key_bits) {
+    case 128: nk = 4; break;
+    case 192: nk = 6; break;
+    case 256: nk = 8; break;
+    default:
+        return POK_ERRNO_PARAM;
+    }
+
+    key->rounds = nk + 6;
+    total = 4 * (key->rounds + 1);
+
+    for (i = 0; i < nk; i++)
+        rk[i] = aes_load_be32(user_key + 4 * i);
+
+    for (i = nk; i < total; i++) {
+        uint32_t temp = rk[i - 1];
+
+        if (i % nk == 0)
+            temp = sub_word(ROR(temp, 24)) ^ aes_rcon[i / nk - 1];
+        else if (nk == 8 && i % nk == 4)
+            temp = sub_word(temp);
+
+        rk[i] = rk[i - nk] ^ temp;
+    }
+
+    return POK_ERRNO_OK;
+}
+
+/*
+ * Equivalent inverse cipher: round keys go in reverse order, and
+ * InvMixColumns is applied to all of them but the first and the last.
+ */
+pok_ret_t aes_set_decrypt_key(struct aes_key *key, const uint8_t *user_key,
+    size_t key_bits)
+{
+    struct aes_key enc;
+    pok_ret_t ret;
+    int r, i;
+
+    ret = aes_set_encrypt_key(&enc, user_key, key_bits);
+    if (ret != POK_ERRNO_OK)
+        return ret;
+
+    key->rounds = enc.rounds;
+
+    for (r = 0; r <= enc.rounds; r++) {
+        const uint32_t *src = enc.rk + 4 * (enc.rounds - r);
+        uint32_t *dst = key->rk + 4 * r;
+
+        for (i = 0; i < 4; i++) {
+            uint32_t w = src[i];
+
+            if (r != 0 && r != enc.rounds) {
+                // Td(S(x)) is InvMixColumns of the column.
+                w = TD0(sub_word(w)) ^ TD1(sub_word(w)) ^ TD2(sub_word(w))
+                    ^ TD3(sub_word(w));
+            }
+            dst[i] = w;
+        }
+    }
+
+    return POK_ERRNO_OK;
+}
+
+void aes_encrypt_words(const struct aes_key *key, const uint32_t in[4],
+    uint32_t out[4])
+{
+    const uint32_t *rk = key->rk;
+    uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+    int r;
+
+    s0 = in[0] ^ rk[0];
+    s1 = in[1] ^ rk[1];
+    s2 = in[2] ^ rk[2];
+    s3 = in[3] ^ rk[3];
+
+    for (r = 1; r < key->rounds; r++) {
+        rk += 4;
+        t0 = TE0(s0) ^ TE1(s1) ^ TE2(s2) ^ TE3(s3) ^ rk[0];
+        t1 = TE0(s1) ^ TE1(s2) ^ TE2(s3) ^ TE3(s0) ^ rk[1];
+        t2 = TE0(s2) ^ TE1(s3) ^ TE2(s0) ^ TE3(s1) ^ rk[2];
+        t3 = TE0(s3) ^ TE1(s0) ^ TE2(s1) ^ TE3(s2) ^ rk[3];
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    rk += 4;
+
+#define LAST_ENC(a, b, c, d, k) \
+    (((uint32_t)aes_sbox[(a) >> 24] << 24) \
+     ^ ((uint32_t)aes_sbox[((b) >> 16) & 0xff] << 16) \
+     ^ ((uint32_t)aes_sbox[((c) >> 8) & 0xff] << 8) \
+     ^ (uint32_t)aes_sbox[(d) & 0xff] ^ (k))
+
+    out[0] = LAST_ENC(s0, s1, s2, s3, rk[0]);
+    out[1] = LAST_ENC(s1, s2, s3, s0, rk[1]);
+    out[2] = LAST_ENC(s2, s3, s0, s1, rk[2]);
+    out[3] = LAST_ENC(s3, s0, s1, s2, rk[3]);
+
+#undef LAST_ENC
+}
+
+void aes_decrypt_words(const struct aes_key *key, const uint32_t in[4],
+    uint32_t out[4])
+{
+    const uint32_t *rk = key->rk;
+    uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+    int r;
+
+    s0 = in[0] ^ rk[0];
+    s1 = in[1] ^ rk[1];
+    s2 = in[2] ^ rk[2];
+    s3 = in[3] ^ rk[3];
+
+    for (r = 1; r < key->rounds; r++) {
+        rk += 4;
+        t0 = TD0(s0) ^ TD1(s3) ^ TD2(s2) ^ TD3(s1) ^ rk[0];
+        t1 = TD0(s1) ^ TD1(s0) ^ TD2(s3) ^ TD3(s2) ^ rk[1];
+        t2 = TD0(s2) ^ TD1(s1) ^ TD2(s0) ^ TD3(s3) ^ rk[2];
+        t3 = TD0(s3) ^ TD1(s2) ^ TD2(s1) ^ TD3(s0) ^ rk[3];
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    rk += 4;
+
+#define LAST_DEC(a, b, c, d, k) \
+    (((uint32_t)aes_inv_sbox[(a) >> 24] << 24) \
+     ^ ((uint32_t)aes_inv_sbox[((b) >> 16) & 0xff] << 16) \
+     ^ ((uint32_t)aes_inv_sbox[((c) >> 8) & 0xff] << 8) \
+     ^ (uint32_t)aes_inv_sbox[(d) & 0xff] ^ (k))
+
+    out[0] = LAST_DEC(s0, s3, s2, s1, rk[0]);
+    out[1] = LAST_DEC(s1, s0, s3, s2, rk[1]);
+    out[2] = LAST_DEC(s2, s1, s0, s3, rk[2]);
+    out[3] = LAST_DEC(s3, s2, s1, s0, rk[3]);
+
+#undef LAST_DEC
+}
+
+void aes_encrypt_block(const struct aes_key *key,
+    const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
+    uint32_t s[4];
+
+    aes_load_block(s, in);
+    aes_encrypt_words(key, s, s);
+    aes_store_block(out, s);
+}
+
+void aes_decrypt_block(const struct aes_key *key,
+    const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
+    uint32_t s[4];
+
+    aes_load_block(s, in);
+    aes_decrypt_words(key, s, s);
+    aes_store_block(out, s);
+}
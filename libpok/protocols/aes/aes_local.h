@@ -0,0 +1,64 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __LIBPOK_PROTOCOLS_AES_LOCAL_H__
+#define __LIBPOK_PROTOCOLS_AES_LOCAL_H__
+
+/* Internal interface between block function and modes. */
+
+#include <protocols/aes.h>
+
+static inline uint32_t aes_load_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16)
+        | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void aes_store_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static inline void aes_load_block(uint32_t s[4], const uint8_t *p)
+{
+    s[0] = aes_load_be32(p);
+    s[1] = aes_load_be32(p + 4);
+    s[2] = aes_load_be32(p + 8);
+    s[3] = aes_load_be32(p + 12);
+}
+
+static inline void aes_store_block(uint8_t *p, const uint32_t s[4])
+{
+    aes_store_be32(p, s[0]);
+    aes_store_be32(p + 4, s[1]);
+    aes_store_be32(p + 8, s[2]);
+    aes_store_be32(p + 12, s[3]);
+}
+
+/*
+ * Block function over the state in words.
+ *
+ * Modes keep counter and chaining value in this form between blocks,
+ * so they are converted from bytes only once per message.
+ */
+void aes_encrypt_words(const struct aes_key *key, const uint32_t in[4],
+    uint32_t out[4]);
+void aes_decrypt_words(const struct aes_key *key, const uint32_t in[4],
+    uint32_t out[4]);
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <protocols/aes.h>
+#include "aes_local.h"
+
+static inline void ctr_increment(uint32_t c[4])
+{
+    int i;
+
+    for (i = 3; i >= 0; i--) {
+        if (++c[i] != 0)
+            break;
+    }
+}
+
+void aes_ctr_crypt(const struct aes_key *key, uint8_t counter[AES_BLOCK_SIZE],
+    const void *in, void *out, size_t len)
+{
+    const uint8_t *src = in;
+    uint8_t *dst = out;
+    uint32_t c[4], ks[4];
+    int i;
+
+    aes_load_block(c, counter);
+
+    for (; len >= AES_BLOCK_SIZE; len -= AES_BLOCK_SIZE) {
+        aes_encrypt_words(key, c, ks);
+        ctr_increment(c);
+
+        for (i = 0; i < 4; i++)
+            aes_store_be32(dst + 4 * i, aes_load_be32(src + 4 * i) ^ ks[i]);
+
+        src += AES_BLOCK_SIZE;
+        dst += AES_BLOCK_SIZE;
+    }
+
+    if (len > 0) {
+        uint8_t ks_bytes[AES_BLOCK_SIZE];
+        size_t j;
+
+        aes_encrypt_words(key, c, ks);
+        ctr_increment(c);
+
+        aes_store_block(ks_bytes, ks);
+        for (j = 0; j < len; j++)
+            dst[j] = src[j] ^ ks_bytes[j];
+    }
+
+    aes_store_block(counter, c);
+}
+
+pok_ret_t aes_cbc_encrypt(const struct aes_key *key, uint8_t iv[AES_BLOCK_SIZE],
+    const void *in, void *out, size_t len)
+{
+    const uint8_t *src = in;
+    uint8_t *dst = out;
+    uint32_t v[4];
+    int i;
+
+    if (len % AES_BLOCK_SIZE)
+        return POK_ERRNO_SIZE;
+
+    aes_load_block(v, iv);
+
+    for (; len > 0; len -= AES_BLOCK_SIZE) {
+        for (i = 0; i < 4; i++)
+            v[i] ^= aes_load_be32(src + 4 * i);
+
+        aes_encrypt_words(key, v, v);
+        aes_store_block(dst, v);
+
+        src += AES_BLOCK_SIZE;
+        dst += AES_BLOCK_SIZE;
+    }
+
+    aes_store_block(iv, v);
+
+    return POK_ERRNO_OK;
+}
+
+pok_ret_t aes_cbc_decrypt(const struct aes_key *key, uint8_t iv[AES_BLOCK_SIZE],
+    const void *in, void *out, size_t len)
+{
+    const uint8_t *src = in;
+    uint8_t *dst = out;
+    uint32_t v[4], c[4], p[4];
+    int i;
+
+    if (len % AES_BLOCK_SIZE)
+        return POK_ERRNO_SIZE;
+
+    aes_load_block(v, iv);
+
+    for (; len > 0; len -= AES_BLOCK_SIZE) {
+        // Ciphertext is loaded before it may be overwritten in-place.
+        aes_load_block(c, src);
+        aes_decrypt_words(key, c, p);
+
+        for (i = 0; i < 4; i++) {
+            p[i] ^= v[i];
+            v[i] = c[i];
+        }
+
+        aes_store_block(dst, p);
+
+        src += AES_BLOCK_SIZE;
+        dst += AES_BLOCK_SIZE;
+    }
+
+    aes_store_block(iv, v);
+
+    return POK_ERRNO_OK;
+}
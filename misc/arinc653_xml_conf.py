@@ -110,6 +110,8 @@ class ArincConfigParser:
 
         conf.network = self.parse_network(root.find("Network"))
 
+        self.parse_profiler(conf, root.find("Profiler"))
+
         mem_blocks = root.find("Memory_Blocks")
         if mem_blocks is not None:
             for mem_block_root in mem_blocks.findall("Memory_Block"):
@@ -144,6 +146,10 @@ class ArincConfigParser:
         part.heap = heap_size
 
         part.num_threads = int(part_root.find("Threads").attrib["Count"])
+        if "Kernel_Stack_Size" in part_root.find("Threads").attrib:
+            part.kernel_stack_size = parse_bytes(part_root.find("Threads").attrib["Kernel_Stack_Size"])
+        if "Kernel_Stacks" in part_root.find("Threads").attrib:
+            part.kernel_stacks = int(part_root.find("Threads").attrib["Kernel_Stacks"])
 
         part.num_arinc653_buffers = int(part_root.find("ARINC653_Buffers").attrib["Count"])
         part.num_arinc653_blackboards = int(part_root.find("ARINC653_Blackboards").attrib["Count"])
@@ -151,14 +157,38 @@ class ArincConfigParser:
         part.num_arinc653_semaphores = int(part_root.find("ARINC653_Semaphores").attrib["Count"])
 
         part.buffer_data_size = parse_bytes(part_root.find("ARINC653_Buffers").attrib["Data_Size"])
+
+        for buffer_root in part_root.find("ARINC653_Buffers").findall("Buffer"):
+            if buffer_root.attrib.get("Storage", "Slots").lower() != "packed":
+                continue
+            part.buffers_packed.append((buffer_root.attrib["Name"],
+                parse_bytes(buffer_root.attrib["Max_Bytes"])))
         part.blackboard_data_size = parse_bytes(part_root.find("ARINC653_Blackboards").attrib["Data_Size"])
 
         self.parse_ports(part, part_root.find("ARINC653_Ports"))
 
+        self.parse_processes(part, part_root.find("Processes"))
+
         self.parse_hm(part.hm_table, part_root.find("HM_Table"))
 
         self.parse_partition_memory_blocks(part, part_root.find("Memory_Blocks"))
 
+    def parse_processes(self, part, processes_root):
+        if processes_root is None:
+            return
+
+        for proc in processes_root.findall("Process"):
+            deadline = None
+            if "Deadline" in proc.attrib:
+                deadline = parse_time(proc.attrib["Deadline"])
+
+            part.processes.append(chpok_configuration.ProcessTiming(
+                proc.attrib["Name"],
+                int(proc.attrib["Priority"]),
+                parse_time(proc.attrib["Period"]),
+                parse_time(proc.attrib["WCET"]),
+                deadline))
+
     def parse_schedule(self, conf, slot_root):
         for x in slot_root.findall("Slot"):
             slot_type = x.attrib["Type"]
@@ -222,9 +252,17 @@ class ArincConfigParser:
         for ch in channels_root.findall("Channel"):
 
             src = self.parse_connection(conf, ch.find("Source")[0])
-            dst = self.parse_connection(conf, ch.find("Destination")[0])
+            # Channel with several destinations is multicast one.
+            dsts = [self.parse_connection(conf, dst_root[0])
+                for dst_root in ch.findall("Destination")]
+
+            # Storage of messages, meaningful only for queueing channel.
+            storage = ch.attrib.get("Storage", "Slots").lower()
+            max_nb_bytes = None
+            if "Max_Bytes" in ch.attrib:
+                max_nb_bytes = parse_bytes(ch.attrib["Max_Bytes"])
 
-            conf.add_channel(src, dst)
+            conf.add_channel(src, dsts, storage, max_nb_bytes)
 
     def parse_connection(self, conf, connection_root):
         if connection_root.tag == "Standard_Partition":
@@ -245,6 +283,13 @@ class ArincConfigParser:
         else:
             raise RuntimeError("unknown connection tag name %r" % connection_root.tag)
 
+    def parse_profiler(self, conf, root):
+        if root is None:
+            return
+
+        conf.profiler_period = int(root.attrib.get("Ticks_Per_Sample", "1"))
+        conf.profiler_histogram_size = int(root.attrib.get("Histogram_Size", "1024"))
+
     def parse_network(self, root):
         if root is None:
             return None
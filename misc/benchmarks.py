@@ -0,0 +1,196 @@
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+
+
+
+"""
+Collect results of examples/benchmarks and compare them with a baseline.
+
+Results are taken from the console output: lines
+
+    [BENCH] <name> n=<samples> min=<ticks> avg=<ticks> max=<ticks>
+    [BENCH] end <partition>
+
+Usage:
+
+    benchmarks.py [options] [console.log]
+
+Options:
+
+    --command CMD           Run CMD (e.g. "scons run" in the example's
+                            directory) and read its output instead of
+                            the log. CMD is killed when all partitions
+                            report the end of results.
+    --timeout SEC           Maximum running time of CMD (default 60).
+    --expect LIST           Comma-separated partitions, which should
+                            report results
+                            (default SCHED,PORTS,SWITCH,CRYPTO,MATH).
+    --save FILE             Store results into FILE (JSON).
+    --baseline FILE         Compare results with ones stored in FILE.
+    --metric NAME           Value to compare: min (default), avg or max.
+    --threshold PERCENT     Allowed slowdown (default 10).
+
+Exit status is 1 if some benchmark is slower than the baseline by more
+than the threshold or is missed, 0 otherwise.
+
+Values are timebase ticks, so only runs on the same board (and the same
+QEMU version) may be compared. Under QEMU 'min' is the most stable value.
+"""
+
+import json
+import re
+import shlex
+import subprocess
+import sys
+import threading
+from optparse import OptionParser
+
+BENCH_RE = re.compile(r"\[BENCH\] (\S+) n=(\d+)(?: min=(\d+) avg=(\d+) max=(\d+))?\s*$")
+END_RE = re.compile(r"\[BENCH\] end (\S+)\s*$")
+
+
+class Collector(object):
+    def __init__(self, expect):
+        self.results = {}
+        self.pending = set(expect)
+
+    def feed(self, line):
+        """Process one line of output. Return True when all results are collected."""
+        m = END_RE.search(line)
+        if m:
+            self.pending.discard(m.group(1))
+            return not self.pending
+
+        m = BENCH_RE.search(line)
+        if m:
+            result = {"n": int(m.group(2))}
+            if result["n"] != 0:
+                result["min"] = int(m.group(3))
+                result["avg"] = int(m.group(4))
+                result["max"] = int(m.group(5))
+            self.results[m.group(1)] = result
+
+        return False
+
+
+def collect_from_file(collector, f):
+    for line in f:
+        if collector.feed(line):
+            break
+
+
+def collect_from_command(collector, command, timeout):
+    proc = subprocess.Popen(shlex.split(command), stdout = subprocess.PIPE,
+        stderr = subprocess.STDOUT, universal_newlines = True)
+
+    timer = threading.Timer(timeout, proc.kill)
+    timer.start()
+    try:
+        for line in iter(proc.stdout.readline, ""):
+            sys.stdout.write(line)
+            if collector.feed(line):
+                break
+    finally:
+        timer.cancel()
+        if proc.poll() is None:
+            proc.kill()
+        proc.wait()
+
+
+def compare(baseline, results, metric, threshold):
+    """Print comparison table. Return number of regressions."""
+    nb_regressions = 0
+
+    print("%-28s %12s %12s %8s" % ("benchmark", "baseline", "current", "change"))
+    for name in sorted(set(baseline) | set(results)):
+        base = baseline.get(name, {}).get(metric)
+        cur = results.get(name, {}).get(metric)
+
+        if base is None:
+            print("%-28s %12s %12d %8s" % (name, "-", cur, "new"))
+            continue
+        if cur is None:
+            print("%-28s %12d %12s %8s REGRESSION" % (name, base, "-", "missed"))
+            nb_regressions += 1
+            continue
+
+        change = (cur - base) * 100.0 / base if base else 0.0
+        mark = ""
+        if change > threshold:
+            mark = " REGRESSION"
+            nb_regressions += 1
+        print("%-28s %12d %12d %+7.1f%%%s" % (name, base, cur, change, mark))
+
+    return nb_regressions
+
+
+def main():
+    parser = OptionParser(usage = "%prog [options] [console.log]")
+    parser.add_option("--command")
+    parser.add_option("--timeout", type = "float", default = 60)
+    parser.add_option("--expect", default = "SCHED,PORTS,SWITCH,CRYPTO,MATH")
+    parser.add_option("--save")
+    parser.add_option("--baseline")
+    parser.add_option("--metric", choices = ["min", "avg", "max"], default = "min")
+    parser.add_option("--threshold", type = "float", default = 10)
+
+    (options, args) = parser.parse_args()
+
+    collector = Collector(options.expect.split(","))
+
+    if options.command:
+        if args:
+            parser.error("Log file cannot be used together with --command")
+        collect_from_command(collector, options.command, options.timeout)
+    else:
+        if len(args) != 1:
+            parser.error("Exactly one log file is expected")
+        with open(args[0]) as f:
+            collect_from_file(collector, f)
+
+    if collector.pending:
+        sys.stderr.write("No results from partitions: %s\n"
+            % ", ".join(sorted(collector.pending)))
+
+    results = dict((name, result) for (name, result) in collector.results.items()
+        if result["n"] != 0)
+
+    if options.save:
+        with open(options.save, "w") as f:
+            json.dump(results, f, indent = 4, sort_keys = True)
+            f.write("\n")
+
+    if options.baseline:
+        with open(options.baseline) as f:
+            baseline = json.load(f)
+        if compare(baseline, results, options.metric, options.threshold):
+            sys.exit(1)
+    elif not options.save:
+        for name in sorted(results):
+            result = results[name]
+            print("%-28s n=%-5d min=%-10d avg=%-10d max=%d" % (name,
+                result["n"], result["min"], result["avg"], result["max"]))
+
+    if collector.pending:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
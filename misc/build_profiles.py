@@ -0,0 +1,197 @@
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+
+"""
+Compare build profiles by code size and examples/benchmarks results.
+
+For every profile the example in the current directory is rebuilt with
+
+    scons profile=<profile> lto=<0|1> [bsp=<bsp>]
+
+then sizes of executable sections of the kernel and partitions are
+measured and benchmarks are run with "scons ... run".
+
+Usage (from examples/benchmarks):
+
+    build_profiles.py [options]
+
+Options:
+
+    --profiles LIST         Comma-separated profiles; "+lto" suffix
+                            enables link-time optimization (default
+                            default,speed,size,speed+lto,size+lto).
+    --bsp BSP               Board to build for (default: POK_BSP or
+                            e500mc, as for scons).
+    --timeout SEC           Maximum running time of every run (default 60).
+    --expect LIST           Comma-separated partitions, which should
+                            report results
+                            (default SCHED,PORTS,SWITCH,CRYPTO,MATH).
+    --metric NAME           Benchmark value to report: min (default),
+                            avg or max.
+    --save FILE             Store sizes and results of all profiles
+                            into FILE (JSON).
+
+Text sizes are in bytes, benchmark values are timebase ticks.
+"""
+
+from __future__ import print_function
+
+import glob
+import json
+import os
+import struct
+import subprocess
+import sys
+from optparse import OptionParser
+
+import benchmarks
+
+DEFAULT_PROFILES = "default,speed,size,speed+lto,size+lto"
+
+_EHDR_FORMAT = "16sHHIIIIIHHHHHH"
+_SHDR_FORMAT = "IIIIIIIIII"
+
+# Section flag: section contains executable instructions.
+SHF_EXECINSTR = 0x4
+
+def text_size(path):
+    """ Return total size of executable sections of given ELF file. """
+    with open(path, 'rb') as f:
+        elf = f.read()
+
+    if elf[0:4] != b"\x7fELF":
+        raise RuntimeError("%s is not an ELF" % path)
+
+    # EI_DATA: 1 - little endian, 2 - big endian.
+    endian = "<" if bytearray(elf)[5] == 1 else ">"
+
+    ehdr = struct.unpack_from(endian + _EHDR_FORMAT, elf, 0)
+    shoff = ehdr[6]
+    shentsize = ehdr[11]
+    shnum = ehdr[12]
+
+    size = 0
+    for i in range(shnum):
+        shdr = struct.unpack_from(endian + _SHDR_FORMAT, elf, shoff + i * shentsize)
+        if shdr[2] & SHF_EXECINSTR:
+            size += shdr[5] # sh_size
+
+    return size
+
+
+def parse_profile(name):
+    """ Return (profile, lto) for given profile name. """
+    if name.endswith("+lto"):
+        return (name[:-len("+lto")], True)
+    return (name, False)
+
+
+def scons_command(name, bsp):
+    (profile, lto) = parse_profile(name)
+    return "scons profile=%s lto=%d bsp=%s" % (profile, 1 if lto else 0, bsp)
+
+
+def measure(name, options):
+    """ Build and run the example with given profile. Return its report. """
+    command = scons_command(name, options.bsp)
+
+    subprocess.check_call(command, shell = True)
+
+    build_dir = os.path.join("build", options.bsp, "")
+    kernel_text = text_size(build_dir + "pok.elf")
+    partitions_text = sum(text_size(p)
+        for p in glob.glob(os.path.join("*", build_dir + "part.elf")))
+
+    collector = benchmarks.Collector(options.expect.split(","))
+    benchmarks.collect_from_command(collector, command + " run", options.timeout)
+
+    if collector.pending:
+        print("No results from partitions with profile %s: %s"
+            % (name, ", ".join(sorted(collector.pending))), file = sys.stderr)
+
+    results = dict((bench, result) for (bench, result) in collector.results.items()
+        if result["n"] != 0)
+
+    return {
+        "kernel_text": kernel_text,
+        "partitions_text": partitions_text,
+        "results": results,
+    }
+
+
+def print_report(profiles, reports, metric):
+    print("%-28s" % "", end = "")
+    for name in profiles:
+        print(" %12s" % name, end = "")
+    print("")
+
+    rows = [("kernel text", lambda r: r["kernel_text"]),
+        ("partitions text", lambda r: r["partitions_text"])]
+
+    benches = set()
+    for report in reports.values():
+        benches |= set(report["results"])
+    for bench in sorted(benches):
+        rows.append((bench,
+            lambda r, bench = bench: r["results"].get(bench, {}).get(metric)))
+
+    for (title, getter) in rows:
+        print("%-28s" % title, end = "")
+        for name in profiles:
+            value = getter(reports[name])
+            print(" %12s" % ("-" if value is None else value), end = "")
+        print("")
+
+
+def main():
+    parser = OptionParser(usage = "%prog [options]")
+    parser.add_option("--profiles", default = DEFAULT_PROFILES)
+    parser.add_option("--bsp", default = os.environ.get("POK_BSP", "e500mc"))
+    parser.add_option("--timeout", type = "float", default = 60)
+    parser.add_option("--expect", default = "SCHED,PORTS,SWITCH,CRYPTO,MATH")
+    parser.add_option("--metric", choices = ["min", "avg", "max"], default = "min")
+    parser.add_option("--save")
+
+    (options, args) = parser.parse_args()
+
+    if args:
+        parser.error("No arguments are expected")
+
+    profiles = options.profiles.split(",")
+    for name in profiles:
+        if parse_profile(name)[0] not in ("default", "speed", "size"):
+            parser.error("Unknown profile: %s" % name)
+
+    reports = {}
+    for name in profiles:
+        reports[name] = measure(name, options)
+
+    print_report(profiles, reports, options.metric)
+
+    if options.save:
+        with open(options.save, "w") as f:
+            json.dump(reports, f, indent = 4, sort_keys = True)
+            f.write("\n")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
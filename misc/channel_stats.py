@@ -0,0 +1,132 @@
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+
+
+"""
+Decode binary dump of channels' traffic statistics.
+
+Input is a console log containing output of 'channels_dump' monitor
+command (see pok_channels_dump_stats() in kernel/core/channel.c).
+
+Usage:
+
+    channel_stats.py [options] console.log
+
+Options:
+
+    --csv                   Output comma-separated values instead of table.
+
+For every side of the channel the maximum number of messages in its
+buffer is printed together with configured 'max_nb_message', so the
+latter may be adjusted according to field data.
+"""
+
+import re
+import struct
+import sys
+from optparse import OptionParser
+
+CHANNELS_RE = re.compile(r"\[CHANNELS\] ([0-9a-f]+)\s*$")
+
+HEADER_FORMAT = "<IHHI"
+MAGIC = 0x5453434a # "JCST"
+VERSION = 1
+
+RECORD_FORMAT = "<BBHIIIIIQqq"
+
+KINDS = {1: "queuing", 2: "sampling"}
+
+FIELDS = ["kind", "side", "channel", "max_nb_message", "nb_message_max",
+    "nb_messages", "nb_discarded", "nb_waits", "nb_bytes",
+    "wait_time_total", "wait_time_max"]
+
+
+def parse_dump(f):
+    """Return list of records (as dictionaries) of the last dump in the log."""
+    records = None
+    nb_records = 0
+
+    for line in f:
+        m = CHANNELS_RE.search(line)
+        if not m:
+            continue
+
+        data = bytearray.fromhex(m.group(1))
+
+        if records is None or len(records) == nb_records:
+            # Start of the new dump.
+            magic, version, record_size, nb_records = struct.unpack(HEADER_FORMAT, bytes(data))
+            if magic != MAGIC:
+                raise RuntimeError("Wrong magic of the dump: 0x%x" % magic)
+            if version != VERSION:
+                raise RuntimeError("Unsupported version of the dump: %d" % version)
+            if record_size != struct.calcsize(RECORD_FORMAT):
+                raise RuntimeError("Unexpected record size: %d" % record_size)
+            records = []
+            continue
+
+        record = dict(zip(FIELDS, struct.unpack(RECORD_FORMAT, bytes(data))))
+        record["kind"] = KINDS.get(record["kind"], "unknown")
+        records.append(record)
+
+    if records is None:
+        raise RuntimeError("No channels dump found")
+    if len(records) != nb_records:
+        raise RuntimeError("Dump is truncated: %d of %d records"
+            % (len(records), nb_records))
+
+    return records
+
+
+def main():
+    parser = OptionParser(usage = "%prog [options] console.log")
+    parser.add_option("--csv", action = "store_true", default = False)
+
+    (options, args) = parser.parse_args()
+
+    if len(args) != 1:
+        parser.error("Exactly one log file is expected")
+
+    with open(args[0]) as f:
+        records = parse_dump(f)
+
+    if options.csv:
+        print(",".join(FIELDS))
+        for record in records:
+            print(",".join(str(record[field]) for field in FIELDS))
+        return
+
+    print("%-8s %4s %-8s %5s %5s %10s %12s %8s %6s %10s %10s" % ("kind",
+        "chan", "side", "max", "high", "messages", "bytes", "discard",
+        "waits", "wait_avg", "wait_max"))
+    for record in records:
+        side = "send" if record["side"] == 0 else "recv %d" % (record["side"] - 1)
+        wait_avg = 0
+        if record["nb_waits"]:
+            wait_avg = record["wait_time_total"] // record["nb_waits"]
+        print("%-8s %4d %-8s %5d %5d %10d %12d %8d %6d %10d %10d" % (
+            record["kind"], record["channel"], side, record["max_nb_message"],
+            record["nb_message_max"], record["nb_messages"], record["nb_bytes"],
+            record["nb_discarded"], record["nb_waits"], wait_avg,
+            record["wait_time_max"]))
+
+
+if __name__ == "__main__":
+    main()
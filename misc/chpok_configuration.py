@@ -33,6 +33,19 @@ import functools
 import collections
 import ipaddr
 import math
+import response_time
+
+# Should be consistent with KERNEL_STACK_SIZE_DEFAULT in kernel/include/asp/arch.h.
+KERNEL_STACK_SIZE_DEFAULT = 8192
+
+MAIN_USER_STACK_SIZE_DEFAULT = 8192
+
+# Area reserved for user stack of every thread.
+USER_STACK_SIZE_DEFAULT = 8192
+
+# Kernel stacks are never tightened below this size: paths for errors
+# and interrupts may be missed while the footprint is recorded.
+KERNEL_STACK_SIZE_MIN = 2048
 
 
 class PartitionLayout():
@@ -255,6 +268,8 @@ class Partition:
         "heap",
 
         "num_threads", # number of user threads, _not_ counting init thread and error handler
+        "kernel_stack_size", # size of the kernel stack for every thread, None for default
+        "kernel_stacks", # number of threads with kernel stack, counting init thread and error handler; None for all
         "ports_queueing", # list of queuing ports
         "ports_sampling", # list of sampling ports
 
@@ -264,10 +279,15 @@ class Partition:
         "num_arinc653_events",
 
         "buffer_data_size", # bytes allocated for buffer data
+        "buffers_packed", # list of (name, max_nb_bytes) for buffers with packed storage
         "blackboard_data_size", # same, for blackboards
 
         "hm_table", # partition hm table
 
+        "processes", # list of ProcessTiming, for response-time analysis
+
+        "footprint", # MemoryFootprint for tightening memory sizes, None for configured sizes
+
         "ports_queueing_system", # list of queuing ports with non-empty protocol set
         "ports_sampling_system", # list of sampling ports with non-empty protocol set
 
@@ -291,6 +311,8 @@ class Partition:
         self.heap = 0
 
         self.num_threads = 0
+        self.kernel_stack_size = None
+        self.kernel_stacks = None
 
         self.num_arinc653_buffers = 0
         self.num_arinc653_blackboards = 0
@@ -300,8 +322,14 @@ class Partition:
         self.buffer_data_size = 0
         self.blackboard_data_size = 0
 
+        self.buffers_packed = []
+
         self.hm_table = PartitionHMTable()
 
+        self.processes = []
+
+        self.footprint = None
+
         self.ports_queueing = []
         self.ports_sampling = []
 
@@ -365,6 +393,18 @@ class Partition:
         if self.part_index is None:
             raise ValueError("Index is not set for partition '%s' (Partition is added via conf.add_partition(), isn't it?).")
 
+        if len(self.processes) > self.num_threads:
+            raise ValueError("Partition '%s' has timing of %d processes, but only %d threads" %
+                (self.name, len(self.processes), self.num_threads))
+
+        for proc in self.processes:
+            proc.validate()
+
+        if self.kernel_stacks is not None:
+            if self.kernel_stacks < 1 or self.kernel_stacks > self.get_needed_threads():
+                raise ValueError("Partition '%s' should have from 1 to %d kernel stacks, but %d are requested" %
+                    (self.name, self.get_needed_threads(), self.kernel_stacks))
+
         for port in self.ports_sampling + self.ports_queueing:
             port.validate()
             if port.channel_id is None:
@@ -402,21 +442,156 @@ class Partition:
     def get_event_size(self):
         return 50
 
+    # Return memory size, needed for messages of buffers and blackboards.
+    #
+    # Blackboards are double-buffered, so their data are allocated twice.
+    def get_messages_memory_size(self):
+        size = self.buffer_data_size + 2 * self.blackboard_data_size
+        if self.footprint is not None:
+            size = self.footprint.tighten(size, self.footprint.intra_used)
+        return size
+
     # Return memory size, needed by intra-partition communication mechanisms.
     def get_intra_size(self):
-        return ( self.buffer_data_size + self.blackboard_data_size
+        return ( self.get_messages_memory_size()
             + self.num_arinc653_buffers * self.get_buffer_size()
             + self.num_arinc653_blackboards * self.get_blackboard_size()
             + self.num_arinc653_semaphores * self.get_semaphore_size()
             + self.num_arinc653_events * self.get_event_size()
         )
 
+    # Return memory size, needed by per-thread buffers of stdout.
+    #
+    # Every buffer is BUFSIZ (128) bytes plus its position, aligned to 16.
+    # TODO: This should be arch-specific somehow.
+    def get_stdio_size(self):
+        return self.get_needed_threads() * 144 + 16 # alignment
+
     def get_heap_size(self):
-        heap_size = self.get_intra_size()
+        heap_size = self.get_intra_size() + self.get_stdio_size()
         if self.heap > 0:
             heap_size += self.heap + 16 # alignment. TODO: this should be arch-specific.
+        if self.footprint is not None:
+            # Messages memory is allocated from the heap, and it may be tightened too.
+            heap_used = (self.footprint.heap_used - self.footprint.intra_size
+                + self.get_messages_memory_size())
+            heap_size = self.footprint.tighten(heap_size, heap_used)
         return heap_size
 
+    # Return size of the kernel stack for every thread, None for default.
+    def get_kernel_stack_size(self):
+        if self.footprint is None:
+            return self.kernel_stack_size
+
+        size = self.kernel_stack_size
+        if size is None:
+            size = KERNEL_STACK_SIZE_DEFAULT
+        return self.footprint.tighten_kernel_stack(size)
+
+    def get_main_user_stack_size(self):
+        size = MAIN_USER_STACK_SIZE_DEFAULT
+        if self.footprint is not None:
+            size = self.footprint.tighten(size, self.footprint.main_stack_used)
+        return size
+
+    # Return size of the area for user stacks of all threads.
+    #
+    # Stack sizes of processes are chosen by the application, so only
+    # stacks of processes created in the profile may be smaller than
+    # the default. Processes which weren't created in the profile (e.g.,
+    # ones created under rare conditions) keep the default size, as does
+    # the error handler: it is reserved even if it has been profiled.
+    def get_user_stacks_size(self):
+        size = self.get_needed_threads() * USER_STACK_SIZE_DEFAULT
+        if self.footprint is not None:
+            needed = self.get_main_user_stack_size()
+            needed += USER_STACK_SIZE_DEFAULT # error handler
+            for stack_size in self.footprint.user_stacks:
+                needed += (stack_size + 15) & ~15
+            not_created = self.num_threads - len(self.footprint.user_stacks)
+            needed += max(not_created, 0) * USER_STACK_SIZE_DEFAULT
+            size = min(size, needed)
+        return size
+
+# Timing requirements of a process, used by response-time analysis.
+#
+# All times are in nanoseconds.
+#
+# - period - period of the process or minimal interval between its releases.
+# - wcet - worst-case execution time.
+# - deadline - relative deadline.
+class ProcessTiming:
+    __slots__ = [
+        "name",
+        "priority",
+        "period",
+        "wcet",
+        "deadline",
+    ]
+
+    def __init__(self, name, priority, period, wcet, deadline = None):
+        self.name = name
+        self.priority = priority
+        self.period = period
+        self.wcet = wcet
+        self.deadline = deadline if deadline is not None else period
+
+    def validate(self):
+        if self.period <= 0 or self.wcet <= 0 or self.deadline <= 0:
+            raise ValueError("Timing of process '%s' should be positive" % self.name)
+
+        if self.wcet > self.deadline:
+            raise ValueError("WCET of process '%s' exceeds its deadline" % self.name)
+
+        # Analysis considers only the first job after the critical instant,
+        # which is valid only when previous jobs complete before the release.
+        if self.deadline > self.period:
+            raise ValueError("Deadline of process '%s' exceeds its period" % self.name)
+
+# Memory usage of the partition, measured on the target.
+#
+# Filled from the profile recorded with misc/footprint.py. All sizes
+# are in bytes.
+#
+# - heap_used - heap allocated by smalloc(), including intra memory.
+# - intra_size - size of ARINC messages memory at the time of recording.
+# - intra_used - peak usage of ARINC messages memory.
+# - kernel_stack_used - high-water mark of kernel stacks among all threads.
+# - main_stack_used - high-water mark of the main thread's user stack.
+# - user_stacks - list of user stack sizes of threads, created by
+#   the partition (except the main thread).
+# - margin - factor applied to the measured values.
+class MemoryFootprint:
+    __slots__ = [
+        "heap_used",
+        "intra_size",
+        "intra_used",
+        "kernel_stack_used",
+        "main_stack_used",
+        "user_stacks",
+        "margin",
+    ]
+
+    def __init__(self, heap_used, intra_size, intra_used,
+        kernel_stack_used, main_stack_used, user_stacks, margin):
+        self.heap_used = heap_used
+        self.intra_size = intra_size
+        self.intra_used = intra_used
+        self.kernel_stack_used = kernel_stack_used
+        self.main_stack_used = main_stack_used
+        self.user_stacks = user_stacks
+        self.margin = margin
+
+    # Return size, sufficient for 'used' bytes with margin, but not above 'size'.
+    def tighten(self, size, used):
+        needed = int(math.ceil(used * self.margin))
+        needed = (needed + 15) & ~15
+        return min(size, needed)
+
+    def tighten_kernel_stack(self, size):
+        return max(min(size, KERNEL_STACK_SIZE_MIN),
+            self.tighten(size, self.kernel_stack_used))
+
 def _get_port_direction(port):
     direction = port.direction.lower()
     if direction in ("source", "out"):
@@ -435,7 +610,8 @@ class Port:
         "is_direction_src",
         "max_message_size",
         "protocol",
-        "channel_id" # id of corresponded channel. Set internally.
+        "channel_id", # id of corresponded channel. Set internally.
+        "receiver_id", # for destination port, index of the receiver in the channel. Set internally.
     ]
 
     @abc.abstractmethod
@@ -454,6 +630,7 @@ class Port:
 
         self.max_message_size = max_message_size
         self.channel_id = None
+        self.receiver_id = 0
         self.partition = None
 
     def is_src(self):
@@ -509,37 +686,43 @@ class QueueingPort(Port):
             if not hasattr(self, attr):
                 raise ValueError("%r is not set for %r" % (attr, self))
 
-# Generic channel connecting two connections.
+# Generic channel connecting source connection with one or more
+# destination connections.
 #
 # - max_message_size - maximum size of the message passed to the channel.
+# - dsts - list of destination connections. Message sent into the
+#   channel is stored once and delivered to every destination.
 
 class Channel:
     __metaclass__ = abc.ABCMeta
-    __slots__ = ["src", "dst"]
+    __slots__ = ["src", "dsts"]
 
-    def __init__(self, src, dst, max_message_size):
+    def __init__(self, src, dsts, max_message_size):
         self.max_message_size = max_message_size
 
         self.src = src
-        self.dst = dst
+        self.dsts = dsts
 
     def validate(self):
         if not isinstance(self.src, Connection):
             raise TypeError
-        if not isinstance(self.dst, Connection):
-            raise TypeError
+        if not self.dsts:
+            raise ValueError("channel should have at least one destination")
+        for dst in self.dsts:
+            if not isinstance(dst, Connection):
+                raise TypeError
 
         if self.get_local_connection() == None:
             raise ValueError("at least one connection per channel must be local")
 
         self.src.validate()
-        self.dst.validate()
+        for dst in self.dsts:
+            dst.validate()
 
     def get_local_connection(self):
-        if isinstance(self.src, LocalConnection):
-            return self.src
-        if isinstance(self.dst, LocalConnection):
-            return self.dst
+        for connection in [self.src] + self.dsts:
+            if isinstance(connection, LocalConnection):
+                return connection
         return None
 
     @abc.abstractmethod
@@ -547,22 +730,41 @@ class Channel:
         pass
 
     def requires_network(self):
-        return any(isinstance(x, UDPConnection) for x in [self.src, self.dst])
+        return any(isinstance(x, UDPConnection) for x in [self.src] + self.dsts)
 
+# Queueing channel.
+#
+# - storage - how messages are stored in the kernel:
+#   - "slots" - every message occupies slot of 'max_message_size' bytes.
+#   - "packed" - messages are packed into the ring of 'max_nb_bytes'
+#     bytes, every message occupies only its actual size.
 class ChannelQueueing(Channel):
-    def __init__(self, src, dst, max_message_size, max_nb_message_send, max_nb_message_receive):
-        Channel.__init__(self, src, dst, max_message_size)
+    STORAGES = ["slots", "packed"]
+
+    def __init__(self, src, dsts, max_message_size, max_nb_message_send,
+        storage = "slots", max_nb_bytes = None):
+        Channel.__init__(self, src, dsts, max_message_size)
 
         self.max_nb_message_send = max_nb_message_send
-        self.max_nb_message_receive = max_nb_message_receive
+
+        if storage not in ChannelQueueing.STORAGES:
+            raise ValueError("%r is not valid storage for queueing channel" % storage)
+        if storage == "packed" and max_nb_bytes is None:
+            raise ValueError("Packed storage requires maximum number of bytes")
+
+        self.storage = storage
+        self.max_nb_bytes = max_nb_bytes
+
+    def get_storage_constant(self):
+        return "JET_CHANNEL_QUEUING_STORAGE_" + self.storage.upper()
 
     def get_kind_constant(self):
         return "queueing"
 
 
 class ChannelSampling(Channel):
-    def __init__(self, src, dst, max_message_size):
-        Channel.__init__(self, src, dst, max_message_size)
+    def __init__(self, src, dsts, max_message_size):
+        Channel.__init__(self, src, dsts, max_message_size)
 
     def get_kind_constant(self):
         return "sampling"
@@ -706,6 +908,9 @@ class Configuration:
         # it's used by test runner as a sign that POK
         # can be terminated
         "test_support_print_when_all_threads_stopped",
+
+        "profiler_period", # timer ticks between profiler samples, 0 disables profiler
+        "profiler_histogram_size", # number of entries in the profiler histogram of every partition
     ]
 
     def __init__(self, arch):
@@ -725,6 +930,9 @@ class Configuration:
 
         self.test_support_print_when_all_threads_stopped = False
 
+        self.profiler_period = 0
+        self.profiler_histogram_size = 0
+
         self.major_frame = 0
 
         # For internal usage
@@ -764,13 +972,36 @@ class Configuration:
 
         return part
 
-    def add_channel(self, src_connection, dst_connection):
+    # Add channel from 'src_connection' to 'dst_connections'.
+    #
+    # 'dst_connections' may be either single connection or list of them.
+    # In the latter case multicast channel is created.
+    #
+    # 'storage' and 'max_nb_bytes' are used only for queueing channel,
+    # see ChannelQueueing.
+    def add_channel(self, src_connection, dst_connections,
+        storage = "slots", max_nb_bytes = None):
         channel_type = None
         channel_max_message_size = None
-        max_nb_message_receive = 1 # Only for queueing channel
         max_nb_message_send = 1 # Only for queueing channel
 
-        for connection in [src_connection, dst_connection]:
+        if not isinstance(dst_connections, list):
+            dst_connections = [dst_connections]
+
+        if len(dst_connections) == 0:
+            raise RuntimeError("Channel should have at least one destination")
+        if len(dst_connections) > 255:
+            raise RuntimeError("Too many destinations for the channel")
+
+        # Receiver id of the port is its position in 'dst_connections',
+        # so every destination port may be used only once.
+        dst_ports = [connection.port for connection in dst_connections
+            if isinstance(connection, LocalConnection)]
+        for i, port in enumerate(dst_ports):
+            if any(port is other for other in dst_ports[:i]):
+                raise RuntimeError("Port '%s' is used as dst connection of the channel more than once" % port.name)
+
+        for receiver_id, connection in enumerate([src_connection] + dst_connections, -1):
             if connection is not None:
                 if not isinstance(connection, LocalConnection):
                     raise RuntimeError("Non-local connections are not supported now")
@@ -778,7 +1009,7 @@ class Configuration:
                     if channel_type is not None:
                         if channel_type != "sampling":
                             raise RuntimeError("Channel for ports of different types: %s and %s" %
-                                (src_connection.port.name, dst_connection.port.name))
+                                (src_connection.port.name, connection.port.name))
                     else:
                         channel_type = "sampling"
                     connection.port.setChannel(self.next_channel_id_sampling)
@@ -786,24 +1017,25 @@ class Configuration:
                     if channel_type is not None:
                         if channel_type != "queueing":
                             raise RuntimeError("Channel for ports of different types: %s and %s" %
-                                (src_connection.port.name, dst_connection.port.name))
+                                (src_connection.port.name, connection.port.name))
                     else:
                         channel_type = "queueing"
                     connection.port.setChannel(self.next_channel_id_queueing)
 
-                    if connection == src_connection:
-                        if not connection.port.is_src():
-                            raise RuntimeError("Using dst port '%s' as src connection for the channel" % connection.port.name)
+                if connection == src_connection:
+                    if not connection.port.is_src():
+                        raise RuntimeError("Using dst port '%s' as src connection for the channel" % connection.port.name)
+                    if channel_type == "queueing":
                         max_nb_message_send = connection.port.max_nb_message
-                    else:
-                        if not connection.port.is_dst():
-                            raise RuntimeError("Using dst port '%s' as src connection for the channel" % connection.port.name)
-                        max_nb_message_receive = connection.port.max_nb_message
+                else:
+                    if not connection.port.is_dst():
+                        raise RuntimeError("Using src port '%s' as dst connection for the channel" % connection.port.name)
+                    connection.port.receiver_id = receiver_id
 
                 if channel_max_message_size is not None:
                     if channel_max_message_size > connection.port.max_message_size:
                         raise RuntimeError("Max message size of dst port '%s' is less than one for src port '%s'" %
-                            (src_connection.port.name, dst_connection.port.name))
+                            (connection.port.name, src_connection.port.name))
                 else:
                     channel_max_message_size = connection.port.max_message_size
 
@@ -811,12 +1043,12 @@ class Configuration:
             raise RuntimeError("At least one connection for channel should be local")
 
         if channel_type == 'sampling':
-            channel = ChannelSampling(src_connection, dst_connection, channel_max_message_size)
+            channel = ChannelSampling(src_connection, dst_connections, channel_max_message_size)
             self.channels_sampling.append(channel)
             self.next_channel_id_sampling += 1
         else:
-            channel = ChannelQueueing(src_connection, dst_connection, channel_max_message_size,
-                max_nb_message_send, max_nb_message_receive)
+            channel = ChannelQueueing(src_connection, dst_connections, channel_max_message_size,
+                max_nb_message_send, storage, max_nb_bytes)
             self.channels_queueing.append(channel)
             self.next_channel_id_queueing += 1
 
@@ -886,5 +1118,54 @@ class Configuration:
             if not partition.has_periodic_processing_start:
                 raise ValueError("partitions '%s' don't have periodic processing points set" % partition.name)
 
+        self.check_response_times()
+
+    # Return list of (begin, end) windows of the partition inside major frame.
+    def get_partition_windows(self, part):
+        windows = []
+        begin = 0
+
+        for slot in self.slots:
+            end = begin + slot.duration
+            if isinstance(slot, TimeSlotPartition) and slot.partition is part:
+                if windows and windows[-1][1] == begin:
+                    windows[-1] = (windows[-1][0], end)
+                else:
+                    windows.append((begin, end))
+            begin = end
+
+        return windows
+
+    # Print worst-case response times of annotated processes.
+    #
+    # Raise ValueError if some process misses its deadline or processes
+    # of some partition need more time than its windows provide.
+    def check_response_times(self):
+        missed = []
+        overloaded = []
+
+        for part in self.partitions:
+            if not part.processes:
+                continue
+
+            windows = self.get_partition_windows(part)
+            if not windows:
+                raise ValueError("Partition '%s' has processes with timing, but no time slots" % part.name)
+
+            results = response_time.analyze(windows, self.major_frame, part.processes)
+            print(response_time.format_report(part.name, windows, self.major_frame, results))
+
+            missed += ["'%s' of partition '%s'" % (r.process.name, part.name)
+                for r in results if not r.is_schedulable()]
+
+            if response_time.is_overloaded(windows, self.major_frame, part.processes):
+                overloaded.append("'%s'" % part.name)
+
+        if overloaded:
+            raise ValueError("Utilization exceeds the share of time slots for partitions: %s" % ", ".join(overloaded))
+
+        if missed:
+            raise ValueError("Deadline can't be met for processes: %s" % ", ".join(missed))
+
     def get_all_channels(self):
         return self.channels
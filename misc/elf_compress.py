@@ -0,0 +1,196 @@
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+
+"""
+Compression of partition's ELF for the boot archive.
+
+Content of every loadable segment is compressed with LZ4 block format.
+Resulted "packed ELF" keeps original ELF header and program headers,
+but 'p_offset' of every segment points to the compressed data.
+Section headers are dropped.
+
+Kernel decompresses segments directly into partition's space
+(see kernel/core/lz4.c).
+"""
+
+from __future__ import print_function
+
+import struct
+
+# Compression methods, as stored in 'pok_elf_compression[]'.
+COMPRESSION_NONE = 0
+COMPRESSION_LZ4 = 1
+
+LZ4_MIN_MATCH = 4
+# Last literals which cannot be part of the match.
+LZ4_LAST_LITERALS = 5
+# Match cannot start in the last bytes of the input.
+LZ4_MFLIMIT = 12
+LZ4_MAX_OFFSET = 65535
+LZ4_HASH_LOG = 16
+
+def _write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+def _write_sequence(out, literals, match_len, offset):
+    lit_len = len(literals)
+    token_lit = min(lit_len, 15)
+    if match_len is None:
+        token_match = 0
+    else:
+        token_match = min(match_len - LZ4_MIN_MATCH, 15)
+    out.append((token_lit << 4) | token_match)
+    if lit_len >= 15:
+        _write_length(out, lit_len - 15)
+    out.extend(literals)
+    if match_len is not None:
+        out.append(offset & 0xff)
+        out.append(offset >> 8)
+        if match_len - LZ4_MIN_MATCH >= 15:
+            _write_length(out, match_len - LZ4_MIN_MATCH - 15)
+
+def lz4_compress_block(data):
+    """ Compress data into LZ4 block (greedy, single hash table). """
+    data = bytearray(data)
+    n = len(data)
+    out = bytearray()
+
+    if n == 0:
+        return out
+
+    table = {}
+    anchor = 0
+    pos = 0
+    match_limit = n - LZ4_MFLIMIT
+
+    while pos < match_limit:
+        key = bytes(data[pos:pos + LZ4_MIN_MATCH])
+        candidate = table.get(key)
+        table[key] = pos
+
+        if candidate is None or pos - candidate > LZ4_MAX_OFFSET:
+            pos += 1
+            continue
+
+        # Extend the match forward, keeping last literals.
+        match_end_limit = n - LZ4_LAST_LITERALS
+        length = LZ4_MIN_MATCH
+        while pos + length < match_end_limit \
+                and data[candidate + length] == data[pos + length]:
+            length += 1
+
+        _write_sequence(out, data[anchor:pos], length, pos - candidate)
+
+        pos += length
+        anchor = pos
+
+    _write_sequence(out, data[anchor:], None, 0)
+
+    return out
+
+def lz4_decompress_block(data, size):
+    """ Decompress LZ4 block. Used for self-check. """
+    data = bytearray(data)
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        token = data[i]
+        i += 1
+        lit_len = token >> 4
+        if lit_len == 15:
+            while True:
+                b = data[i]
+                i += 1
+                lit_len += b
+                if b != 255:
+                    break
+        out.extend(data[i:i + lit_len])
+        i += lit_len
+        if len(out) >= size:
+            break
+        offset = data[i] | (data[i + 1] << 8)
+        i += 2
+        match_len = (token & 0xf) + LZ4_MIN_MATCH
+        if (token & 0xf) == 15:
+            while True:
+                b = data[i]
+                i += 1
+                match_len += b
+                if b != 255:
+                    break
+        start = len(out) - offset
+        for k in range(match_len):
+            out.append(out[start + k])
+    return out
+
+_EHDR_FORMAT = "16sHHIIIIIHHHHHH"
+_PHDR_FORMAT = "IIIIIIII"
+
+def pack_elf(elf):
+    """ Return packed ELF for given ELF file content. """
+    elf = bytearray(elf)
+
+    if elf[0:4] != bytearray(b"\x7fELF"):
+        raise RuntimeError("Partition's file is not an ELF")
+
+    # EI_DATA: 1 - little endian, 2 - big endian.
+    endian = "<" if elf[5] == 1 else ">"
+
+    ehdr_format = endian + _EHDR_FORMAT
+    phdr_format = endian + _PHDR_FORMAT
+
+    ehdr = list(struct.unpack_from(ehdr_format, bytes(elf), 0))
+    phoff = ehdr[5]
+    phentsize = ehdr[9]
+    phnum = ehdr[10]
+
+    phdrs = [list(struct.unpack_from(phdr_format, bytes(elf), phoff + i * phentsize))
+        for i in range(phnum)]
+
+    # No section headers in the packed ELF.
+    ehdr[6] = 0 # e_shoff
+    ehdr[12] = 0 # e_shnum
+    ehdr[13] = 0 # e_shstrndx
+
+    headers_end = phoff + phnum * phentsize
+    packed = bytearray(elf[0:headers_end])
+
+    for phdr in phdrs:
+        offset, filesz = phdr[1], phdr[4]
+        content = elf[offset:offset + filesz]
+
+        compressed = lz4_compress_block(content)
+        if lz4_decompress_block(compressed, filesz) != content:
+            raise RuntimeError("LZ4 self-check failed")
+
+        while len(packed) % 4:
+            packed.append(0)
+
+        phdr[1] = len(packed) # p_offset
+        packed.extend(compressed)
+
+    struct.pack_into(ehdr_format, packed, 0, *ehdr)
+    for i in range(phnum):
+        struct.pack_into(phdr_format, packed, phoff + i * phentsize, *phdrs[i])
+
+    return packed
@@ -0,0 +1,286 @@
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+"""
+Memory footprint of partitions.
+
+Input is a console log containing output of 'memory' monitor command
+(see pok_partitions_arinc_dump_memory() in kernel/core/partition_arinc.c).
+The command should be issued after partitions have run for a while,
+so stacks reach their high-water marks. Stacks are measured only if
+the system is built with stack painting:
+
+    scons stack_usage=1
+
+Usage:
+
+    footprint.py [options] console.log
+
+Options:
+
+    --profile <file>        Save measured usage into <file> (JSON).
+    --margin <factor>       Factor applied to the measured values when
+                            sizes are tightened (default 1.25).
+
+Report of configured and used memory is written to stdout: heap (which
+includes intra-partition objects), ARINC messages memory of buffers and
+blackboards, user and kernel stacks of every thread.
+
+Recorded profile is applied to the build with 'footprint' option:
+
+    scons footprint=footprint.json
+
+Then the heap, messages memory, main thread's user stack, the kernel
+stacks are cut down to the measured usage multiplied by the margin, but
+never above the configured sizes. Stack sizes of processes are set by
+the application (STACK_SIZE in CREATE_PROCESS), so they are only
+reported. On x86, the area of user stacks is sized for the stacks of
+processes created in the profile; the error handler and processes not
+created in the profile keep the default stack size.
+"""
+
+from __future__ import print_function
+
+import json
+import re
+import sys
+from optparse import OptionParser
+
+import chpok_configuration
+
+MEMORY_RE = re.compile(r"\[MEMORY\] (\w+) (.*)$")
+
+DEFAULT_MARGIN = 1.25
+
+
+class ThreadUsage(object):
+    def __init__(self, index, name, user_stack_size, user_stack_used,
+        kernel_stack_size, kernel_stack_used):
+        self.index = index
+        self.name = name
+        self.user_stack_size = user_stack_size
+        self.user_stack_used = user_stack_used
+        self.kernel_stack_size = kernel_stack_size
+        self.kernel_stack_used = kernel_stack_used
+
+
+class PartitionUsage(object):
+    def __init__(self, name, heap_size, heap_used, intra_size, intra_used):
+        self.name = name
+        self.heap_size = heap_size
+        self.heap_used = heap_used
+        self.intra_size = intra_size
+        self.intra_used = intra_used
+        self.threads = []
+
+    def get_main_thread(self):
+        for thread in self.threads:
+            if thread.index == 0:
+                return thread
+        return None
+
+    def get_kernel_stack_used(self):
+        return max([t.kernel_stack_used for t in self.threads] or [0])
+
+    def get_footprint(self, margin):
+        main_thread = self.get_main_thread()
+
+        return chpok_configuration.MemoryFootprint(
+            heap_used = self.heap_used,
+            intra_size = self.intra_size,
+            intra_used = self.intra_used,
+            kernel_stack_used = self.get_kernel_stack_used(),
+            main_stack_used = main_thread.user_stack_used if main_thread else 0,
+            user_stacks = [t.user_stack_size for t in self.threads if t.index != 0],
+            margin = margin)
+
+
+def parse_log(f):
+    """Return list of PartitionUsage from the last dump in the log."""
+    partitions = []
+    by_index = dict()
+
+    for line in f:
+        m = MEMORY_RE.search(line)
+        if not m:
+            continue
+
+        kind = m.group(1)
+        fields = m.group(2).split()
+
+        if kind == "partition":
+            # <index> <name> heap <size> <used> intra <size> <used>
+            index = int(fields[0])
+            if index in by_index:
+                # Start of the new dump.
+                partitions = []
+                by_index = dict()
+            part = PartitionUsage(fields[1],
+                int(fields[3]), int(fields[4]), int(fields[6]), int(fields[7]))
+            partitions.append(part)
+            by_index[index] = part
+        elif kind == "thread":
+            # <part index> <index> <name> user_stack <size> <used> kernel_stack <size> <used>
+            part = by_index.get(int(fields[0]))
+            if part is None:
+                continue
+            if fields[5] == "-" or fields[8] == "-":
+                raise ValueError("Stack usage is not recorded in the log; build with 'scons stack_usage=1'")
+            part.threads.append(ThreadUsage(int(fields[1]), fields[2],
+                int(fields[4]), int(fields[5]), int(fields[7]), int(fields[8])))
+
+    return partitions
+
+
+def save_profile(partitions, margin, path):
+    profile = {
+        "margin": margin,
+        "partitions": dict(),
+    }
+
+    for part in partitions:
+        footprint = part.get_footprint(margin)
+        profile["partitions"][part.name] = dict(
+            (attr, getattr(footprint, attr))
+            for attr in chpok_configuration.MemoryFootprint.__slots__
+            if attr != "margin")
+
+    with open(path, "w") as f:
+        json.dump(profile, f, indent = 4, sort_keys = True)
+        f.write("\n")
+
+
+def apply_profile(conf, path):
+    """
+    Set footprint of partitions in configuration 'conf' from the profile.
+
+    Partitions are matched by name; partitions absent in the profile
+    keep their configured sizes.
+    """
+    with open(path) as f:
+        profile = json.load(f)
+
+    margin = profile["margin"]
+
+    for part in conf.partitions:
+        values = profile["partitions"].get(part.name)
+        if values is None:
+            continue
+
+        part.footprint = chpok_configuration.MemoryFootprint(margin = margin, **values)
+
+
+def _percent(used, size):
+    if size == 0:
+        return "-"
+    return "%d%%" % (used * 100 // size)
+
+
+def print_report(partitions, margin):
+    total_configured = 0
+    total_suggested = 0
+
+    for part in partitions:
+        footprint = part.get_footprint(margin)
+        main_thread = part.get_main_thread()
+
+        intra_suggested = footprint.tighten(part.intra_size, part.intra_used)
+        heap_suggested = footprint.tighten(part.heap_size,
+            part.heap_used - part.intra_size + intra_suggested)
+
+        kernel_stack_size = max([t.kernel_stack_size for t in part.threads] or [0])
+        kernel_stack_suggested = footprint.tighten_kernel_stack(kernel_stack_size)
+
+        print("Partition %s" % part.name)
+        print("  %-22s %10s %10s %6s %10s" % ("", "size", "used", "", "suggested"))
+        print("  %-22s %10d %10d %6s %10d" % ("heap", part.heap_size,
+            part.heap_used, _percent(part.heap_used, part.heap_size),
+            heap_suggested))
+        print("  %-22s %10d %10d %6s %10d" % ("messages memory", part.intra_size,
+            part.intra_used, _percent(part.intra_used, part.intra_size),
+            intra_suggested))
+
+        configured = part.heap_size
+        suggested = heap_suggested
+
+        for thread in part.threads:
+            if thread is main_thread:
+                user_suggested = footprint.tighten(thread.user_stack_size,
+                    thread.user_stack_used)
+            else:
+                # Set by the application.
+                user_suggested = thread.user_stack_size
+
+            print("  %-22s %10d %10d %6s %10d" % ("user stack: " + thread.name,
+                thread.user_stack_size, thread.user_stack_used,
+                _percent(thread.user_stack_used, thread.user_stack_size),
+                user_suggested))
+            print("  %-22s %10d %10d %6s %10d" % ("kernel stack: " + thread.name,
+                thread.kernel_stack_size, thread.kernel_stack_used,
+                _percent(thread.kernel_stack_used, thread.kernel_stack_size),
+                kernel_stack_suggested))
+
+            configured += thread.user_stack_size + thread.kernel_stack_size
+            suggested += user_suggested + kernel_stack_suggested
+
+        print("  %-22s %10d %10s %6s %10d" % ("total", configured, "", "",
+            suggested))
+        print()
+
+        total_configured += configured
+        total_suggested += suggested
+
+    print("Total: configured %d bytes, suggested %d bytes (margin %g)" % (
+        total_configured, total_suggested, margin))
+
+
+def main():
+    parser = OptionParser(usage = "%prog [options] console.log")
+    parser.add_option("--profile", default = None)
+    parser.add_option("--margin", type = "float", default = DEFAULT_MARGIN)
+
+    (options, args) = parser.parse_args()
+
+    if len(args) != 1:
+        parser.error("Exactly one log file is expected")
+
+    if options.margin < 1:
+        parser.error("Margin should be at least 1")
+
+    with open(args[0]) as f:
+        try:
+            partitions = parse_log(f)
+        except ValueError as e:
+            print(e, file = sys.stderr)
+            return 1
+
+    if not partitions:
+        print("No output of 'memory' monitor command in the log", file = sys.stderr)
+        return 1
+
+    print_report(partitions, options.margin)
+
+    if options.profile:
+        save_profile(partitions, options.margin, options.profile)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
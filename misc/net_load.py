@@ -0,0 +1,333 @@
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+
+
+
+"""
+Headless load generator for examples/syspart-net-demo.
+
+Sends UDP packets to the echo service of the demo's partition P1 and
+measures round-trip time, one-way delay variation, loss and reordering.
+
+Every packet starts with the header (network byte order):
+
+    mode      1 byte   0 - echo request
+    reserved  1 byte
+    flow      2 bytes  index of the flow
+    seq       4 bytes  sequence number within the flow
+    sent      8 bytes  host send time, ns
+    target    8 bytes  JetOS time of the echo, ns (filled by the target)
+
+The rest of the packet is padding. Clocks of the host and the target
+are not synchronized, so one-way delays are reported relative to the
+minimum observed one ("excess" delay).
+
+Usage:
+
+    net_load.py [options]
+
+Options:
+
+    --target IP:PORT        Address of the echo service (192.168.56.101:10001).
+    --bind IP:PORT          Local address, to which replies are sent
+                            (192.168.56.1:10003).
+    --rate LIST             Comma-separated packet rates (packets per
+                            second) to step through (default 100).
+    --size LIST             Comma-separated UDP payload sizes; packets
+                            cycle through them (default 64).
+    --flows N               Number of flows (default 1).
+    --duration SEC          Duration of every rate step (default 5).
+    --drain SEC             Time to wait for late replies (default 1).
+    --output FILE           Write JSON into FILE instead of stdout.
+
+For measuring packets-per-second ceiling, step through increasing rates
+and look for the point where 'rx_pps' stops following 'tx_pps'.
+"""
+
+import json
+import socket
+import struct
+import sys
+import threading
+import time
+from optparse import OptionParser
+
+HEADER_FORMAT = "!BBHIQQ"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+
+MODE_ECHO = 0
+
+MAX_PAYLOAD = 1472
+
+PERCENTILES = [50, 90, 99, 99.9]
+
+if hasattr(time, "perf_counter"):
+    clock = time.perf_counter
+else:
+    clock = time.time
+
+
+def now_ns():
+    return int(clock() * 1e9)
+
+
+def parse_address(s):
+    host, port = s.rsplit(":", 1)
+    return (host, int(port))
+
+
+def parse_list(s, conv):
+    return [conv(x) for x in s.split(",") if x]
+
+
+class FlowState(object):
+    def __init__(self):
+        self.next_seq = 0
+        self.max_seq_received = -1
+        self.received = set()
+        self.reordered = 0
+        self.duplicates = 0
+
+
+class Receiver(threading.Thread):
+    """Collects replies until stopped."""
+
+    def __init__(self, sock, flows):
+        threading.Thread.__init__(self)
+        self.daemon = True
+        self.sock = sock
+        self.flows = flows
+        self.stop_flag = False
+        self.lock = threading.Lock()
+        self.reset()
+
+    def reset(self):
+        with self.lock:
+            self.rtt = []
+            self.owd_fwd = []
+            self.owd_rev = []
+            self.nb_received = 0
+            self.nb_bytes = 0
+            self.nb_foreign = 0
+            self.first_time = None
+            self.last_time = None
+
+    def run(self):
+        while not self.stop_flag:
+            try:
+                data = self.sock.recv(65536)
+            except socket.timeout:
+                continue
+            recv_time = now_ns()
+            self.process(data, recv_time)
+
+    def process(self, data, recv_time):
+        with self.lock:
+            if len(data) < HEADER_SIZE:
+                self.nb_foreign += 1
+                return
+
+            mode, _, flow, seq, sent, target = struct.unpack(HEADER_FORMAT,
+                bytes(data[:HEADER_SIZE]))
+            if mode != MODE_ECHO or flow >= len(self.flows):
+                self.nb_foreign += 1
+                return
+
+            state = self.flows[flow]
+            if seq in state.received:
+                state.duplicates += 1
+                return
+            state.received.add(seq)
+            if seq < state.max_seq_received:
+                state.reordered += 1
+            else:
+                state.max_seq_received = seq
+
+            self.nb_received += 1
+            self.nb_bytes += len(data)
+            if self.first_time is None:
+                self.first_time = recv_time
+            self.last_time = recv_time
+
+            self.rtt.append(recv_time - sent)
+            # Contain unknown clocks offset, which is eliminated later.
+            self.owd_fwd.append(target - sent)
+            self.owd_rev.append(recv_time - target)
+
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return None
+    index = int(round(p / 100.0 * (len(sorted_values) - 1)))
+    return sorted_values[index]
+
+
+def summary(values, relative = False):
+    """Return statistics (in microseconds) for list of ns values."""
+    if not values:
+        return None
+    values = sorted(values)
+    base = values[0] if relative else 0
+    us = lambda v: round((v - base) / 1000.0, 3)
+
+    res = {
+        "min": us(values[0]),
+        "mean": us(sum(values) / float(len(values))),
+        "max": us(values[-1]),
+    }
+    for p in PERCENTILES:
+        res["p%s" % p] = us(percentile(values, p))
+    return res
+
+
+def run_step(sock, receiver, flows, target, rate, sizes, duration, drain):
+    receiver.reset()
+    with receiver.lock:
+        for state in flows:
+            state.__init__()
+
+    padding = [b"\0" * (size - HEADER_SIZE) for size in sizes]
+    interval = 1.0 / rate
+    nb_sent = 0
+    nb_send_errors = 0
+
+    start = clock()
+    end = start + duration
+    next_time = start
+
+    while True:
+        current = clock()
+        if current >= end:
+            break
+        if current < next_time:
+            time.sleep(min(next_time - current, 0.001))
+            continue
+
+        flow = nb_sent % len(flows)
+        state = flows[flow]
+        header = struct.pack(HEADER_FORMAT, MODE_ECHO, 0, flow,
+            state.next_seq, now_ns(), 0)
+        try:
+            sock.sendto(header + padding[nb_sent % len(sizes)], target)
+        except socket.error:
+            nb_send_errors += 1
+        state.next_seq += 1
+        nb_sent += 1
+        next_time += interval
+
+    send_time = clock() - start
+    time.sleep(drain)
+
+    with receiver.lock:
+        nb_received = receiver.nb_received
+        rx_time = 0
+        if nb_received > 1:
+            rx_time = (receiver.last_time - receiver.first_time) / 1e9
+
+        res = {
+            "rate": rate,
+            "sizes": sizes,
+            "flows": len(flows),
+            "sent": nb_sent,
+            "send_errors": nb_send_errors,
+            "received": nb_received,
+            "lost": nb_sent - nb_received,
+            "loss_ratio": round(float(nb_sent - nb_received) / nb_sent, 6) if nb_sent else 0,
+            "reordered": sum(state.reordered for state in flows),
+            "duplicates": sum(state.duplicates for state in flows),
+            "foreign": receiver.nb_foreign,
+            "tx_pps": round(nb_sent / send_time, 1) if send_time else 0,
+            "rx_pps": round((nb_received - 1) / rx_time, 1) if rx_time else 0,
+            "rx_bytes": receiver.nb_bytes,
+            "rtt_us": summary(receiver.rtt),
+            "owd_fwd_excess_us": summary(receiver.owd_fwd, relative = True),
+            "owd_rev_excess_us": summary(receiver.owd_rev, relative = True),
+        }
+
+    return res
+
+
+def main():
+    parser = OptionParser(usage = "%prog [options]")
+    parser.add_option("--target", default = "192.168.56.101:10001")
+    parser.add_option("--bind", default = "192.168.56.1:10003")
+    parser.add_option("--rate", default = "100")
+    parser.add_option("--size", default = "64")
+    parser.add_option("--flows", type = "int", default = 1)
+    parser.add_option("--duration", type = "float", default = 5)
+    parser.add_option("--drain", type = "float", default = 1)
+    parser.add_option("--output")
+
+    (options, args) = parser.parse_args()
+
+    if args:
+        parser.error("No positional arguments are expected")
+
+    rates = parse_list(options.rate, float)
+    sizes = parse_list(options.size, int)
+
+    if not rates or min(rates) <= 0:
+        parser.error("Rates should be positive")
+    if not sizes or min(sizes) < HEADER_SIZE or max(sizes) > MAX_PAYLOAD:
+        parser.error("Sizes should be in range [%d, %d]" % (HEADER_SIZE, MAX_PAYLOAD))
+    if options.flows < 1 or options.flows > 65535:
+        parser.error("Number of flows should be in range [1, 65535]")
+
+    target = parse_address(options.target)
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(parse_address(options.bind))
+    sock.settimeout(0.1)
+
+    flows = [FlowState() for i in range(options.flows)]
+
+    receiver = Receiver(sock, flows)
+    receiver.start()
+
+    steps = []
+    try:
+        for rate in rates:
+            step = run_step(sock, receiver, flows, target, rate, sizes,
+                options.duration, options.drain)
+            sys.stderr.write("rate %.0f: sent %d, received %d, rx_pps %.1f\n"
+                % (rate, step["sent"], step["received"], step["rx_pps"]))
+            steps.append(step)
+    finally:
+        receiver.stop_flag = True
+        receiver.join()
+        sock.close()
+
+    result = {
+        "target": options.target,
+        "duration": options.duration,
+        "steps": steps,
+    }
+
+    if options.output:
+        with open(options.output, "w") as f:
+            json.dump(result, f, indent = 4, sort_keys = True)
+            f.write("\n")
+    else:
+        json.dump(result, sys.stdout, indent = 4, sort_keys = True)
+        sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()
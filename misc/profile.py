@@ -0,0 +1,190 @@
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+
+"""
+Process samples of the kernel PC-sampling profiler.
+
+Input is a console log containing output of 'profile' monitor command
+(see kernel/core/profiler.c). Samples are symbolized against the
+kernel image (for samples in kernel mode) and partition's ELF (for
+samples in user mode) with 'nm' from the toolchain.
+
+Usage:
+
+    profile.py [options] console.log
+
+Options:
+
+    --kernel <file>         Kernel image (e.g., build/<bsp>/kernel/kernel.lo).
+    --partition <name>=<file>
+                            ELF of the partition with given name. May be
+                            repeated for every partition.
+    --nm <command>          'nm' command. Default is '$PREFIX''nm' or 'nm'.
+    --hierarchy <file>      Write samples grouped by partition, thread, mode
+                            and function to <file>, one line per group:
+                            "<partition>;<thread>;<mode>;<function> <count>".
+    --top <n>               Number of lines in the flat profile (default 30).
+
+Flat profile is written to stdout.
+
+The profiler records only the interrupted PC, not the call stack, so
+time is attributed to the function which has been executing, not to
+its callers.
+"""
+
+import bisect
+import os
+import re
+import subprocess
+import sys
+from optparse import OptionParser
+
+PROFILE_RE = re.compile(r"\[PROFILE\] (\w+) (.*)$")
+
+
+class Symbols:
+    """Map of addresses to function names for one ELF file."""
+
+    def __init__(self, nm, elf_file):
+        self.addrs = []
+        self.names = []
+
+        if elf_file is None:
+            return
+
+        output = subprocess.check_output([nm, "-n", "--defined-only", elf_file])
+        for line in output.decode("ascii", "replace").splitlines():
+            fields = line.split()
+            if len(fields) != 3 or fields[1] not in "tTwW":
+                continue
+            self.addrs.append(int(fields[0], 16))
+            self.names.append(fields[2])
+
+    def lookup(self, pc):
+        i = bisect.bisect_right(self.addrs, pc) - 1
+        if i < 0:
+            return "0x%x" % pc
+        return self.names[i]
+
+
+class Histogram:
+    def __init__(self, name):
+        self.name = name
+        self.samples = 0
+        self.dropped = 0
+        # List of (thread_index, is_kernel, pc, count).
+        self.entries = []
+
+
+def parse_log(stream):
+    """Return (period, frequency, histograms) for the last dump in the log."""
+    period = None
+    frequency = None
+    histograms = dict()
+
+    for line in stream:
+        m = PROFILE_RE.search(line)
+        if m is None:
+            continue
+        kind, fields = m.group(1), m.group(2).split()
+
+        if kind == "period":
+            # New dump starts, forget previous one.
+            period = int(fields[0])
+            frequency = int(fields[2])
+            histograms = dict()
+        elif kind == "histogram":
+            histogram = Histogram(fields[1])
+            histogram.samples = int(fields[3])
+            histogram.dropped = int(fields[5])
+            histograms[int(fields[0])] = histogram
+        elif kind == "sample":
+            histograms[int(fields[0])].entries.append((int(fields[1]),
+                fields[2] == "kernel", int(fields[3], 16), int(fields[4])))
+
+    return period, frequency, histograms
+
+
+def main():
+    parser = OptionParser(usage = "%prog [options] console.log")
+    parser.add_option("--kernel", dest = "kernel")
+    parser.add_option("--partition", dest = "partitions", action = "append", default = [])
+    parser.add_option("--nm", dest = "nm", default = os.environ.get("PREFIX", "") + "nm")
+    parser.add_option("--hierarchy", dest = "hierarchy")
+    parser.add_option("--top", dest = "top", type = "int", default = 30)
+
+    (options, args) = parser.parse_args()
+    if len(args) != 1:
+        parser.error("console log is required")
+
+    with open(args[0]) as f:
+        period, frequency, histograms = parse_log(f)
+
+    if period is None:
+        sys.exit("No profiler output found in %s" % args[0])
+
+    kernel_symbols = Symbols(options.nm, options.kernel)
+    partition_symbols = dict()
+    for p in options.partitions:
+        name, elf_file = p.split("=", 1)
+        partition_symbols[name] = Symbols(options.nm, elf_file)
+
+    # (partition, thread, mode, function) => count
+    counts = dict()
+    total = 0
+
+    for index in sorted(histograms):
+        histogram = histograms[index]
+        total += histogram.samples
+
+        if histogram.dropped:
+            sys.stderr.write("Warning: %d of %d samples are dropped for %s\n"
+                % (histogram.dropped, histogram.samples, histogram.name))
+
+        for thread_index, is_kernel, pc, count in histogram.entries:
+            if is_kernel:
+                symbols = kernel_symbols
+            else:
+                symbols = partition_symbols.get(histogram.name, Symbols(options.nm, None))
+
+            thread = "-" if thread_index == 0xffff else "thread %d" % thread_index
+            key = (histogram.name, thread, "kernel" if is_kernel else "user",
+                symbols.lookup(pc))
+            counts[key] = counts.get(key, 0) + count
+
+    sample_time = float(period) / frequency
+    print("Samples: %d (every %g ms), total time: %g s"
+        % (total, sample_time * 1000, total * sample_time))
+    print("")
+    print("%7s %8s  %-16s %-10s %-6s %s" % ("%", "samples", "partition", "thread", "mode", "function"))
+
+    flat = sorted(counts.items(), key = lambda item: item[1], reverse = True)
+    for (partition, thread, mode, function), count in flat[:options.top]:
+        print("%6.2f%% %8d  %-16s %-10s %-6s %s" % (100.0 * count / total, count,
+            partition, thread, mode, function))
+
+    if options.hierarchy:
+        with open(options.hierarchy, "w") as f:
+            for (partition, thread, mode, function), count in flat:
+                f.write("%s;%s;%s;%s %d\n" % (partition, thread, mode, function, count))
+
+
+if __name__ == "__main__":
+    main()
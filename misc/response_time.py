@@ -0,0 +1,225 @@
+#******************************************************************
+#
+# Institute for System Programming of the Russian Academy of Sciences
+# Copyright (C) 2016 ISPRAS
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation, Version 3.
+#
+# This program is distributed in the hope # that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#
+# See the GNU General Public License version 3 for more details.
+#
+#-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+
+"""
+Response-time analysis of ARINC processes inside partition windows.
+
+Processes of a partition are annotated in its config.xml:
+
+    <Processes>
+        <Process Name="control" Priority="20" Period="20ms" WCET="2ms" />
+        <Process Name="logger" Priority="5" Period="100ms" WCET="10ms"
+            Deadline="80ms" />
+    </Processes>
+
+Period is the period of a periodic process or the minimal interval
+between releases of a sporadic one. Deadline defaults to the period
+and shouldn't exceed it.
+Higher Priority value means higher priority, as in ARINC 653.
+
+Scheduling inside the partition is fixed-priority preemptive; processes
+with the same priority are assumed to interfere with each other. The
+partition gets the processor only in its windows of <Schedule>, which
+is repeated every major frame. Release of a process may happen at any
+moment, so the worst case is a release just at the end of a window.
+
+Worst-case response time R of a process with WCET C is the least
+fixed point of
+
+    R = S^-1(C + sum(ceil(R / T_j) * C_j))
+
+where the sum is over other processes with the same or higher priority,
+and S^-1(w) is the longest interval needed for the partition to receive
+w of processor time (inverse of the supply bound function).
+
+Overheads of the kernel (timer interrupts, context and partition
+switches) aren't counted and should be included into WCETs.
+
+The analysis is performed while the configuration is validated, so the
+build fails when a deadline can't be met or when total utilization of
+the processes exceeds the share of the partition's windows. It may also be run alone:
+
+    response_time.py config.xml
+"""
+
+from __future__ import print_function
+
+import sys
+from fractions import Fraction
+
+
+class ProcessResult(object):
+    def __init__(self, process, response_time):
+        self.process = process
+        # None if the deadline can't be met.
+        self.response_time = response_time
+
+    def is_schedulable(self):
+        return self.response_time is not None
+
+    def get_slack(self):
+        if self.response_time is None:
+            return None
+        return self.process.deadline - self.response_time
+
+
+def _ceil_div(a, b):
+    return -(-a // b)
+
+
+def _time_to_supply(windows, frame, start, amount):
+    """
+    Return time, needed for receiving 'amount' of processor time
+    starting at 'start'.
+
+    'windows' is a list of (begin, end) pairs inside the major frame
+    of length 'frame'.
+    """
+    if amount <= 0:
+        return 0
+
+    per_frame = sum(end - begin for begin, end in windows)
+
+    # Every whole frame gives exactly 'per_frame'.
+    skipped = (amount - 1) // per_frame
+    amount -= skipped * per_frame
+
+    frame_base = (start // frame) * frame
+    while True:
+        for begin, end in windows:
+            begin += frame_base
+            end += frame_base
+            if end <= start:
+                continue
+            begin = max(begin, start)
+            if end - begin >= amount:
+                return skipped * frame + begin + amount - start
+            amount -= end - begin
+        frame_base += frame
+
+
+def supply_inverse(windows, frame, amount):
+    """
+    Return the longest time, needed for receiving 'amount' of
+    processor time, among all moments of the request.
+
+    Supply is the worst for the requests made at the end of windows.
+    """
+    return max(_time_to_supply(windows, frame, end, amount)
+        for begin, end in windows)
+
+
+def is_overloaded(windows, frame, processes):
+    """
+    Return True if processes need more processor time in the long run
+    than the partition's windows provide.
+    """
+    supply = sum(end - begin for begin, end in windows)
+    demand = sum(Fraction(p.wcet, p.period) for p in processes)
+
+    return demand > Fraction(supply, frame)
+
+
+def analyze(windows, frame, processes):
+    """
+    Compute worst-case response time of every process.
+
+    Return list of ProcessResult, ordered by decreasing priority.
+    """
+    results = []
+    ordered = sorted(processes, key = lambda p: -p.priority)
+
+    for proc in ordered:
+        interfering = [p for p in ordered
+            if p is not proc and p.priority >= proc.priority]
+
+        response_time = supply_inverse(windows, frame,
+            proc.wcet + sum(p.wcet for p in interfering))
+
+        while response_time <= proc.deadline:
+            demand = proc.wcet + sum(_ceil_div(response_time, p.period) * p.wcet
+                for p in interfering)
+            next_time = supply_inverse(windows, frame, demand)
+            if next_time == response_time:
+                break
+            response_time = next_time
+
+        if response_time > proc.deadline:
+            response_time = None
+
+        results.append(ProcessResult(proc, response_time))
+
+    return results
+
+
+def _ms(value):
+    if value is None:
+        return "-"
+    return "%.3f" % (value / 1e6)
+
+
+def format_report(part_name, windows, frame, results):
+    supply = sum(end - begin for begin, end in windows)
+    supply_share = float(supply) / frame
+    demand = sum(float(r.process.wcet) / r.process.period for r in results)
+
+    lines = []
+    lines.append("Response times of partition '%s' (ms), windows %s of %s (%.1f%%):" %
+        (part_name, _ms(supply), _ms(frame), supply_share * 100))
+    lines.append("    %-20s %5s %9s %9s %9s %9s %9s %7s" % ("process",
+        "prio", "wcet", "period", "deadline", "response", "slack", "util"))
+
+    for r in results:
+        p = r.process
+        lines.append("    %-20s %5d %9s %9s %9s %9s %9s %6.1f%%" % (p.name,
+            p.priority, _ms(p.wcet), _ms(p.period), _ms(p.deadline),
+            _ms(r.response_time) if r.is_schedulable() else "MISS",
+            _ms(r.get_slack()),
+            float(p.wcet) / p.period * 100))
+
+    lines.append("    utilization: %.1f%% of the processor, %.1f%% of the partition's windows" %
+        (demand * 100, demand / supply_share * 100))
+
+    return "\n".join(lines)
+
+
+def main():
+    import arinc653_xml_conf
+    from lxml import etree
+
+    if len(sys.argv) != 2:
+        print("Usage: %s config.xml" % sys.argv[0], file = sys.stderr)
+        return 2
+
+    root = etree.parse(sys.argv[1])
+    root.xinclude()
+
+    # Report is printed by validation of the configuration.
+    try:
+        arinc653_xml_conf.ArincConfigParser("x86").parse(root)
+    except ValueError as e:
+        print(e, file = sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -273,11 +273,15 @@ class SyscallArg:
         self.name = arg_name
         self.is_pointer = is_pointer
 
+# Flags which may be specified for system call.
+SYSCALL_FLAGS = ["READONLY"]
+
 class SyscallDeclaration:
     """ Declaration of single system call """
-    def __init__(self, syscall_id, syscall_func):
+    def __init__(self, syscall_id, syscall_func, flags = []):
         self.syscall_id = syscall_id
         self.func = syscall_func
+        self.flags = flags
         self.args = []
 
 class ParseError(RuntimeError):
@@ -351,6 +355,7 @@ def syscall_build_action(target, source, env):
     syscall_end_re = re.compile("[)]")
     syscall_delim_re = re.compile("\s*,\s*")
     syscall_token_spaces = re.compile("\s+")
+    syscall_func_flags_re = re.compile("^(\S+)\s*\[([^\]]*)\]$")
 
     syscall_string = None
 
@@ -384,7 +389,18 @@ def syscall_build_action(target, source, env):
             pc.print_syscall_parse_error("Too few tokens for syscall")
             return 1
 
-        sd = SyscallDeclaration(tokens[0], tokens[1])
+        func = tokens[1]
+        flags = []
+        func_flags_match = syscall_func_flags_re.match(func)
+        if func_flags_match:
+            func = func_flags_match.group(1)
+            flags = [f.strip() for f in func_flags_match.group(2).split("|")]
+            for flag in flags:
+                if flag not in SYSCALL_FLAGS:
+                    pc.print_syscall_parse_error("Unknown syscall flag: " + flag)
+                    return 1
+
+        sd = SyscallDeclaration(tokens[0], func, flags)
 
         args_tokens = tokens[2:]
 
@@ -651,6 +667,8 @@ def BuildAsmOffsets(env, target, source, **kargs):
 
     # Add '-S' flag for skip compilation stage
     precompile_env.AppendUnique(CCFLAGS = '-S')
+    # Offsets are extracted from the assembler, which isn't generated for LTO.
+    precompile_env.AppendUnique(CCFLAGS = '-fno-lto')
     # Include directory with header defined DEFINE and other macros.
     precompile_env.Append(CPPPATH =
         os.path.join(precompile_env['POK_PATH'], "misc/asm_offsets")
@@ -28,7 +28,7 @@ struct ja_ppc_space ja_spaces[{{conf.spaces | length}}] =
 {%endfor%}
 };
 
-int ja_spaces_n = {{conf.spaces | length}};
+const int ja_spaces_n = {{conf.spaces | length}};
 
 /************************ Memory mapping ************************/
 
@@ -52,4 +52,4 @@ struct tlb_entry jet_tlb_entries[] = {
 
 };
 
-size_t jet_tlb_entries_n = {{ conf.memory_blocks_tlb_entries_count }};
+const size_t jet_tlb_entries_n = {{ conf.memory_blocks_tlb_entries_count }};
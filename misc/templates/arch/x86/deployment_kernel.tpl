@@ -22,10 +22,10 @@ struct ja_x86_space ja_spaces[{{conf.spaces | length}}] =
         //.phys_base is filled upon initialization
         .size_normal = {{space.size}},
         .size_heap = {{space.part.get_heap_size()}},
-        // Currently stack size is hardcoded to 8K.
-        .size_stack = {{space.part.get_needed_threads()}} * 8 * 1024
+        // Stack of every thread is 8K, unless tightened by the footprint profile.
+        .size_stack = {{space.part.get_user_stacks_size()}}
     },
 {%endfor%}
 };
 
-int ja_spaces_n = {{conf.spaces | length}};
+const int ja_spaces_n = {{conf.spaces | length}};
@@ -24,7 +24,7 @@
 /*
  * HM module selector.
  */
-pok_error_level_selector_t pok_hm_module_selector = {
+const pok_error_level_selector_t pok_hm_module_selector = {
     .levels = {
 {%for error_id in conf.error_ids_all%}
         {{conf.module_hm_table.level_selector_total(error_id)}}, /* POK_ERROR_ID_{{error_id}} */
@@ -37,7 +37,7 @@ pok_error_level_selector_t pok_hm_module_selector = {
  * 
  * SHUTDOWN for all errors.
  */
-pok_error_module_action_table_t pok_hm_module_table = {
+const pok_error_module_action_table_t pok_hm_module_table = {
     .actions = {
 {%for system_state in conf.system_states_all%}
     /* POK_SYSTEM_STATE_{{system_state}} */
@@ -59,15 +59,24 @@ error("UDP connection for the channel doesn't supported yet")
 {%-endmacro%}
 
 /**************** Setup queuing channels ****************************/
+{%for channel_queueing in conf.channels_queueing%}
+static struct pok_channel_queuing_side channel_queuing_receivers_{{loop.index0}}[{{channel_queueing.dsts | length}}] = {
+    {%for dst in channel_queueing.dsts%}
+    {
+        .max_nb_message = {{dst.port.max_nb_message}},
+        .part = {{connection_partition(dst)}},
+    },
+    {%endfor%}
+};
+
+{%endfor%}
 pok_channel_queuing_t pok_channels_queuing[{{ conf.channels_queueing | length }}] = {
     {%for channel_queueing in conf.channels_queueing%}
     {
         .max_message_size = {{channel_queueing.max_message_size}},
 
-        .recv = {
-            .max_nb_message = {{channel_queueing.max_nb_message_receive}},
-            .part = {{connection_partition(channel_queueing.dst)}},
-        },
+        .recv = channel_queuing_receivers_{{loop.index0}},
+        .recv_n = {{channel_queueing.dsts | length}},
         .send = {
             .max_nb_message = {{channel_queueing.max_nb_message_send}},
             .part = {{connection_partition(channel_queueing.src)}},
@@ -75,22 +84,41 @@ pok_channel_queuing_t pok_channels_queuing[{{ conf.channels_queueing | length }}
 
         // Currently hardcoded.
         .overflow_strategy = JET_CHANNEL_QUEUING_SENDER_BLOCK,
+
+        .storage = {{channel_queueing.get_storage_constant()}},
+{% if channel_queueing.max_nb_bytes is not none %}
+        .max_nb_bytes = {{channel_queueing.max_nb_bytes}},
+{% endif %}
     },
     {%endfor%}
 };
 
-uint8_t pok_channels_queuing_n = {{ conf.channels_queueing | length }};
+const uint8_t pok_channels_queuing_n = {{ conf.channels_queueing | length }};
 
 /****************** Setup sampling channels ***************************/
+{%for channel_sampling in conf.channels_sampling%}
+static struct pok_channel_sampling_receiver channel_sampling_receivers_{{loop.index0}}[{{channel_sampling.dsts | length}}] = {
+    {%for dst in channel_sampling.dsts%}
+    {
+        .part = {{connection_partition(dst)}},
+    },
+    {%endfor%}
+};
+
+{%endfor%}
+
 pok_channel_sampling_t pok_channels_sampling[{{ conf.channels_sampling | length }}] = {
     {%for channel_sampling in conf.channels_sampling%}
     {
         .max_message_size = {{channel_sampling.max_message_size}},
+
+        .recv = channel_sampling_receivers_{{loop.index0}},
+        .recv_n = {{channel_sampling.dsts | length}},
     },
     {%endfor%}
 };
 
-uint8_t pok_channels_sampling_n = {{ conf.channels_sampling | length }};
+const uint8_t pok_channels_sampling_n = {{ conf.channels_sampling | length }};
 
 {%for part in conf.partitions%}
 /****************** Setup partition{{loop.index0}} (auxiliary) **********************/
@@ -132,8 +160,10 @@ static const pok_error_hm_partition_t partition_hm_table_{{loop.index0}} = {
     }
 };
 
-// Threads array
-static pok_thread_t partition_threads_{{loop.index0}}[{{part.num_threads}} + 1 /*main thread*/ + 1 /* error thread */];
+// Threads array. Elements are dense; only the array starts at the cache line.
+static pok_thread_t partition_threads_{{loop.index0}}[{{part.num_threads}} + 1 /*main thread*/ + 1 /* error thread */]
+    __attribute__((aligned(JET_CACHE_LINE_SIZE)));
+static pok_thread_cold_t partition_threads_cold_{{loop.index0}}[{{part.num_threads}} + 1 /*main thread*/ + 1 /* error thread */];
 
 // Queuing ports
 static pok_port_queuing_t partition_ports_queuing_{{loop.index0}}[{{part.ports_queueing | length}}] = {
@@ -142,6 +172,9 @@ static pok_port_queuing_t partition_ports_queuing_{{loop.index0}}[{{part.ports_q
         .name = "{{port_queueing.name}}",
         .channel = &pok_channels_queuing[{{port_queueing.channel_id}}],
         .direction = {%if port_queueing.is_src()%}POK_PORT_DIRECTION_OUT{%else%}POK_PORT_DIRECTION_IN{%endif%},
+{%if port_queueing.is_dst()%}
+        .receiver_id = {{port_queueing.receiver_id}},
+{%endif%}
     },
 {%endfor%}
 };
@@ -153,6 +186,9 @@ static pok_port_sampling_t partition_ports_sampling_{{loop.index0}}[{{part.ports
         .name = "{{port_sampling.name}}",
         .channel = &pok_channels_sampling[{{port_sampling.channel_id}}],
         .direction = {%if port_sampling.is_src()%}POK_PORT_DIRECTION_OUT{%else%}POK_PORT_DIRECTION_IN{%endif%},
+{%if port_sampling.is_dst()%}
+        .receiver_id = {{port_sampling.receiver_id}},
+{%endif%}
     },
 {%endfor%}
 };
@@ -166,8 +202,8 @@ pok_partition_arinc_t pok_partitions_arinc[{{conf.partitions | length}}] = {
         .base_part = {
             .name = "{{part.name}}",
 
-            // Allocate 1 event slot per queuing port plus 2 slots for timer.
-            .partition_event_max = {{part.ports_queueing | length}} + 2,
+            // Allocate 1 event slot per port plus 2 slots for timer.
+            .partition_event_max = {{part.ports_queueing | length}} + {{part.ports_sampling | length}} + 2,
 
             .period = {%if part.period is not none%}{{part.period}}{%else%}{{conf.major_frame}}{%endif%},
             .duration = {%if part.duration is not none%}{{part.duration}}{%else%}{{part.total_time}}{%endif%},
@@ -181,8 +217,15 @@ pok_partition_arinc_t pok_partitions_arinc[{{conf.partitions | length}}] = {
 
         .nthreads = {{part.get_needed_threads()}},
         .threads = partition_threads_{{loop.index0}},
+        .threads_cold = partition_threads_cold_{{loop.index0}},
 
-        .main_user_stack_size = 8192, {# TODO: This should be set in config somehow. #}
+        .main_user_stack_size = {{part.get_main_user_stack_size()}}, {# TODO: This should be set in config somehow. #}
+{% if part.get_kernel_stack_size() is not none %}
+        .kernel_stack_size = {{part.get_kernel_stack_size()}},
+{% endif %}
+{% if part.kernel_stacks is not none %}
+        .kernel_stacks_n = {{part.kernel_stacks}},
+{% endif %}
 
         .heap_size = {{part.get_heap_size()}},
 
@@ -288,6 +331,11 @@ struct memory_block jet_memory_blocks[] = {
 
 };
 
-size_t jet_memory_blocks_n = {{ conf.memory_blocks | length }};
+const size_t jet_memory_blocks_n = {{ conf.memory_blocks | length }};
+
+/**************************** Profiler ********************************/
+#include <core/profiler.h>
+const uint32_t jet_profiler_period = {{conf.profiler_period}};
+const uint32_t jet_profiler_histogram_size = {{conf.profiler_histogram_size}};
 
 {% include 'arch/' + conf.arch + '/deployment_kernel' %}
@@ -17,27 +17,35 @@
 
 #ifdef POK_NEEDS_ARINC653_BUFFER
 // Maximum number of buffers.
-size_t arinc_config_nbuffers = {{part.num_arinc653_buffers}};
+const size_t arinc_config_nbuffers = {{part.num_arinc653_buffers}};
+
+// Buffers with packed storage.
+const struct arinc_config_buffer_packed arinc_config_buffers_packed[{{part.buffers_packed | length}}] = {
+{%for buffer_name, max_nb_bytes in part.buffers_packed%}
+    {"{{buffer_name}}", {{max_nb_bytes}}},
+{%endfor%}
+};
+const size_t arinc_config_nbuffers_packed = {{part.buffers_packed | length}};
 #endif /* POK_NEEDS_ARINC653_BUFFER */
 
 #ifdef POK_NEEDS_ARINC653_BLACKBOARD
 // Maximum number of blackboards.
-size_t arinc_config_nblackboards = {{part.num_arinc653_blackboards}};
+const size_t arinc_config_nblackboards = {{part.num_arinc653_blackboards}};
 #endif /* POK_NEEDS_ARINC653_BLACKBOARD */
 
 #ifdef POK_NEEDS_ARINC653_SEMAPHORE
 // Maximum number of semaphores.
-size_t arinc_config_nsemaphores = {{part.num_arinc653_semaphores}};
+const size_t arinc_config_nsemaphores = {{part.num_arinc653_semaphores}};
 #endif /* POK_NEEDS_ARINC653_SEMAPHORE */
 
 #ifdef POK_NEEDS_ARINC653_EVENT
 // Maximum number of events.
-size_t arinc_config_nevents = {{part.num_arinc653_events}};
+const size_t arinc_config_nevents = {{part.num_arinc653_events}};
 #endif /* POK_NEEDS_ARINC653_EVENT */
 
 #if defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD)
 // Memory for messages, used by buffers and blackboards.
-size_t arinc_config_messages_memory_size = {{part.buffer_data_size + part.blackboard_data_size}};
+const size_t arinc_config_messages_memory_size = {{part.get_messages_memory_size()}};
 #endif /* defined(POK_NEEDS_ARINC653_BUFFER) || defined(POK_NEEDS_ARINC653_BLACKBOARD) */
 
 {%if part.is_system%}
@@ -0,0 +1,21 @@
+{#
+ # Institute for System Programming of the Russian Academy of Sciences
+ # Copyright (C) 2016 ISPRAS
+ #
+ # This program is free software; you can redistribute it and/or
+ # modify it under the terms of the GNU General Public License
+ # as published by the Free Software Foundation, Version 3.
+ #
+ # This program is distributed in the hope # that it will be useful,
+ # but WITHOUT ANY WARRANTY; without even the implied warranty of
+ # MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ #
+ # See the GNU General Public License version 3 for more details.
+ #
+ # Template is rendered for every syscall of the map, so the license
+ # is kept in the template's comment rather than in its output.
+ -#}
+SYSCALL_TABLE_ENTRY({{sd.syscall_id}},
+{%- if 'READONLY' in sd.flags %} JET_SYSCALL_FLAG_READONLY
+{%- else %} JET_SYSCALL_FLAG_PREEMPTIBLE | JET_SYSCALL_FLAG_RETURN_USER
+{%- endif %})
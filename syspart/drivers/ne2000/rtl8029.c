@@ -51,15 +51,21 @@
     outb_inverse((inb((dev)->addr + NE2000_CR) &                          \
                 ~(NE2000_CR_PS0 | NE2000_CR_PS1)) | ((page) << 6), (dev)->addr)
 
-static int ne2000_write(
+/* Size of the receive ring in bytes. */
+#define NE2000_RING_BYTES ((NE2000_MEMSZ - NE2000_RXBUF) << 8)
+
+/*
+ * Start remote DMA transaction.
+ *
+ * 'command' is NE2000_CR_RD0 for remote read or NE2000_CR_RD1 for
+ * remote write. Card works in word mode, so 'count' should be even.
+ */
+static void ne2000_dma_start(
         const s_ne2000_dev *dev,
-        const void         *buf,
-        unsigned short     count,
-        unsigned short     offset)
+        unsigned short      count,
+        unsigned short      offset,
+        unsigned char       command)
 {
-    const char* p = NULL;
-    int ret = count;
-
     // Sets RD2 (abort/complete remote DMA)
     outb_inverse((inb(dev->addr + NE2000_CR) & ~(NE2000_CR_RD0 | NE2000_CR_RD1)) |
             NE2000_CR_RD2, dev->addr);
@@ -72,88 +78,147 @@ static int ne2000_write(
     outb_inverse(count, dev->addr + NE2000_RBCR0);
     outb_inverse(count >> 8, dev->addr + NE2000_RBCR1);
 
-    // Sets RD1 (remote write)
-    outb_inverse((inb(dev->addr + NE2000_CR) & ~(NE2000_CR_RD0 | NE2000_CR_RD2)) |
-            NE2000_CR_RD1, dev->addr);
+    outb_inverse((inb(dev->addr + NE2000_CR) &
+                ~(NE2000_CR_RD0 | NE2000_CR_RD1 | NE2000_CR_RD2)) | command,
+            dev->addr);
+}
 
-    for (p = buf; count > 0; count--, p++) {
-        outb_inverse(*p, dev->addr + NE2000_DMA_PORT);
-    }
+/* Abort remote DMA transaction, which is not completed. */
+static void ne2000_dma_abort(const s_ne2000_dev *dev)
+{
+    outb_inverse((inb(dev->addr + NE2000_CR) & ~(NE2000_CR_RD0 | NE2000_CR_RD1)) |
+            NE2000_CR_RD2, dev->addr);
+}
+
+/* Read 'count' bytes from the DMA port within current transaction. */
+static void ne2000_pio_read(
+        const s_ne2000_dev *dev,
+        void               *buf,
+        unsigned short      count)
+{
+    unsigned char *p = buf;
 
-    return (ret);
+    insw(dev->addr + NE2000_DMA_PORT, p, count / 2);
+
+    if (count & 1) {
+        // Card transfers only whole words.
+        p[count - 1] = inw(dev->addr + NE2000_DMA_PORT);
+    }
 }
 
-static int ne2000_read_header(
+static int ne2000_write(
         const s_ne2000_dev *dev,
-        s_ne2000_header    *hdr,
-        unsigned short      offset)
+        const void         *buf,
+        unsigned short     count,
+        unsigned short     offset)
 {
-    int count = sizeof(s_ne2000_header);
-    // Sets RD2 (abort/complete remote DMA)
-    outb_inverse((inb((dev)->addr + NE2000_CR) & ~(NE2000_CR_RD0 | NE2000_CR_RD1)) |
-            NE2000_CR_RD2, (dev)->addr);
+    const unsigned char *p = buf;
 
-    /* These two registers set the start address of remote DMA. */
-    outb_inverse(offset, dev->addr + NE2000_RSAR0);
-    outb_inverse(offset >> 8, dev->addr + NE2000_RSAR1);
+    // RDC will notify about completion of this transaction.
+    outb_inverse(NE2000_ISR_RDC, dev->addr + NE2000_ISR);
 
-    /* These two registers set the data byte counts of remote DMA. */
-    outb_inverse(count, dev->addr + NE2000_RBCR0);
-    outb_inverse(count >> 8, dev->addr + NE2000_RBCR1);
+    // Sets RD1 (remote write)
+    ne2000_dma_start(dev, (count + 1) & ~1, offset, NE2000_CR_RD1);
 
-    // Sets RD0 (remote read)
-    outb_inverse((inb((dev)->addr + NE2000_CR) & ~(NE2000_CR_RD1 | NE2000_CR_RD2)) |
-            NE2000_CR_RD0, (dev)->addr);
-    hdr->status = inb(dev->addr + NE2000_DMA_PORT);
-    hdr->next   = inb(dev->addr + NE2000_DMA_PORT);
-    hdr->size   = inb(dev->addr + NE2000_DMA_PORT);
-    hdr->size  |= inb(dev->addr + NE2000_DMA_PORT) << 8;
+    outsw(dev->addr + NE2000_DMA_PORT, p, count / 2);
+
+    if (count & 1) {
+        outw(dev->addr + NE2000_DMA_PORT, p[count - 1]);
+    }
 
     return count;
 }
+
 static int ne2000_read(
         const s_ne2000_dev *dev,
         void               *buf,
         unsigned short      count,
         unsigned short      offset)
 {
-    char* p = NULL;
-    int ret = count;
+    // Sets RD0 (remote read)
+    ne2000_dma_start(dev, (count + 1) & ~1, offset, NE2000_CR_RD0);
 
-    // Sets RD2 (abort/complete remote DMA)
-    outb_inverse((inb((dev)->addr + NE2000_CR) & ~(NE2000_CR_RD0 | NE2000_CR_RD1)) |
-            NE2000_CR_RD2, (dev)->addr);
+    ne2000_pio_read(dev, buf, count);
 
-    /* These two registers set the start address of remote DMA. */
-    outb_inverse(offset, dev->addr + NE2000_RSAR0);
-    outb_inverse(offset >> 8, dev->addr + NE2000_RSAR1);
+    return count;
+}
 
-    /* These two registers set the data byte counts of remote DMA. */
-    outb_inverse(count, dev->addr + NE2000_RBCR0);
-    outb_inverse(count >> 8, dev->addr + NE2000_RBCR1);
+/*
+ * Receive frame, which starts at the given page of the ring.
+ *
+ * Header and payload are read within single DMA transaction.
+ *
+ * Return page of the next frame, or 0 if header is corrupted.
+ */
+static unsigned char ne2000_receive_frame(
+        s_ne2000_dev *drv_info,
+        unsigned char page,
+        pok_packet_t *recv_packet)
+{
+    s_ne2000_header  ne2000_hdr;     // ne2000 packet header
+    uint8_t          raw_hdr[sizeof(s_ne2000_header)];
+    unsigned packet_len;
+
+    /*
+     * Frame length is unknown until header is read, so transaction
+     * covers the whole ring and is aborted after the frame is read.
+     * Remote DMA wraps at the end of the ring by itself.
+     */
+    ne2000_dma_start(drv_info, NE2000_RING_BYTES, page << 8, NE2000_CR_RD0);
+
+    ne2000_pio_read(drv_info, raw_hdr, sizeof(raw_hdr));
+
+    // Size is little-endian.
+    ne2000_hdr.status = raw_hdr[0];
+    ne2000_hdr.next   = raw_hdr[1];
+    ne2000_hdr.size   = raw_hdr[2] | (raw_hdr[3] << 8);
+
+    if (ne2000_hdr.size < sizeof(s_ne2000_header) + sizeof(struct ether_hdr)
+        || ne2000_hdr.size > NE2000_RING_BYTES
+        || ne2000_hdr.next < NE2000_RXBUF
+        || ne2000_hdr.next >= NE2000_MEMSZ) {
+        ne2000_dma_abort(drv_info);
+        return 0;
+    }
 
-    // Sets RD0 (remote read)
-    outb_inverse((inb((dev)->addr + NE2000_CR) & ~(NE2000_CR_RD1 | NE2000_CR_RD2)) |
-            NE2000_CR_RD0, (dev)->addr);
+    packet_len = ne2000_hdr.size - sizeof(s_ne2000_header);
+
+    ne2000_pio_read(drv_info, recv_packet, packet_len);
+    ne2000_dma_abort(drv_info);
+
+    if (ne2000_hdr.size == NE2000_ETH_DATA_MINLEN) {
+        // NIC add trailing zeros to packets shorter than 64 bytes. They should be ignored
+        const struct ip_hdr *ip_hdr = (const struct ip_hdr *)
+            (sizeof(struct ether_hdr) + (const char *)recv_packet);
 
-    for (p = buf; count > 0; count--, p++) {
-        *p = inb(dev->addr + NE2000_DMA_PORT);
+        packet_len = ntoh16(ip_hdr->length) + sizeof(struct ether_hdr);
     }
 
-    return ret;
+    //XXX callback should create copy of recv_packet
+    drv_info->packet_received_callback((const char *)recv_packet, packet_len);
+
+    return ne2000_hdr.next;
 }
 
+/* Set BNRY register so that 'page' is the next page to be read. */
+static void ne2000_set_next_page(s_ne2000_dev *drv_info, unsigned char page)
+{
+    /* This register is used to prevent overwrite of the receive buffer ring.
+       It is typically used as a pointer indicating the last receive buffer
+       page the host has read.*/
+    outb_inverse(page == NE2000_RXBUF ? NE2000_MEMSZ - 1 : page - 1,
+            drv_info->addr + NE2000_BNRY);
+}
 
 /**
  *  @brief Polls rtl8029 device.
  *
  *  Watches for events, typically for receiving queued packets.
+ *  All frames pending in the receive ring are processed.
  */
 void rtl8029_polling(pok_netdevice_t * netdev)
 {
     unsigned char state; // ISR state
-    s_ne2000_header  ne2000_hdr;     // ne2000 packet header
-    unsigned short   offset;         // dma offset
     unsigned char    start, end;     // pointers for the ring buffer
     pok_packet_t     recv_packet;
 
@@ -163,56 +228,41 @@ void rtl8029_polling(pok_netdevice_t * netdev)
 
     // do we have an interrupt flag set?
     if ((state = inb(drv_info->addr + NE2000_ISR)) == 0)
-        goto POLL_END;
-
-    if (!state & NE2000_ISR_PRX)
-        goto POLL_END;
-
-    if ((inb(drv_info->addr + NE2000_RSR) & NE2000_RSR_PRX) == 0)
-        goto POLL_END;
-
-    /* This register is used to prevent overwrite of the receive buffer ring.
-       It is typically used as a pointer indicating the last receive buffer
-       page the host has read.*/
-    unsigned tmp = inb(drv_info->addr + NE2000_BNRY);
-    start = tmp + 1;
-
-    /* This register points to the page address of the first receive
-       buffer page to be used for a packet reception. */
-    NE2000_SELECT_PAGE(drv_info, 1);
-    end = inb(drv_info->addr + NE2000_CURR);
-    NE2000_SELECT_PAGE(drv_info, 0);
-
-    if ((end % NE2000_MEMSZ) == (start % NE2000_MEMSZ))
-        goto POLL_END;
-
-    /* et on decapsule! */
-
-    offset = start << 8;
-    offset += ne2000_read_header(drv_info, &ne2000_hdr, offset);
-
-    ne2000_read(drv_info, &recv_packet,
-            ne2000_hdr.size - sizeof(s_ne2000_header), offset);
-    unsigned packet_len = ne2000_hdr.size - sizeof(s_ne2000_header);
-
-    if (ne2000_hdr.size == NE2000_ETH_DATA_MINLEN) {
-        // NIC add trailing zeros to packets shorter than 64 bytes. They should be ignored
-        const struct ip_hdr *ip_hdr = (const struct ip_hdr *)
-            (sizeof(struct ether_hdr) + (const char *)&recv_packet);
-
-        packet_len = ntoh16(ip_hdr->length) + sizeof(struct ether_hdr);
+        return;
+
+    if (state & NE2000_ISR_PRX) {
+        /*
+         * Clear PRX flag before reading the ring: frames received
+         * while we drain the ring will set it again.
+         */
+        outb_inverse(NE2000_ISR_PRX, drv_info->addr + NE2000_ISR);
+
+        start = inb(drv_info->addr + NE2000_BNRY) + 1;
+        if (start >= NE2000_MEMSZ)
+            start = NE2000_RXBUF;
+
+        /* This register points to the page address of the first receive
+           buffer page to be used for a packet reception. */
+        NE2000_SELECT_PAGE(drv_info, 1);
+        end = inb(drv_info->addr + NE2000_CURR);
+        NE2000_SELECT_PAGE(drv_info, 0);
+
+        while (start != end) {
+            unsigned char next = ne2000_receive_frame(drv_info, start,
+                    &recv_packet);
+
+            if (next == 0) {
+                // Ring is corrupted, drop all pending frames.
+                printf(DRV_NAME ": bad frame header at page %u\n", start);
+                next = end;
+            }
+
+            // update the BNRY register... almost forgot that
+            ne2000_set_next_page(drv_info, next);
+            start = next;
+        }
     }
 
-    // update the BNRY register... almost forgot that
-    outb_inverse(ne2000_hdr.next > NE2000_MEMSZ ?
-            NE2000_RXBUF - 1 : ne2000_hdr.next - 1, drv_info->addr + NE2000_BNRY);
-
-    //XXX callback should create copy of recv_packet
-    drv_info->packet_received_callback((const char *)&recv_packet, packet_len);
-
-    outb_inverse(NE2000_ISR_PRX, drv_info->addr + NE2000_ISR); // Clear PRX flag
-
-POLL_END:
     //Clear flags
     if (state & NE2000_ISR_PTX) outb_inverse(NE2000_ISR_PTX, drv_info->addr + NE2000_ISR);
     if (state & NE2000_ISR_RXE) outb_inverse(NE2000_ISR_RXE, drv_info->addr + NE2000_ISR);
@@ -249,7 +299,9 @@ static int rtl8029_init (struct pci_dev *pci_dev, s_ne2000_dev *drv_info)
     // Sets several options... Read the datasheet!
     outb_inverse(0x00, drv_info->addr + NE2000_TCR);
     outb_inverse(NE2000_RCR_AB|NE2000_RCR_AR, drv_info->addr + NE2000_RCR);
-    outb_inverse(NE2000_DCR_LS | NE2000_DCR_FT1, drv_info->addr + NE2000_DCR);
+    // Word-wide remote DMA: data port is accessed with 16-bit string I/O.
+    outb_inverse(NE2000_DCR_WTS | NE2000_DCR_LS | NE2000_DCR_FT1,
+            drv_info->addr + NE2000_DCR);
 
     /* The Page Start register sets the start page address
        of the receive buffer ring. */
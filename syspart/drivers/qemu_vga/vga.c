@@ -22,6 +22,7 @@
 #include "vbe.h"
 
 #include <fb.h>
+#include <gfx.h>
 struct pci_dev vga_dev;
 char initialized = 0;
 
@@ -77,7 +78,7 @@ void vga_init()
 
 uint32_t rgba_to_argb(uint32_t rgba_color)
 {
-    return rgba_color>>8 | (rgba_color&0xff)<<24;
+    return gfx_rgba_to_argb_pixel(rgba_color);
 }
 
 
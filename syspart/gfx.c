@@ -0,0 +1,315 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#include <string.h>
+#include <gfx.h>
+
+#define GFX_OPAQUE 0xff000000u
+
+static inline int gfx_min(int a, int b)
+{
+    return a < b ? a : b;
+}
+
+static inline int gfx_max(int a, int b)
+{
+    return a > b ? a : b;
+}
+
+pok_bool_t gfx_rect_clip(struct gfx_rect *rect, int width, int height)
+{
+    int x1 = gfx_min(rect->x + rect->w, width);
+    int y1 = gfx_min(rect->y + rect->h, height);
+
+    rect->x = gfx_max(rect->x, 0);
+    rect->y = gfx_max(rect->y, 0);
+    rect->w = x1 - rect->x;
+    rect->h = y1 - rect->y;
+
+    return rect->w > 0 && rect->h > 0;
+}
+
+void gfx_rect_union(struct gfx_rect *res, const struct gfx_rect *a,
+        const struct gfx_rect *b)
+{
+    int x1 = gfx_max(a->x + a->w, b->x + b->w);
+    int y1 = gfx_max(a->y + a->h, b->y + b->h);
+
+    res->x = gfx_min(a->x, b->x);
+    res->y = gfx_min(a->y, b->y);
+    res->w = x1 - res->x;
+    res->h = y1 - res->y;
+}
+
+static pok_bool_t gfx_rect_contains(const struct gfx_rect *outer,
+        const struct gfx_rect *inner)
+{
+    return inner->x >= outer->x && inner->y >= outer->y
+        && inner->x + inner->w <= outer->x + outer->w
+        && inner->y + inner->h <= outer->y + outer->h;
+}
+
+void gfx_rgba_to_argb(uint32_t *dst, const uint32_t *src, size_t n)
+{
+    size_t i = 0;
+
+    // Unrolled, so conversions of neighbouring pixels may overlap.
+    for (; i + 4 <= n; i += 4) {
+        uint32_t p0 = src[i], p1 = src[i + 1], p2 = src[i + 2], p3 = src[i + 3];
+
+        dst[i] = gfx_rgba_to_argb_pixel(p0);
+        dst[i + 1] = gfx_rgba_to_argb_pixel(p1);
+        dst[i + 2] = gfx_rgba_to_argb_pixel(p2);
+        dst[i + 3] = gfx_rgba_to_argb_pixel(p3);
+    }
+
+    for (; i < n; i++)
+        dst[i] = gfx_rgba_to_argb_pixel(src[i]);
+}
+
+/*
+ * Fill 'n' pixels, four per iteration.
+ *
+ * Plain 32-bit stores keep the framebuffer accessed through its own
+ * type; the compiler is free to merge them into wider ones.
+ */
+static void gfx_fill_row(uint32_t *row, int n, uint32_t argb)
+{
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        row[i] = argb;
+        row[i + 1] = argb;
+        row[i + 2] = argb;
+        row[i + 3] = argb;
+    }
+
+    for (; i < n; i++)
+        row[i] = argb;
+}
+
+void gfx_fill_rect(struct gfx_surface *dst, const struct gfx_rect *rect,
+        uint32_t argb)
+{
+    struct gfx_rect r = *rect;
+    int y;
+
+    if (!gfx_rect_clip(&r, dst->width, dst->height))
+        return;
+
+    for (y = r.y; y < r.y + r.h; y++)
+        gfx_fill_row(gfx_pixel(dst, r.x, y), r.w, argb);
+}
+
+/*
+ * Clip both source and destination areas of the copying.
+ *
+ * On success, 'r' is the source area and (*x, *y) is its position
+ * in the destination.
+ */
+static pok_bool_t gfx_blit_clip(const struct gfx_surface *dst, int *x, int *y,
+        const struct gfx_surface *src, const struct gfx_rect *src_rect,
+        struct gfx_rect *r)
+{
+    struct gfx_rect d;
+
+    if (src_rect) {
+        *r = *src_rect;
+    } else {
+        r->x = 0;
+        r->y = 0;
+        r->w = src->width;
+        r->h = src->height;
+    }
+
+    // Part of the source area outside of the source surface is skipped.
+    d = *r;
+    if (!gfx_rect_clip(r, src->width, src->height))
+        return FALSE;
+    *x += r->x - d.x;
+    *y += r->y - d.y;
+
+    d.x = *x;
+    d.y = *y;
+    d.w = r->w;
+    d.h = r->h;
+    if (!gfx_rect_clip(&d, dst->width, dst->height))
+        return FALSE;
+
+    r->x += d.x - *x;
+    r->y += d.y - *y;
+    r->w = d.w;
+    r->h = d.h;
+    *x = d.x;
+    *y = d.y;
+
+    return TRUE;
+}
+
+void gfx_blit(struct gfx_surface *dst, int x, int y,
+        const struct gfx_surface *src, const struct gfx_rect *src_rect)
+{
+    struct gfx_rect r;
+    int i;
+
+    if (!gfx_blit_clip(dst, &x, &y, src, src_rect, &r))
+        return;
+
+    for (i = 0; i < r.h; i++) {
+        memcpy(gfx_pixel(dst, x, y + i), gfx_pixel(src, r.x, r.y + i),
+                r.w * sizeof(uint32_t));
+    }
+}
+
+/*
+ * Blend 's' over 'd'.
+ *
+ * Red and blue channels are processed together: with 0x00ff00ff mask
+ * each of them has 8 spare bits for the multiplication. Alpha is scaled
+ * to 0..256, so division by 255 becomes a shift.
+ */
+static inline uint32_t gfx_blend_pixel(uint32_t s, uint32_t d)
+{
+    uint32_t a = s >> 24;
+    uint32_t rb, g;
+
+    a += a >> 7;
+
+    rb = ((s & 0x00ff00ff) * a + (d & 0x00ff00ff) * (256 - a)) >> 8;
+    g = ((s & 0x0000ff00) * a + (d & 0x0000ff00) * (256 - a)) >> 8;
+
+    return GFX_OPAQUE | (rb & 0x00ff00ff) | (g & 0x0000ff00);
+}
+
+static void gfx_blend_row(uint32_t *dst, const uint32_t *src, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++) {
+        uint32_t s = src[i];
+
+        // Sprites are mostly either fully transparent or fully opaque.
+        if (s >= GFX_OPAQUE)
+            dst[i] = s;
+        else if (s >> 24)
+            dst[i] = gfx_blend_pixel(s, dst[i]);
+    }
+}
+
+void gfx_blend(struct gfx_surface *dst, int x, int y,
+        const struct gfx_surface *src, const struct gfx_rect *src_rect)
+{
+    struct gfx_rect r;
+    int i;
+
+    if (!gfx_blit_clip(dst, &x, &y, src, src_rect, &r))
+        return;
+
+    for (i = 0; i < r.h; i++)
+        gfx_blend_row(gfx_pixel(dst, x, y + i), gfx_pixel(src, r.x, r.y + i), r.w);
+}
+
+void gfx_dirty_add(struct gfx_dirty *dirty, const struct gfx_rect *rect)
+{
+    int i;
+
+    if (rect->w <= 0 || rect->h <= 0)
+        return;
+
+    for (i = 0; i < dirty->count; i++) {
+        if (gfx_rect_contains(&dirty->rects[i], rect))
+            return;
+    }
+
+    if (dirty->count < GFX_DIRTY_MAX) {
+        dirty->rects[dirty->count++] = *rect;
+        return;
+    }
+
+    // Overflow: copying some extra pixels is cheaper than tracking them.
+    for (i = 1; i < dirty->count; i++)
+        gfx_rect_union(&dirty->rects[0], &dirty->rects[0], &dirty->rects[i]);
+    gfx_rect_union(&dirty->rects[0], &dirty->rects[0], rect);
+    dirty->count = 1;
+}
+
+static void gfx_display_update_back(struct gfx_display *disp)
+{
+    disp->back.pixels = disp->fb.back_surface;
+    disp->back.width = disp->fb.width;
+    disp->back.height = disp->fb.height;
+    disp->back.stride = disp->fb.width;
+}
+
+int gfx_display_init(struct gfx_display *disp, uint32_t argb)
+{
+    struct gfx_rect all;
+
+    if (uwrm_scm_get_direct_fb(&disp->fb) != UWRM_OK)
+        return UWRM_ERROR;
+
+    if (disp->fb.format != UWRM_FORMAT_ARGB8888)
+        return UWRM_ERROR;
+
+    gfx_display_update_back(disp);
+    gfx_dirty_reset(&disp->dirty);
+
+    all.x = 0;
+    all.y = 0;
+    all.w = disp->fb.width;
+    all.h = disp->fb.height;
+
+    gfx_fill_rect(&disp->back, &all, argb);
+    if (uwrm_scm_fb_swap(&disp->fb) != UWRM_OK)
+        return UWRM_ERROR;
+    gfx_display_update_back(disp);
+    gfx_fill_rect(&disp->back, &all, argb);
+
+    return UWRM_OK;
+}
+
+void gfx_display_mark(struct gfx_display *disp, const struct gfx_rect *rect)
+{
+    struct gfx_rect r = *rect;
+
+    if (gfx_rect_clip(&r, disp->back.width, disp->back.height))
+        gfx_dirty_add(&disp->dirty, &r);
+}
+
+int gfx_display_swap(struct gfx_display *disp)
+{
+    struct gfx_surface front;
+    int i;
+
+    if (uwrm_scm_fb_swap(&disp->fb) != UWRM_OK)
+        return UWRM_ERROR;
+
+    front = disp->back;
+    gfx_display_update_back(disp);
+
+    /*
+     * New back surface holds the previous frame. Only areas changed
+     * in the shown frame differ from it.
+     */
+    for (i = 0; i < disp->dirty.count; i++) {
+        const struct gfx_rect *r = &disp->dirty.rects[i];
+
+        gfx_blit(&disp->back, r->x, r->y, &front, r);
+    }
+
+    gfx_dirty_reset(&disp->dirty);
+
+    return UWRM_OK;
+}
@@ -57,4 +57,30 @@ static inline uint32_t inl(unsigned int port)
     return in_le32((uint32_t *) port);
 }
 
+/*
+ * Transfer 'count' 16-bit words between the port and memory.
+ *
+ * Bytes are kept in the order they come from the (little-endian) port,
+ * so the buffer need not be aligned.
+ */
+static inline void insw(unsigned int port, void *buf, unsigned int count)
+{
+    uint8_t *p = buf;
+
+    for (; count > 0; count--, p += 2) {
+        uint16_t w = inw(port);
+        p[0] = w;
+        p[1] = w >> 8;
+    }
+}
+
+static inline void outsw(unsigned int port, const void *buf, unsigned int count)
+{
+    const uint8_t *p = buf;
+
+    for (; count > 0; count--, p += 2) {
+        outw(port, p[0] | (p[1] << 8));
+    }
+}
+
 #endif // __POK_PPC_IOPORTS_H__
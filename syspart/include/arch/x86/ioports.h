@@ -59,4 +59,30 @@
   res;                                                          \
 })
 
+/*
+ * Transfer 'count' 16-bit words between the port and memory.
+ *
+ * Bytes are kept in the order they come from the port, so the buffer
+ * need not be aligned.
+ */
+#define insw(port, buf, count)                                  \
+({                                                              \
+  void *__p = (buf);                                            \
+  unsigned long __c = (count);                                  \
+  asm volatile ("cld; rep insw"                                 \
+                :"+D" (__p), "+c" (__c)                         \
+                :"d" (port)                                     \
+                :"memory");                                     \
+})
+
+#define outsw(port, buf, count)                                 \
+({                                                              \
+  const void *__p = (buf);                                      \
+  unsigned long __c = (count);                                  \
+  asm volatile ("cld; rep outsw"                                \
+                :"+S" (__p), "+c" (__c)                         \
+                :"d" (port)                                     \
+                :"memory");                                     \
+})
+
 #endif /* __POK_X86_IOPORTS_H__ */
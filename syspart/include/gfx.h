@@ -0,0 +1,137 @@
+/*
+ * Institute for System Programming of the Russian Academy of Sciences
+ * Copyright (C) 2016 ISPRAS
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, Version 3.
+ *
+ * This program is distributed in the hope # that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License version 3 for more details.
+ */
+
+#ifndef __SYSPART_GFX_H__
+#define __SYSPART_GFX_H__
+
+/*
+ * 2D drawing on 32-bit ARGB surfaces.
+ *
+ * Kernels process whole words: fill uses 64-bit stores, blit copies
+ * whole rows, and blending handles red and blue channels of a pixel
+ * in one multiplication.
+ *
+ * All operations clip to the destination surface.
+ */
+
+#include <types.h>
+#include <fb.h>
+
+struct gfx_surface {
+    uint32_t *pixels;
+    int width;
+    int height;
+    /* Distance between rows, in pixels. */
+    int stride;
+};
+
+struct gfx_rect {
+    int x;
+    int y;
+    int w;
+    int h;
+};
+
+static inline uint32_t *gfx_pixel(const struct gfx_surface *s, int x, int y)
+{
+    return s->pixels + y * s->stride + x;
+}
+
+/* Convert single RGBA pixel into ARGB one. */
+static inline uint32_t gfx_rgba_to_argb_pixel(uint32_t rgba)
+{
+    return rgba >> 8 | rgba << 24;
+}
+
+/*
+ * Clip 'rect' to the surface of given size.
+ *
+ * Return FALSE if nothing is left.
+ */
+pok_bool_t gfx_rect_clip(struct gfx_rect *rect, int width, int height);
+
+/* Return the smallest rectangle, which contains both 'a' and 'b'. */
+void gfx_rect_union(struct gfx_rect *res, const struct gfx_rect *a,
+        const struct gfx_rect *b);
+
+/* Convert 'n' RGBA pixels into ARGB ones. 'dst' may be equal to 'src'. */
+void gfx_rgba_to_argb(uint32_t *dst, const uint32_t *src, size_t n);
+
+void gfx_fill_rect(struct gfx_surface *dst, const struct gfx_rect *rect,
+        uint32_t argb);
+
+/*
+ * Copy 'src_rect' of 'src' surface into 'dst' at (x, y).
+ *
+ * If 'src_rect' is NULL, whole 'src' is copied.
+ */
+void gfx_blit(struct gfx_surface *dst, int x, int y,
+        const struct gfx_surface *src, const struct gfx_rect *src_rect);
+
+/*
+ * Same as gfx_blit(), but 'src' pixels are blended over 'dst' ones
+ * according to their alpha. Result is opaque.
+ */
+void gfx_blend(struct gfx_surface *dst, int x, int y,
+        const struct gfx_surface *src, const struct gfx_rect *src_rect);
+
+/*
+ * Set of rectangles changed since the last swap.
+ *
+ * When the set overflows, it is collapsed into the bounding rectangle.
+ */
+#define GFX_DIRTY_MAX 16
+
+struct gfx_dirty {
+    int count;
+    struct gfx_rect rects[GFX_DIRTY_MAX];
+};
+
+static inline void gfx_dirty_reset(struct gfx_dirty *dirty)
+{
+    dirty->count = 0;
+}
+
+void gfx_dirty_add(struct gfx_dirty *dirty, const struct gfx_rect *rect);
+
+/*
+ * Double-buffered display with dirty rectangles tracking.
+ *
+ * Client draws into gfx_display_back() and marks every changed area
+ * with gfx_display_mark(). On swap only marked areas are copied from
+ * the shown frame into the new back surface, so the back surface is
+ * always up-to-date and needn't be redrawn completely.
+ */
+struct gfx_display {
+    struct uwrm_scm_direct_fb fb;
+    struct gfx_surface back;
+    struct gfx_dirty dirty;
+};
+
+/* Take framebuffer and fill both surfaces with 'argb'. */
+int gfx_display_init(struct gfx_display *disp, uint32_t argb);
+
+static inline struct gfx_surface *gfx_display_back(struct gfx_display *disp)
+{
+    return &disp->back;
+}
+
+/* Mark area of the back surface as changed. Area is clipped to the screen. */
+void gfx_display_mark(struct gfx_display *disp, const struct gfx_rect *rect);
+
+/* Show back surface and synchronize the new back surface with it. */
+int gfx_display_swap(struct gfx_display *disp);
+
+#endif /* __SYSPART_GFX_H__ */
@@ -21,11 +21,15 @@
 #define ALIGN_UP(addr,size) (((addr)+((size)-1))&(~((size)-1)))
 
 static inline uintptr_t pok_virt_to_phys(void * virt) {
-   return pok_syscall1(POK_SYSCALL_MEM_VIRT_TO_PHYS, (uintptr_t) virt);
+   uintptr_t phys = 0;
+   pok_syscall2(POK_SYSCALL_MEM_VIRT_TO_PHYS, (uintptr_t) virt, (uintptr_t) &phys);
+   return phys;
 }
 
 static inline void* pok_phys_to_virt(uintptr_t phys) {
-   return (void *) pok_syscall1(POK_SYSCALL_MEM_PHYS_TO_VIRT, phys);
+   uintptr_t virt = 0;
+   pok_syscall2(POK_SYSCALL_MEM_PHYS_TO_VIRT, phys, (uintptr_t) &virt);
+   return (void *) virt;
 }
 
 #endif
@@ -17,10 +17,19 @@
 #ifndef __SYSPART_POOL_H__
 #define __SYSPART_POOL_H__
 
+#include <slab.h>
+
+/*
+ * Pool of fixed-size elements.
+ *
+ * Thin wrapper over slab cache, so elements may be allocated
+ * and freed by any process.
+ */
+
 struct pool_elem {
+    /* Index of the element in the pool. Constant. */
     int idx;
     int is_free;
-    int next_free_idx;
     int data_len;
     char data[];
 };
@@ -28,16 +37,19 @@ struct pool_elem {
 struct pool {
     size_t elem_size;
     uint32_t num;
-    size_t stride;
-    uint32_t free_elem_idx;
-    char* data;
+    struct slab_cache cache;
 };
 
+/* Create pool. May be used only in init mode. */
 struct pool *jet_pool_create(size_t elem_size, int num);
 
 
+/* Return free element, or NULL if pool is empty. */
 struct pool_elem * jet_pool_get_free_elem(struct pool *pool);
 
 void jet_pool_free_elem(struct pool *pool, struct pool_elem *elem);
 
+/* Copy statistics of the pool. */
+void jet_pool_get_stats(struct pool *pool, struct slab_stats *stats);
+
 #endif
@@ -18,50 +18,47 @@
 #include <pool.h>
 
 
-static struct pool_elem *get_pool_elem(struct pool *pool, int idx)
+static void pool_elem_init(void *object, size_t index)
 {
-    return (struct pool_elem *) (&pool->data[idx * pool->stride]);
+    struct pool_elem *elem = object;
+
+    elem->idx = index;
+    elem->is_free = 1;
 }
 
 struct pool *jet_pool_create(size_t elem_size, int num)
 {
     struct pool *pool;
-    struct pool_elem *elem;
 
     pool = smalloc(sizeof(*pool));
 
     pool->elem_size = elem_size;
     pool->num = num;
-    pool->stride = ALIGN_UP(pool->elem_size + sizeof(struct pool_elem), sizeof(unsigned long));
-    pool->data = smalloc(pool->stride*num);
-    pool->free_elem_idx = 0;
-
-    for (int i = 0; i < num - 1; i++) {
-       elem = get_pool_elem(pool, i);
-       elem->next_free_idx = i + 1;
-       elem->idx = i;
-    }
-    elem = get_pool_elem(pool, num - 1);
-    elem->next_free_idx = -1;
+    slab_cache_init(&pool->cache, sizeof(struct pool_elem) + elem_size, num,
+            pool_elem_init);
 
     return pool;
 }
 
 struct pool_elem * jet_pool_get_free_elem(struct pool *pool)
 {
-    if (pool->free_elem_idx == -1)
+    struct pool_elem *elem = slab_cache_alloc(&pool->cache);
+
+    if (elem == NULL)
         return NULL;
 
-    struct pool_elem *elem = get_pool_elem(pool, pool->free_elem_idx);
     elem->is_free = 0;
-    pool->free_elem_idx = elem->next_free_idx;
     return elem;
 }
 
 void jet_pool_free_elem(struct pool *pool, struct pool_elem *elem)
 {
+    (void) pool;
     elem->is_free = 1;
-    elem->next_free_idx = pool->free_elem_idx;
-    pool->free_elem_idx = elem->idx;
+    slab_cache_free(elem);
 }
 
+void jet_pool_get_stats(struct pool *pool, struct slab_stats *stats)
+{
+    slab_cache_get_stats(&pool->cache, stats);
+}